@@ -145,7 +145,7 @@ if [[ ! -e libzstd.a ]] ; then
 	mkdir -p include/zstd || true
 	pushd "$SRC/zstd/" > /dev/null
 	make clean || true
-	make -j 4 CFLAGS="-fPIC"
+	make -j 4 lib-mt CFLAGS="-fPIC"
 	popd > /dev/null
 	BUILD=1
 fi
@@ -186,8 +186,8 @@ if [[ $BUILD == 1 ]] ; then
   cp -r ./SZ/install/include/* include/sz
 
   rm *.a || true # ignore error
-  cp $SRC/lz4/lib/lz4.h include/lz4/
-  cp $SRC/zstd/lib/zstd.h include/zstd/
+  cp $SRC/lz4/lib/lz4.h $SRC/lz4/lib/lz4hc.h include/lz4/
+  cp $SRC/zstd/lib/zstd.h $SRC/zstd/lib/zdict.h include/zstd/
   cp $SRC/c-blosc/build/include/*.h include/blosc/
   cp ./SZ/install/lib/libzlib.a ./SZ/install/lib/libsz.a ./zfp-*/lib/libzfp.a ./cnoise/libcnoise.a ./fpzip-*/lib/libfpzip.a .
   cp $SRC/lz4/lib/liblz4.a .
@@ -28,6 +28,12 @@ static const char * hint_names[] = {"relative_tolerance_percent",
 	"comp_speed",
 	"decomp_speed",
 	"force_compression_methods",
+	"byte_compression_level",
+	"byte_compression_strategy",
+	"byte_compression_window_log",
+	"byte_compression_dictionary",
+	"thread_count",
+	"fixed_rate",
 	NULL};
 
 static void print_hint_dbl_values(const char * name, const double val ){
@@ -75,6 +81,9 @@ void scil_user_hints_copy(scil_user_hints_t *oh, const scil_user_hints_t *hints)
 	if(hints->force_compression_methods != NULL){
 		oh->force_compression_methods = strdup(hints->force_compression_methods);
 	}
+	if(hints->byte_compression_dictionary != NULL){
+		oh->byte_compression_dictionary = strdup(hints->byte_compression_dictionary);
+	}
 }
 
 void scil_user_hints_print(const scil_user_hints_t *hints)
@@ -89,6 +98,14 @@ void scil_user_hints_print(const scil_user_hints_t *hints)
 	print_hint_dbl_values("rel abs tol", hints->relative_err_finest_abs_tolerance);
 	print_performance_hint("Comp speed", hints->comp_speed);
 	print_performance_hint("Deco speed", hints->decomp_speed);
+	print_hint_int_values("byte level", hints->byte_compression_level);
+	print_hint_int_values("byte strategy", hints->byte_compression_strategy);
+	print_hint_int_values("byte window log", hints->byte_compression_window_log);
+	print_hint_int_values("threads", hints->thread_count);
+	print_hint_dbl_values("fixed rate", hints->fixed_rate);
+	if(hints->byte_compression_dictionary != NULL){
+		printf("\tbyte dictionary:\t%s\n", hints->byte_compression_dictionary);
+	}
 }
 
 static int scil_readline(FILE * fd, int maxlength, char * out){
@@ -207,6 +224,24 @@ int scil_set_user_hint_from_string(scil_user_hints_t * hints, const char * var){
 				case(10):
 				  hints->force_compression_methods = strdup(value);
 				  break;
+				case(11):
+				  hints->byte_compression_level = atoi(value);
+				  break;
+				case(12):
+				  hints->byte_compression_strategy = atoi(value);
+				  break;
+				case(13):
+				  hints->byte_compression_window_log = atoi(value);
+				  break;
+				case(14):
+				  hints->byte_compression_dictionary = strdup(value);
+				  break;
+				case(15):
+				  hints->thread_count = atoi(value);
+				  break;
+				case(16):
+				  hints->fixed_rate = atof(value);
+				  break;
 				default:
 					printf("Error could not parse key,value: %s,%s \n", key, value);
 					exit(1);
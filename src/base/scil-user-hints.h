@@ -103,6 +103,30 @@ struct scil_user_hints_t{
     scil_performance_hint_t comp_speed;
     scil_performance_hint_t decomp_speed;
 
+    /** \brief Compression level of the byte compressor, 0 uses the default of the algorithm.
+     * The meaning depends on the algorithm:
+     * - zstd: level 1-22 (default 1), zstd-11 and zstd-22 ignore it
+     * - gzip: zlib level 1-9 (default 6), higher compresses better
+     * - lz4: acceleration 1-65537 (default 4), higher compresses faster but worse
+     * - lz4hc: level 1-12 (default 9), lz4hc-12 ignores it
+     */
+    int byte_compression_level;
+
+    /** \brief Match finding strategy of the byte compressor (zstd: 1-9), 0 uses the default of the level */
+    int byte_compression_strategy;
+
+    /** \brief Log2 of the match window of the byte compressor, 0 uses the default of the level */
+    int byte_compression_window_log;
+
+    /** \brief File containing a dictionary for the byte compressor, e.g., trained by scil_zstd_train_dictionary() */
+    char *byte_compression_dictionary;
+
+    /** \brief Number of threads an algorithm may use, 0 or 1 runs single threaded */
+    int thread_count;
+
+    /** \brief Bits per value of fixed-rate compressors (zfp-rate), which bound the size but guarantee no precision */
+    double fixed_rate;
+
     /** \brief for debugging purposes, one may set the compression method */
     char *force_compression_methods;
 };
@@ -0,0 +1,197 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-abstol-blocked.h>
+
+#include <scil-bitpack.h>
+#include <scil-quantizer.h>
+#include <scil-util.h>
+
+#include <string.h>
+
+/*
+ * Layout: absolute tolerance (8 bytes), fill value (8 bytes, DBL_MAX if unused),
+ * the header of each block: minimum (datatype) and bits per value (1 byte),
+ * the packed quantized values of each block, see scil_bitpack_block_offsets().
+ * With a fill value, the largest number of each block's bit width marks the fill values.
+ */
+#define HEADER_SIZE 16
+#define BLOCK_SIZE SCIL_BITPACK_BLOCK_SIZE
+
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+
+//Repeat for each data type
+//Supported datatypes: double float
+
+// the extremes of the values other than the fill value, 0 if there are none
+static void block_minimum_maximum_<DATATYPE>(const <DATATYPE>* restrict in, size_t n, <DATATYPE> fill, int use_fill, <DATATYPE>* minimum, <DATATYPE>* maximum){
+  if(! use_fill){
+    scilU_find_minimum_maximum_<DATATYPE>(in, n, minimum, maximum);
+    return;
+  }
+  <DATATYPE> mn = INFINITY;
+  <DATATYPE> mx = -INFINITY;
+  for(size_t i=0; i < n; i++){
+    if(in[i] != fill){
+      mn = in[i] < mn ? in[i] : mn;
+      mx = in[i] > mx ? in[i] : mx;
+    }
+  }
+  *minimum = mn <= mx ? mn : 0;
+  *maximum = mn <= mx ? mx : 0;
+}
+
+int scil_abstol_blocked_compress_<DATATYPE>(const scil_context_t* ctx,
+                                         byte* restrict dest,
+                                         size_t* restrict dest_size,
+                                         <DATATYPE>* restrict source,
+                                         const scil_dims_t* dims){
+  const double abstol = ctx->hints.absolute_tolerance;
+  if(! (abstol > 0.0)){
+    return SCIL_PRECISION_ERR;
+  }
+  const int use_fill = ctx->hints.fill_value != DBL_MAX;
+  const double fill_value = ctx->hints.fill_value;
+  const <DATATYPE> fill = use_fill ? (<DATATYPE>) fill_value : 0;
+  const size_t count = scil_dims_get_count(dims);
+  const size_t blocks = scil_bitpack_block_count(count);
+  const size_t block_header = sizeof(<DATATYPE>) + 1;
+  <DATATYPE>* maximum = (<DATATYPE>*) scilU_safe_malloc(blocks * sizeof(<DATATYPE>));
+  byte* headers = dest + HEADER_SIZE;
+  const int threads = ctx->hints.thread_count;
+
+  // the headers are written first, the offsets of the blocks follow from them
+  #pragma omp parallel for num_threads(threads) if(threads > 1 && blocks > 1)
+  for(size_t b=0; b < blocks; b++){
+    const size_t n = scil_bitpack_block_values(count, b);
+    <DATATYPE> minimum;
+    block_minimum_maximum_<DATATYPE>(source + b * BLOCK_SIZE, n, fill, use_fill, & minimum, & maximum[b]);
+    uint64_t next_free_number;
+    int bits = scil_calculate_bits_needed_<DATATYPE>(minimum, maximum[b], abstol, 0, & next_free_number);
+    if(use_fill){
+      // the number marking the fill values lies beyond the quantized values
+      next_free_number = (uint64_t) (((double) maximum[b] - (double) minimum) / (2 * abstol) + 1.5);
+      bits = scil_bits_needed(next_free_number);
+    }else if(bits == 0){
+      // constant within the tolerance
+      minimum = (maximum[b] + minimum) / 2;
+    }
+    byte* header = headers + b * block_header;
+    memcpy(header, & minimum, sizeof(<DATATYPE>));
+    header[sizeof(<DATATYPE>)] = (byte) bits;
+  }
+
+  size_t* offsets = (size_t*) scilU_safe_malloc((blocks + 1) * sizeof(size_t));
+  // a block that needs the full width of the datatype is not worth quantizing
+  if(scil_bitpack_block_offsets(offsets, headers, block_header, count, 8 * sizeof(<DATATYPE>) - 1, SIZE_MAX) != SCIL_NO_ERR){
+    free(offsets);
+    free(maximum);
+    return SCIL_PRECISION_ERR;
+  }
+  scilU_pack8(dest, abstol);
+  scilU_pack8((dest + 8), fill_value);
+
+  #pragma omp parallel num_threads(threads) if(threads > 1 && blocks > 1)
+  {
+    uint64_t* quantized = (uint64_t*) scilU_safe_malloc(BLOCK_SIZE * sizeof(uint64_t));
+    #pragma omp for
+    for(size_t b=0; b < blocks; b++){
+      const size_t n = scil_bitpack_block_values(count, b);
+      const byte* header = headers + b * block_header;
+      const int bits = header[sizeof(<DATATYPE>)];
+      <DATATYPE> minimum;
+      memcpy(& minimum, header, sizeof(<DATATYPE>));
+      if(bits == 0){
+        continue;
+      }
+      if(use_fill){
+        const uint64_t fill_number = ((uint64_t) 1 << bits) - 1;
+        scil_quantize_buffer_minmax_fill_<DATATYPE>(quantized, source + b * BLOCK_SIZE, n, abstol, minimum, maximum[b], (double) fill, fill_number);
+      }else{
+        scil_quantize_buffer_minmax_<DATATYPE>(quantized, source + b * BLOCK_SIZE, n, abstol, minimum, maximum[b]);
+      }
+      scil_bitpack(headers + offsets[b], quantized, n, bits);
+    }
+    free(quantized);
+  }
+  *dest_size = HEADER_SIZE + offsets[blocks];
+  free(offsets);
+  free(maximum);
+  return SCIL_NO_ERR;
+}
+
+int scil_abstol_blocked_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                           scil_dims_t* dims,
+                                           byte* restrict source,
+                                           size_t in_size){
+  const size_t count = scil_dims_get_count(dims);
+  const size_t blocks = scil_bitpack_block_count(count);
+  const size_t block_header = sizeof(<DATATYPE>) + 1;
+  if(in_size < HEADER_SIZE){
+    return SCIL_BUFFER_ERR;
+  }
+  double abstol;
+  double fill_value;
+  scilU_unpack8(source, & abstol);
+  scilU_unpack8((source + 8), & fill_value);
+  const int use_fill = fill_value != DBL_MAX;
+  const byte* headers = source + HEADER_SIZE;
+
+  size_t* offsets = (size_t*) scilU_safe_malloc((blocks + 1) * sizeof(size_t));
+  if(scil_bitpack_block_offsets(offsets, headers, block_header, count, 8 * sizeof(<DATATYPE>) - 1, in_size - HEADER_SIZE) != SCIL_NO_ERR){
+    free(offsets);
+    return SCIL_BUFFER_ERR;
+  }
+
+  #pragma omp parallel if(blocks > 1)
+  {
+    uint64_t* quantized = (uint64_t*) scilU_safe_malloc(BLOCK_SIZE * sizeof(uint64_t));
+    #pragma omp for
+    for(size_t b=0; b < blocks; b++){
+      const size_t n = scil_bitpack_block_values(count, b);
+      const byte* header = headers + b * block_header;
+      <DATATYPE> minimum;
+      memcpy(& minimum, header, sizeof(<DATATYPE>));
+      const int bits = header[sizeof(<DATATYPE>)];
+      if(bits == 0){
+        for(size_t i=0; i < n; i++){
+          dest[b * BLOCK_SIZE + i] = minimum;
+        }
+        continue;
+      }
+      scil_bitunpack(quantized, headers + offsets[b], n, bits);
+      if(use_fill){
+        scil_unquantize_buffer_fill_<DATATYPE>(dest + b * BLOCK_SIZE, quantized, n, abstol, minimum, fill_value, ((uint64_t) 1 << bits) - 1);
+      }else{
+        scil_unquantize_buffer_<DATATYPE>(dest + b * BLOCK_SIZE, quantized, n, abstol, minimum);
+      }
+    }
+    free(quantized);
+  }
+  free(offsets);
+  return SCIL_NO_ERR;
+}
+
+// End repeat
+
+scilU_algorithm_t algo_abstol_blocked = {
+    .c.DNtype = {
+        CREATE_INITIALIZER(scil_abstol_blocked)
+    },
+    "abstol-blocked",
+    32,
+    SCIL_COMPRESSOR_TYPE_DATATYPES,
+    1
+};
@@ -0,0 +1,51 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_ABSTOL_BLOCKED_H_
+#define SCIL_ABSTOL_BLOCKED_H_
+
+/**
+ * \file
+ * \brief Absolute tolerance quantization with a minimum and a bit width per block of values.
+ *
+ * In contrast to abstol, locally smooth data needs only the bits of the local value range.
+ * The blocks are quantized and packed independently with thread_count threads.
+ * Fill values are not treated specially, the fill preconditioner removes them beforehand.
+ */
+
+#include <scil-algorithm-impl.h>
+
+//Repeat for each data type
+//Supported datatypes:double float
+
+/**
+ * \brief Compresses with the absolute_tolerance hint
+ * \return SCIL_PRECISION_ERR if no absolute tolerance is set or a block needs the full width of the datatype
+ */
+int scil_abstol_blocked_compress_<DATATYPE>(const scil_context_t* ctx,
+                                         byte* restrict dest,
+                                         size_t* restrict dest_size,
+                                         <DATATYPE>* restrict source,
+                                         const scil_dims_t* dims);
+
+int scil_abstol_blocked_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                           scil_dims_t* dims,
+                                           byte* restrict source,
+                                           size_t in_size);
+// End repeat
+
+extern scilU_algorithm_t algo_abstol_blocked;
+
+#endif /* SCIL_ABSTOL_BLOCKED_H_ */
@@ -15,7 +15,9 @@
 
 #include <algo/algo-abstol.h>
 
+#include <scil-bitpack.h>
 #include <scil-quantizer.h>
+#include <scil-statistics.h>
 #include <scil-swager.h>
 #include <scil-util.h>
 
@@ -23,6 +25,9 @@
 #include <math.h>
 #include <string.h>
 
+// flags bits_per_value if the quantized values are stored as a reference (8 bytes) and a PFOR stream
+#define PFOR_FLAG 0x80
+
 static uint64_t round_up_byte(const uint64_t bits){
 
     uint8_t a = bits % 8;
@@ -99,8 +104,10 @@ int scil_abstol_compress_<DATATYPE>(const scil_context_t* ctx,
     size_t count = scil_dims_get_count(dims);
 
     // Finding minimum and maximum values in data
-    <DATATYPE> min, max;
-    scilU_find_minimum_maximum_with_excluded_points_<DATATYPE>(source, count, &min, &max, ctx->hints.lossless_data_range_up_to,  ctx->hints.lossless_data_range_from, ctx->hints.fill_value);
+    scilU_statistics_<DATATYPE>_t statistics;
+    scil_get_statistics_<DATATYPE>(ctx, source, count, & statistics);
+    <DATATYPE> min = statistics.minimum;
+    <DATATYPE> max = statistics.maximum;
 
     // Locally assigning absolute tolerance
     double abs_tol = ctx->hints.absolute_tolerance; // prevent rounding errors
@@ -145,6 +152,24 @@ int scil_abstol_compress_<DATATYPE>(const scil_context_t* ctx,
       }
     }
 
+    // rare outliers inflate the width of all values, try to patch them instead
+    const uint64_t mask = ((uint64_t) 1 << bits_per_value) - 1;
+    uint64_t reference = scil_pfor_reference(quantized_buffer, count, bits_per_value);
+    for(size_t i = 0; i < count; ++i){
+        quantized_buffer[i] = (quantized_buffer[i] - reference) & mask;
+    }
+    scilU_pack8(dest, reference);
+    const size_t pfor_size = 8 + scil_pfor_compress(dest + 8, quantized_buffer, count, bits_per_value);
+    if(pfor_size + header_size < *dest_size){
+        write_header(dest - header_size, min, abs_tol, bits_per_value | PFOR_FLAG, ctx->hints.fill_value, next_free_number);
+        *dest_size = pfor_size + header_size;
+        free(quantized_buffer);
+        return SCIL_NO_ERR;
+    }
+    for(size_t i = 0; i < count; ++i){
+        quantized_buffer[i] = (quantized_buffer[i] + reference) & mask;
+    }
+
     // Pack data in quantized buffer tightly
     if(scil_swage(dest, quantized_buffer, count, bits_per_value)){
         return SCIL_BUFFER_ERR;
@@ -183,8 +208,25 @@ int scil_abstol_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
     }
 
     uint64_t* unswaged_buffer = (uint64_t*)scilU_safe_malloc(count * sizeof(uint64_t*));
-    // Unpacking buffer
-    if(scil_unswage(unswaged_buffer, in, count, bits_per_value)){
+    if(bits_per_value & PFOR_FLAG){
+        bits_per_value &= ~PFOR_FLAG;
+        uint64_t reference;
+        size_t parsed;
+        if(in_size < 8 || bits_per_value >= 64){
+            free(unswaged_buffer);
+            return SCIL_BUFFER_ERR;
+        }
+        scilU_unpack8(in, & reference);
+        if(scil_pfor_decompress(unswaged_buffer, count, bits_per_value, in + 8, in_size - 8, & parsed) != SCIL_NO_ERR){
+            free(unswaged_buffer);
+            return SCIL_BUFFER_ERR;
+        }
+        const uint64_t mask = ((uint64_t) 1 << bits_per_value) - 1;
+        for(size_t i = 0; i < count; ++i){
+            unswaged_buffer[i] = (unswaged_buffer[i] + reference) & mask;
+        }
+    }else if(scil_unswage(unswaged_buffer, in, count, bits_per_value)){
+        // Unpacking buffer
         return SCIL_BUFFER_ERR;
     }
 
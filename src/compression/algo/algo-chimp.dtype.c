@@ -0,0 +1,286 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-chimp.h>
+
+#include <scil-util.h>
+
+#include <string.h>
+
+/*
+ * Layout: mode (1 byte), for MODE_STORED the data follows, for MODE_XOR the bit stream (most significant bit first).
+ * Each XOR of a value with its predecessor (the first one with zero) starts with a two bit flag:
+ * 00 the value repeats
+ * 01 the leading zero code (3 bits), the number of center bits, the center bits without the trailing zeros
+ * 10 the bits after the leading zeros of the previous value
+ * 11 the leading zero code (3 bits), the bits after the leading zeros
+ */
+#define MODE_STORED 0
+#define MODE_XOR 1
+
+#define FLAG_ZERO 0
+#define FLAG_CENTER 1
+#define FLAG_SAME_LEAD 2
+#define FLAG_NEW_LEAD 3
+
+// after a FLAG_CENTER value, the next one cannot reuse the leading zeros
+#define NO_LEAD 255
+
+static const uint8_t lead_levels[8] = {0, 8, 12, 16, 18, 20, 22, 24};
+
+// the code of the largest level not above the leading zeros
+static const uint8_t lead_code[65] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7
+};
+
+typedef struct{
+  uint8_t flag;
+  uint8_t lead;
+  uint8_t consumed;
+} decode_entry_t;
+
+// indexed by the next five bits, the flag and the possible code of the leading zeros
+static const decode_entry_t decode_table[32] = {
+  {0, 0, 2}, {0, 8, 2}, {0, 12, 2}, {0, 16, 2}, {0, 18, 2}, {0, 20, 2}, {0, 22, 2}, {0, 24, 2},
+  {1, 0, 5}, {1, 8, 5}, {1, 12, 5}, {1, 16, 5}, {1, 18, 5}, {1, 20, 5}, {1, 22, 5}, {1, 24, 5},
+  {2, 0, 2}, {2, 8, 2}, {2, 12, 2}, {2, 16, 2}, {2, 18, 2}, {2, 20, 2}, {2, 22, 2}, {2, 24, 2},
+  {3, 0, 5}, {3, 8, 5}, {3, 12, 5}, {3, 16, 5}, {3, 18, 5}, {3, 20, 5}, {3, 22, 5}, {3, 24, 5}
+};
+
+typedef struct{
+  byte* out;
+  uint64_t acc;
+  int fill;
+} bit_writer_t;
+
+// up to 32 bits
+static inline void put_bits(bit_writer_t* w, uint64_t value, int n){
+  w->acc = (w->acc << n) | value;
+  w->fill += n;
+  if(w->fill >= 32){
+    w->fill -= 32;
+    const uint32_t word = (uint32_t) (w->acc >> w->fill);
+    w->out[0] = (byte) (word >> 24);
+    w->out[1] = (byte) (word >> 16);
+    w->out[2] = (byte) (word >> 8);
+    w->out[3] = (byte) word;
+    w->out += 4;
+  }
+}
+
+static inline void put_bits64(bit_writer_t* w, uint64_t value, int n){
+  if(n > 32){
+    put_bits(w, value >> 32, n - 32);
+    put_bits(w, value & 0xFFFFFFFFu, 32);
+  }else{
+    put_bits(w, value, n);
+  }
+}
+
+static void flush_bits(bit_writer_t* w){
+  while(w->fill > 0){
+    const int n = w->fill < 8 ? w->fill : 8;
+    w->fill -= n;
+    *w->out++ = (byte) (((w->acc >> w->fill) & ((1u << n) - 1)) << (8 - n));
+  }
+}
+
+typedef struct{
+  const byte* in;
+  const byte* end;
+  // the next bit is the most significant one
+  uint64_t window;
+  int avail;
+  // zero bits after the end of the input at the bottom of the window
+  int padding;
+} bit_reader_t;
+
+static inline void refill(bit_reader_t* r){
+  if(r->in + 8 <= r->end){
+    uint64_t word;
+    memcpy(& word, r->in, 8);
+    r->window |= __builtin_bswap64(word) >> r->avail;
+    r->in += (63 - r->avail) >> 3;
+    r->avail |= 56;
+    return;
+  }
+  while(r->avail <= 56){
+    if(r->in < r->end){
+      r->window |= (uint64_t) *r->in++ << (56 - r->avail);
+    }else{
+      r->padding += 8;
+    }
+    r->avail += 8;
+  }
+}
+
+// 1 to 63 bits, at least n bits must be available
+static inline uint64_t get_bits(bit_reader_t* r, int n){
+  const uint64_t value = r->window >> (64 - n);
+  r->window <<= n;
+  r->avail -= n;
+  return value;
+}
+
+static inline uint64_t read_bits64(bit_reader_t* r, int n){
+  if(r->avail < n){
+    refill(r);
+  }
+  // a refilled window holds at least 56 bits
+  if(n <= r->avail && n < 64){
+    return get_bits(r, n);
+  }
+  const uint64_t high = get_bits(r, n - 32);
+  refill(r);
+  return (high << 32) | get_bits(r, 32);
+}
+
+//Repeat for each data type
+//Supported datatypes: double float
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+int scil_chimp_compress_<DATATYPE>(const scil_context_t* ctx,
+                                byte* restrict dest,
+                                size_t* restrict dest_size,
+                                <DATATYPE>* restrict source,
+                                const scil_dims_t* dims){
+  const int bits = <DATATYPE_SIZE>;
+  const int center_bits = bits == 64 ? 6 : 5;
+  const int trail_threshold = bits == 64 ? 6 : 5;
+  const size_t count = scil_dims_get_count(dims);
+  const size_t stored_size = 1 + count * sizeof(<DATATYPE>);
+
+  bit_writer_t w = {dest + 1, 0, 0};
+  uint64_t prev = 0;
+  int prev_lead = NO_LEAD;
+  size_t i = 0;
+  // a value takes at most 69 bits, the output is checked once per value
+  for(; i < count && (size_t) (w.out - dest) <= stored_size; i++){
+    uint<DATATYPE_SIZE>_t value;
+    memcpy(& value, & source[i], sizeof(value));
+    const uint64_t x = (uint64_t) value ^ prev;
+    prev = value;
+    if(x == 0){
+      put_bits(& w, FLAG_ZERO, 2);
+      continue;
+    }
+    const int code = lead_code[__builtin_clzll(x) - (64 - bits)];
+    const int lead = lead_levels[code];
+    const int trail = __builtin_ctzll(x);
+    if(trail > trail_threshold){
+      const int center = bits - lead - trail;
+      put_bits(& w, (FLAG_CENTER << 3) | code, 5);
+      put_bits(& w, center, center_bits);
+      put_bits64(& w, x >> trail, center);
+      prev_lead = NO_LEAD;
+    }else if(lead == prev_lead){
+      put_bits(& w, FLAG_SAME_LEAD, 2);
+      put_bits64(& w, x, bits - lead);
+    }else{
+      put_bits(& w, (FLAG_NEW_LEAD << 3) | code, 5);
+      put_bits64(& w, x, bits - lead);
+      prev_lead = lead;
+    }
+  }
+  flush_bits(& w);
+  const size_t size = w.out - dest;
+  if(i < count || size >= stored_size){
+    dest[0] = MODE_STORED;
+    memcpy(dest + 1, source, count * sizeof(<DATATYPE>));
+    *dest_size = stored_size;
+    return SCIL_NO_ERR;
+  }
+  dest[0] = MODE_XOR;
+  *dest_size = size;
+  return SCIL_NO_ERR;
+}
+
+int scil_chimp_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                  scil_dims_t* dims,
+                                  byte* restrict source,
+                                  size_t in_size){
+  const int bits = <DATATYPE_SIZE>;
+  const int center_bits = bits == 64 ? 6 : 5;
+  const size_t count = scil_dims_get_count(dims);
+  if(in_size < 1){
+    return SCIL_BUFFER_ERR;
+  }
+  if(source[0] == MODE_STORED){
+    if(in_size != 1 + count * sizeof(<DATATYPE>)){
+      return SCIL_BUFFER_ERR;
+    }
+    memcpy(dest, source + 1, count * sizeof(<DATATYPE>));
+    return SCIL_NO_ERR;
+  }
+  if(source[0] != MODE_XOR){
+    return SCIL_BUFFER_ERR;
+  }
+
+  bit_reader_t r = {source + 1, source + in_size, 0, 0, 0};
+  uint64_t prev = 0;
+  int prev_lead = NO_LEAD;
+  for(size_t i=0; i < count; i++){
+    refill(& r);
+    const decode_entry_t e = decode_table[r.window >> 59];
+    get_bits(& r, e.consumed);
+    uint64_t x = 0;
+    switch(e.flag){
+      case FLAG_ZERO:
+        break;
+      case FLAG_CENTER: {
+        const int center = (int) get_bits(& r, center_bits);
+        const int trail = bits - e.lead - center;
+        if(center == 0 || trail < 0){
+          return SCIL_BUFFER_ERR;
+        }
+        x = read_bits64(& r, center) << trail;
+        prev_lead = NO_LEAD;
+        break;
+      }
+      case FLAG_SAME_LEAD:
+        if(prev_lead == NO_LEAD){
+          return SCIL_BUFFER_ERR;
+        }
+        x = read_bits64(& r, bits - prev_lead);
+        break;
+      default:
+        x = read_bits64(& r, bits - e.lead);
+        prev_lead = e.lead;
+    }
+    prev ^= x;
+    const uint<DATATYPE_SIZE>_t value = (uint<DATATYPE_SIZE>_t) prev;
+    memcpy(& dest[i], & value, sizeof(value));
+  }
+  if(r.avail < r.padding){
+    return SCIL_BUFFER_ERR;
+  }
+  return SCIL_NO_ERR;
+}
+
+// End repeat
+
+scilU_algorithm_t algo_chimp = {
+    .c.DNtype = {
+        CREATE_INITIALIZER(scil_chimp)
+    },
+    "chimp",
+    36,
+    SCIL_COMPRESSOR_TYPE_DATATYPES,
+    0
+};
@@ -0,0 +1,47 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_CHIMP_H_
+#define SCIL_CHIMP_H_
+
+/**
+ * \file
+ * \brief Lossless XOR compressor for time series in the style of Gorilla and Chimp.
+ *
+ * Each value is XORed with its predecessor, the result is coded by its leading zeros, rounded to one of eight levels,
+ * and, if it has many trailing zeros, by the length of its center bits.
+ * Compression and decompression are sequential, the decoder determines the case and leading zeros with one table lookup.
+ */
+
+#include <scil-algorithm-impl.h>
+
+//Repeat for each data type
+//Supported datatypes:double float
+
+int scil_chimp_compress_<DATATYPE>(const scil_context_t* ctx,
+                                byte* restrict dest,
+                                size_t* restrict dest_size,
+                                <DATATYPE>* restrict source,
+                                const scil_dims_t* dims);
+
+int scil_chimp_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                  scil_dims_t* dims,
+                                  byte* restrict source,
+                                  size_t in_size);
+// End repeat
+
+extern scilU_algorithm_t algo_chimp;
+
+#endif /* SCIL_CHIMP_H_ */
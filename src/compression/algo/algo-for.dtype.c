@@ -0,0 +1,128 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-for.h>
+
+#include <scil-bitpack.h>
+#include <scil-util.h>
+
+#include <string.h>
+
+/*
+ * Layout: the header of each block: minimum (datatype) and bits per value (1 byte),
+ * the packed differences to the minimum of each block, see scil_bitpack_block_offsets().
+ */
+#define BLOCK_SIZE SCIL_BITPACK_BLOCK_SIZE
+
+//Repeat for each data type
+//Supported datatypes: int8_t int16_t int32_t int64_t
+
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+int scil_for_compress_<DATATYPE>(const scil_context_t* ctx,
+                              byte* restrict dest,
+                              size_t* restrict dest_size,
+                              <DATATYPE>* restrict source,
+                              const scil_dims_t* dims){
+  const size_t count = scil_dims_get_count(dims);
+  const size_t blocks = scil_bitpack_block_count(count);
+  const size_t block_header = sizeof(<DATATYPE>) + 1;
+  size_t* offsets = (size_t*) scilU_safe_malloc((blocks + 1) * sizeof(size_t));
+  const int threads = ctx->hints.thread_count;
+
+  // the headers are written first, the offsets of the blocks follow from them
+  #pragma omp parallel for num_threads(threads) if(threads > 1 && blocks > 1)
+  for(size_t b=0; b < blocks; b++){
+    const <DATATYPE>* in = source + b * BLOCK_SIZE;
+    const size_t n = scil_bitpack_block_values(count, b);
+    <DATATYPE> minimum = in[0];
+    <DATATYPE> maximum = in[0];
+    for(size_t i=1; i < n; i++){
+      minimum = in[i] < minimum ? in[i] : minimum;
+      maximum = in[i] > maximum ? in[i] : maximum;
+    }
+    const int bits = scil_bits_needed((u<DATATYPE>) ((u<DATATYPE>) maximum - (u<DATATYPE>) minimum));
+    byte* header = dest + b * block_header;
+    memcpy(header, & minimum, sizeof(<DATATYPE>));
+    header[sizeof(<DATATYPE>)] = (byte) bits;
+  }
+  scil_bitpack_block_offsets(offsets, dest, block_header, count, <DATATYPE_SIZE>, SIZE_MAX);
+
+  #pragma omp parallel num_threads(threads) if(threads > 1 && blocks > 1)
+  {
+    uint64_t* differences = (uint64_t*) scilU_safe_malloc(BLOCK_SIZE * sizeof(uint64_t));
+    #pragma omp for
+    for(size_t b=0; b < blocks; b++){
+      const u<DATATYPE>* in = (const u<DATATYPE>*) source + b * BLOCK_SIZE;
+      const size_t n = scil_bitpack_block_values(count, b);
+      const byte* header = dest + b * block_header;
+      u<DATATYPE> minimum;
+      memcpy(& minimum, header, sizeof(<DATATYPE>));
+      for(size_t i=0; i < n; i++){
+        differences[i] = (u<DATATYPE>) (in[i] - minimum);
+      }
+      scil_bitpack(dest + offsets[b], differences, n, header[sizeof(<DATATYPE>)]);
+    }
+    free(differences);
+  }
+  *dest_size = offsets[blocks];
+  free(offsets);
+  return SCIL_NO_ERR;
+}
+
+int scil_for_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                scil_dims_t* dims,
+                                byte* restrict source,
+                                size_t in_size){
+  const size_t count = scil_dims_get_count(dims);
+  const size_t blocks = scil_bitpack_block_count(count);
+  const size_t block_header = sizeof(<DATATYPE>) + 1;
+  size_t* offsets = (size_t*) scilU_safe_malloc((blocks + 1) * sizeof(size_t));
+  if(scil_bitpack_block_offsets(offsets, source, block_header, count, <DATATYPE_SIZE>, in_size) != SCIL_NO_ERR){
+    free(offsets);
+    return SCIL_BUFFER_ERR;
+  }
+
+  #pragma omp parallel if(blocks > 1)
+  {
+    uint64_t* differences = (uint64_t*) scilU_safe_malloc(BLOCK_SIZE * sizeof(uint64_t));
+    #pragma omp for
+    for(size_t b=0; b < blocks; b++){
+      u<DATATYPE>* out = (u<DATATYPE>*) dest + b * BLOCK_SIZE;
+      const size_t n = scil_bitpack_block_values(count, b);
+      const byte* header = source + b * block_header;
+      u<DATATYPE> minimum;
+      memcpy(& minimum, header, sizeof(<DATATYPE>));
+      scil_bitunpack(differences, source + offsets[b], n, header[sizeof(<DATATYPE>)]);
+      for(size_t i=0; i < n; i++){
+        out[i] = (u<DATATYPE>) (minimum + differences[i]);
+      }
+    }
+    free(differences);
+  }
+  free(offsets);
+  return SCIL_NO_ERR;
+}
+
+// End repeat
+
+scilU_algorithm_t algo_for = {
+    .c.DNtype = {
+        CREATE_INITIALIZER(scil_for)
+    },
+    "for",
+    37,
+    SCIL_COMPRESSOR_TYPE_DATATYPES,
+    0
+};
@@ -16,37 +16,77 @@
 #include <zlib.h>
 
 #include <algo-gzip.h>
+#include <scil-blocks.h>
 
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-int scil_gzip_compress(const scil_context_t* ctx, byte* restrict dest, size_t* restrict dest_size, const byte*restrict source, const size_t source_size){
-  *dest_size = 2*source_size;
-  int ret = compress( (Bytef*)dest, dest_size, (Bytef*)source, (uLong)(source_size) );
-  if (ret == Z_OK){
-    return SCIL_NO_ERR;
-  }else{
+// the single zlib stream written before the block format, decoded for streams without the chain format flag
+static int gzip_v1_decompress(byte*restrict data_out, size_t buff_size,  const byte*restrict compressed_buf_in, const size_t in_size, size_t * uncomp_size_out){
+  uLongf out_buffer_size = (uLongf) buff_size;
+  int ret = uncompress( (Bytef*)data_out, & out_buffer_size, (Bytef*)compressed_buf_in, (uLong)in_size);
+  if(ret != Z_OK){
+    debug("Error in gzip decompression. (Buf error: %d mem error: %d data_error: %d)\n",
+    ret == Z_BUF_ERROR , ret == Z_MEM_ERROR, ret == Z_DATA_ERROR);
+    return SCIL_UNKNOWN_ERR;
+  }
+  *uncomp_size_out = (size_t) out_buffer_size;
+  return SCIL_NO_ERR;
+}
+
+static size_t gzip_compress_block(const scil_context_t* ctx, byte* restrict dest, size_t dest_capacity, const byte* restrict source, size_t source_size){
+  uLongf dest_size = (uLongf) dest_capacity;
+  int level = Z_DEFAULT_COMPRESSION;
+  if(ctx != NULL && ctx->hints.byte_compression_level != 0){
+    level = ctx->hints.byte_compression_level;
+  }
+  int ret = compress2( (Bytef*)dest, & dest_size, (Bytef*)source, (uLong)(source_size), level);
+  if (ret != Z_OK){
     debug("Error in gzip compression. (Buf error: %d mem error: %d data_error: %d size: %lld)\n",
     ret == Z_BUF_ERROR , ret == Z_MEM_ERROR, ret == Z_DATA_ERROR, (long long) source_size);
-
-    return SCIL_UNKNOWN_ERR;
+    return 0;
   }
+  return (size_t) dest_size;
 }
 
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-int scil_gzip_decompress(byte*restrict data_out, size_t buff_size,  const byte*restrict compressed_buf_in, const size_t in_size, size_t * uncomp_size_out)
-{
-  uLongf out_buffer_size = (uLongf) buff_size;
+static int gzip_decompress_block(byte* restrict data_out, size_t out_size, const byte* restrict compressed_buf_in, size_t in_size){
+  uLongf out_buffer_size = (uLongf) out_size;
   int ret = uncompress( (Bytef*)data_out, & out_buffer_size, (Bytef*)compressed_buf_in, (uLong)in_size);
 
-  if(ret != Z_OK){
-      debug("Error in gzip decompression. (Buf error: %d mem error: %d data_error: %d size: %lld)\n",
-      ret == Z_BUF_ERROR , ret == Z_MEM_ERROR, ret == Z_DATA_ERROR, (long long) *uncomp_size_out);
-      ret = SCIL_UNKNOWN_ERR;
+  if(ret != Z_OK || out_buffer_size != out_size){
+    debug("Error in gzip decompression. (Buf error: %d mem error: %d data_error: %d size: %lld)\n",
+    ret == Z_BUF_ERROR , ret == Z_MEM_ERROR, ret == Z_DATA_ERROR, (long long) out_size);
+    return SCIL_UNKNOWN_ERR;
   }
-  *uncomp_size_out = (size_t) out_buffer_size;
+  return SCIL_NO_ERR;
+}
 
-  return ret;
+static size_t gzip_bound(size_t source_size){
+  return (size_t) compressBound((uLong) source_size);
 }
 
+static const scil_block_codec_t gzip_codec = {
+  gzip_compress_block,
+  gzip_decompress_block,
+  gzip_bound
+};
+
+int scil_gzip_compress(const scil_context_t* ctx, byte* restrict dest, size_t* restrict dest_size, const byte*restrict source, const size_t source_size){
+  return scil_blocks_compress(ctx, & gzip_codec, dest, dest_size, source, source_size);
+}
+
+int scil_gzip_decompress(byte*restrict data_out, size_t buff_size,  const byte*restrict compressed_buf_in, const size_t in_size, size_t * uncomp_size_out)
+{
+  return scil_blocks_decompress(& gzip_codec, data_out, buff_size, compressed_buf_in, in_size, uncomp_size_out);
+}
+
+scilU_algorithm_t algo_gzip_v1 = {
+    .c.Btype = {
+        NULL,
+        gzip_v1_decompress
+    },
+    "gzip-v1",
+    2,
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES
+};
+
 scilU_algorithm_t algo_gzip = {
     .c.Btype = {
         scil_gzip_compress,
@@ -54,5 +94,6 @@ scilU_algorithm_t algo_gzip = {
     },
     "gzip",
     2,
-    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES,
+    .legacy = & algo_gzip_v1
 };
@@ -26,7 +26,7 @@
 #include <scil-algorithm-impl.h>
 
 /**
- * \brief Compression function of gzip
+ * \brief Compression function of gzip, the input is split into blocks compressed with ctx->hints.thread_count threads
  * \param ctx Compression context used for this compression
  * \param dest Pre allocated buffer which will hold the compressed data
  * \param dest_size Byte size the compressed buffer will have
@@ -48,4 +48,10 @@ int scil_gzip_decompress(byte*restrict data_out, size_t buff_size, const byte*re
 
 extern scilU_algorithm_t algo_gzip;
 
+/**
+ * \brief gzip as a single zlib stream, the format of the compressor ID 2 before gzip used independent blocks.
+ * It is not registered, the streams without the chain format flag are decoded by it.
+ */
+extern scilU_algorithm_t algo_gzip_v1;
+
 #endif
@@ -0,0 +1,352 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-half.h>
+
+#include <scil-util.h>
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HALF_F16C
+#include <immintrin.h>
+#endif
+
+#define HALF_EXPONENT_BITS 5
+#define HALF_MANTISSA_BITS 10
+#define BFLOAT16_EXPONENT_BITS 8
+#define BFLOAT16_MANTISSA_BITS 7
+
+// rounds to nearest even into a format with 1 sign, exponent_bits and mantissa_bits, overflows become infinity
+static uint16_t round_to_format(double value, int exponent_bits, int mantissa_bits){
+  uint64_t bits;
+  memcpy(& bits, & value, sizeof(bits));
+  const uint16_t sign = (uint16_t) ((bits >> 63) << (exponent_bits + mantissa_bits));
+  const int exponent = (int) ((bits >> 52) & 0x7ff);
+  const uint64_t mantissa = bits & (((uint64_t) 1 << 52) - 1);
+  const uint32_t infinity = ((1u << exponent_bits) - 1) << mantissa_bits;
+
+  if(exponent == 0x7ff){
+    // keep the upper bits of the payload, NaNs stay quiet NaNs
+    return sign | infinity | (mantissa ? (uint16_t) (mantissa >> (52 - mantissa_bits)) | (1u << (mantissa_bits - 1)) : 0);
+  }
+  if(exponent == 0){
+    // double subnormals are far below the smallest subnormal of both formats
+    return sign;
+  }
+  const int target = exponent - 1023 + (1 << (exponent_bits - 1)) - 1;
+  const uint64_t significand = mantissa | ((uint64_t) 1 << 52);
+  // subnormal results lose one bit per exponent below 1
+  const int shift = 52 - mantissa_bits + (target < 1 ? 1 - target : 0);
+  if(shift > 53){
+    return sign;
+  }
+  uint64_t rounded = significand >> shift;
+  const uint64_t remainder = significand & (((uint64_t) 1 << shift) - 1);
+  const uint64_t half = (uint64_t) 1 << (shift - 1);
+  if(remainder > half || (remainder == half && (rounded & 1))){
+    rounded++;
+  }
+  if(target < 1){
+    // a carry turns the largest subnormal into the smallest normal number
+    return sign | (uint16_t) rounded;
+  }
+  // the implicit bit adds to the exponent, a carry of the mantissa increments it
+  const uint64_t result = ((uint64_t) (target - 1) << mantissa_bits) + rounded;
+  return sign | (uint16_t) (result >= infinity ? infinity : result);
+}
+
+static inline float half_to_float(uint16_t value){
+  // scaling by 2^112 rebiases normal and subnormal values at once
+  const uint32_t magnitude = (uint32_t) (value & 0x7fff) << 13;
+  float scaled;
+  memcpy(& scaled, & magnitude, sizeof(scaled));
+  scaled *= 0x1p112f;
+  uint32_t bits;
+  memcpy(& bits, & scaled, sizeof(bits));
+  if((value & 0x7c00) == 0x7c00){
+    // like F16C, signaling NaNs become quiet NaNs
+    bits = magnitude | 0x7f800000 | ((value & 0x3ff) ? 0x400000 : 0);
+  }
+  bits |= (uint32_t) (value & 0x8000) << 16;
+  float result;
+  memcpy(& result, & bits, sizeof(result));
+  return result;
+}
+
+static inline float bfloat16_to_float(uint16_t value){
+  const uint32_t bits = (uint32_t) value << 16;
+  float result;
+  memcpy(& result, & bits, sizeof(result));
+  return result;
+}
+
+#ifdef HALF_F16C
+// the library is built for the baseline x86, the conversion instructions are chosen at runtime
+static int has_f16c(void){
+  return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+}
+
+// returns the number of values converted, a multiple of 8
+__attribute__((target("avx,f16c")))
+static size_t encode_half_float_f16c(int64_t* restrict dest, const float* restrict source, size_t count){
+  size_t i = 0;
+  for(; i + 8 <= count; i += 8){
+    uint16_t values[8];
+    const __m128i converted = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128((__m128i*) values, converted);
+    for(int k=0; k < 8; k++){
+      dest[i + k] = values[k];
+    }
+  }
+  return i;
+}
+
+__attribute__((target("avx,f16c")))
+static size_t decode_half_float_f16c(float* restrict dest, const int64_t* restrict source, size_t count){
+  size_t i = 0;
+  for(; i + 8 <= count; i += 8){
+    uint16_t values[8];
+    for(int k=0; k < 8; k++){
+      values[k] = (uint16_t) source[i + k];
+    }
+    _mm256_storeu_ps(dest + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*) values)));
+  }
+  return i;
+}
+#endif
+
+static void encode_half_float(int64_t* restrict dest, const float* restrict source, size_t count){
+  size_t i = 0;
+#ifdef HALF_F16C
+  if(has_f16c()){
+    i = encode_half_float_f16c(dest, source, count);
+  }
+#endif
+  for(; i < count; i++){
+    dest[i] = round_to_format(source[i], HALF_EXPONENT_BITS, HALF_MANTISSA_BITS);
+  }
+}
+
+static void encode_half_double(int64_t* restrict dest, const double* restrict source, size_t count){
+  // converting to float first would round twice
+  for(size_t i=0; i < count; i++){
+    dest[i] = round_to_format(source[i], HALF_EXPONENT_BITS, HALF_MANTISSA_BITS);
+  }
+}
+
+static void encode_bfloat16_float(int64_t* restrict dest, const float* restrict source, size_t count){
+  // the upper half of a float is a bfloat16, adding 0x7fff and the lowest kept bit rounds to nearest even
+  const uint32_t* bits = (const uint32_t*) source;
+  for(size_t i=0; i < count; i++){
+    const uint32_t value = bits[i];
+    const uint32_t rounded = (value + 0x7fff + ((value >> 16) & 1)) >> 16;
+    dest[i] = (value & 0x7fffffff) > 0x7f800000 ? (value >> 16) | 0x40 : rounded;
+  }
+}
+
+static void encode_bfloat16_double(int64_t* restrict dest, const double* restrict source, size_t count){
+  for(size_t i=0; i < count; i++){
+    dest[i] = round_to_format(source[i], BFLOAT16_EXPONENT_BITS, BFLOAT16_MANTISSA_BITS);
+  }
+}
+
+static void decode_half_float(float* restrict dest, const int64_t* restrict source, size_t count){
+  size_t i = 0;
+#ifdef HALF_F16C
+  if(has_f16c()){
+    i = decode_half_float_f16c(dest, source, count);
+  }
+#endif
+  for(; i < count; i++){
+    dest[i] = half_to_float((uint16_t) source[i]);
+  }
+}
+
+static void decode_half_double(double* restrict dest, const int64_t* restrict source, size_t count){
+  for(size_t i=0; i < count; i++){
+    dest[i] = half_to_float((uint16_t) source[i]);
+  }
+}
+
+static void decode_bfloat16_float(float* restrict dest, const int64_t* restrict source, size_t count){
+  for(size_t i=0; i < count; i++){
+    dest[i] = bfloat16_to_float((uint16_t) source[i]);
+  }
+}
+
+static void decode_bfloat16_double(double* restrict dest, const int64_t* restrict source, size_t count){
+  for(size_t i=0; i < count; i++){
+    dest[i] = bfloat16_to_float((uint16_t) source[i]);
+  }
+}
+
+// the number of significant bits required by the hints, or 0 if no precision is given
+static int required_significant_bits(const scil_context_t* ctx){
+  int bits = ctx->hints.significant_bits;
+  if(bits == SCIL_ACCURACY_INT_FINEST){
+    return INT32_MAX;
+  }
+  if(ctx->hints.relative_tolerance_percent > 0.0){
+    const int bits_rel = scilU_relative_tolerance_to_significant_bits(ctx->hints.relative_tolerance_percent);
+    if(bits_rel > bits){
+      bits = bits_rel;
+    }
+  }
+  return bits;
+}
+
+#define BLOCK_SIZE 4096
+
+//Repeat for each data type
+//Supported datatypes: float double
+
+/*
+ * Checks that the format keeps the required bits of all values:
+ * the largest finite value must not overflow and the smallest must not become a subnormal with fewer bits.
+ * Values below the finest absolute tolerance only need to keep their absolute error.
+ */
+static int check_format_<DATATYPE>(const scil_context_t* ctx, const <DATATYPE>* source, size_t count, int exponent_bits, int mantissa_bits){
+  const int bits = required_significant_bits(ctx);
+  if(bits == SCIL_ACCURACY_INT_IGNORE || bits > mantissa_bits + 1){
+    return SCIL_PRECISION_ERR;
+  }
+  const int bias = (1 << (exponent_bits - 1)) - 1;
+  const double finest = ctx->hints.relative_err_finest_abs_tolerance;
+  const int threads = ctx->hints.thread_count;
+
+  double maximum = 0;
+  double minimum = INFINITY;
+  #pragma omp parallel for num_threads(threads) if(threads > 1) reduction(max:maximum) reduction(min:minimum)
+  for(size_t i=0; i < count; i++){
+    const double value = fabs((double) source[i]);
+    // NaN fails all comparisons, infinities are kept by the format
+    if(value <= DBL_MAX && value > maximum){
+      maximum = value;
+    }
+    if(value > finest && value < minimum){
+      minimum = value;
+    }
+  }
+
+  const uint16_t largest = round_to_format(maximum, exponent_bits, mantissa_bits);
+  if((unsigned) (largest >> mantissa_bits) == (1u << exponent_bits) - 1){
+    return SCIL_PRECISION_ERR;
+  }
+  if(minimum < ldexp(1.0, bits - bias - mantissa_bits)){
+    return SCIL_PRECISION_ERR;
+  }
+  if(ctx->hints.fill_value < DBL_MAX){
+    // the fill value must survive the conversion exactly
+    const <DATATYPE> fill_value = (<DATATYPE>) ctx->hints.fill_value;
+    const int64_t fill = round_to_format(fill_value, exponent_bits, mantissa_bits);
+    <DATATYPE> restored;
+    if(exponent_bits == HALF_EXPONENT_BITS){
+      decode_half_<DATATYPE>(& restored, & fill, 1);
+    }else{
+      decode_bfloat16_<DATATYPE>(& restored, & fill, 1);
+    }
+    if(! (restored <= fill_value && restored >= fill_value)){
+      return SCIL_FILL_VAL_ERR;
+    }
+  }
+  return SCIL_NO_ERR;
+}
+
+int scil_half_compress_<DATATYPE>(const scil_context_t* ctx,
+                               int64_t* restrict dest,
+                               size_t* restrict out_size,
+                               <DATATYPE>* restrict source,
+                               const scil_dims_t* dims){
+  const size_t count = scil_dims_get_count(dims);
+  int ret = check_format_<DATATYPE>(ctx, source, count, HALF_EXPONENT_BITS, HALF_MANTISSA_BITS);
+  if(ret != SCIL_NO_ERR){
+    return ret;
+  }
+  const int threads = ctx->hints.thread_count;
+  #pragma omp parallel for num_threads(threads) if(threads > 1)
+  for(size_t b=0; b < count; b += BLOCK_SIZE){
+    encode_half_<DATATYPE>(dest + b, source + b, count - b < BLOCK_SIZE ? count - b : BLOCK_SIZE);
+  }
+  *out_size = count * sizeof(int64_t);
+  return SCIL_NO_ERR;
+}
+
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+int scil_half_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                 scil_dims_t* dims,
+                                 int64_t* restrict source,
+                                 const size_t in_size){
+  const size_t count = scil_dims_get_count(dims);
+  #pragma omp parallel for
+  for(size_t b=0; b < count; b += BLOCK_SIZE){
+    decode_half_<DATATYPE>(dest + b, source + b, count - b < BLOCK_SIZE ? count - b : BLOCK_SIZE);
+  }
+  return SCIL_NO_ERR;
+}
+
+int scil_bfloat16_compress_<DATATYPE>(const scil_context_t* ctx,
+                                   int64_t* restrict dest,
+                                   size_t* restrict out_size,
+                                   <DATATYPE>* restrict source,
+                                   const scil_dims_t* dims){
+  const size_t count = scil_dims_get_count(dims);
+  int ret = check_format_<DATATYPE>(ctx, source, count, BFLOAT16_EXPONENT_BITS, BFLOAT16_MANTISSA_BITS);
+  if(ret != SCIL_NO_ERR){
+    return ret;
+  }
+  const int threads = ctx->hints.thread_count;
+  #pragma omp parallel for num_threads(threads) if(threads > 1)
+  for(size_t b=0; b < count; b += BLOCK_SIZE){
+    encode_bfloat16_<DATATYPE>(dest + b, source + b, count - b < BLOCK_SIZE ? count - b : BLOCK_SIZE);
+  }
+  *out_size = count * sizeof(int64_t);
+  return SCIL_NO_ERR;
+}
+
+int scil_bfloat16_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                     scil_dims_t* dims,
+                                     int64_t* restrict source,
+                                     const size_t in_size){
+  const size_t count = scil_dims_get_count(dims);
+  #pragma omp parallel for
+  for(size_t b=0; b < count; b += BLOCK_SIZE){
+    decode_bfloat16_<DATATYPE>(dest + b, source + b, count - b < BLOCK_SIZE ? count - b : BLOCK_SIZE);
+  }
+  return SCIL_NO_ERR;
+}
+// End repeat
+
+scilU_algorithm_t algo_half = {
+    .c.Ctype = {
+        CREATE_INITIALIZER(scil_half)
+    },
+    "half",
+    38,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_CONVERTER,
+    1
+};
+
+scilU_algorithm_t algo_bfloat16 = {
+    .c.Ctype = {
+        CREATE_INITIALIZER(scil_bfloat16)
+    },
+    "bfloat16",
+    39,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_CONVERTER,
+    1
+};
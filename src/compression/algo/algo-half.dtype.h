@@ -0,0 +1,61 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_HALF_H_
+#define SCIL_HALF_H_
+
+/**
+ * \file
+ * \brief Converters of float and double to IEEE half precision and bfloat16.
+ *
+ * The values are rounded to nearest even, including subnormals, infinities and NaNs are preserved.
+ * The result fits into 16 bits, thus it is stored with two bytes per value unless a byte compressor of 64-bit words follows.
+ * Compression fails with SCIL_PRECISION_ERR if the significant bits requested exceed the format
+ * (11 for half, 8 for bfloat16), if a finite value overflows or if a subnormal result holds too few bits.
+ * F16C converts between float and half if the processor supports it, the scalar code gives the same results.
+ */
+
+#include <scil-algorithm-impl.h>
+
+//Repeat for each data type
+//Supported datatypes:double float
+
+int scil_half_compress_<DATATYPE>(const scil_context_t* ctx,
+                               int64_t* restrict dest,
+                               size_t* restrict out_size,
+                               <DATATYPE>* restrict source,
+                               const scil_dims_t* dims);
+
+int scil_half_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                 scil_dims_t* dims,
+                                 int64_t* restrict source,
+                                 const size_t in_size);
+
+int scil_bfloat16_compress_<DATATYPE>(const scil_context_t* ctx,
+                                   int64_t* restrict dest,
+                                   size_t* restrict out_size,
+                                   <DATATYPE>* restrict source,
+                                   const scil_dims_t* dims);
+
+int scil_bfloat16_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                     scil_dims_t* dims,
+                                     int64_t* restrict source,
+                                     const size_t in_size);
+// End repeat
+
+extern scilU_algorithm_t algo_half;
+extern scilU_algorithm_t algo_bfloat16;
+
+#endif /* SCIL_HALF_H_ */
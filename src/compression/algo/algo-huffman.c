@@ -0,0 +1,361 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-huffman.h>
+#include <algo/huffman.h>
+
+#include <scil-util.h>
+#include <scil-entropy.h>
+
+#include <string.h>
+
+/*
+ * Layout: mode (1 byte), for MODE_STORED the input follows.
+ * MODE_HUFFMAN: input size (8 bytes), alphabet size (2 bytes), code lengths (4 bits each),
+ * byte size of each stream (4 bytes each), the streams, the input bytes after the last full word.
+ */
+#define MODE_STORED 0
+#define MODE_HUFFMAN 1
+
+#define STREAMS 4
+#define MAX_CODE_LENGTH 12
+#define TABLE_SIZE (1 << MAX_CODE_LENGTH)
+
+// the encoder writes up to 32 bits at once
+#define MAX_WRITE_BITS 32
+
+typedef struct{
+  uint16_t symbol[2];
+  // the length of the first code and of all codes
+  uint8_t length;
+  uint8_t bits;
+  uint8_t count;
+} table_entry_t;
+
+typedef struct{
+  uint64_t buffer;
+  int bits;
+  byte* out;
+} bit_writer_t;
+
+typedef struct{
+  // the next bits are left aligned
+  uint64_t buffer;
+  int bits;
+  const byte* in;
+  const byte* end;
+  // the next word and the number of words left
+  size_t word;
+  size_t left;
+} bit_reader_t;
+
+static inline void write_bits(bit_writer_t* w, uint64_t value, int count){
+  w->buffer = (w->buffer << count) | value;
+  w->bits += count;
+  while(w->bits >= 8){
+    w->bits -= 8;
+    *w->out++ = (byte) (w->buffer >> w->bits);
+  }
+}
+
+static inline void write_long(bit_writer_t* w, uint64_t value, int count){
+  value &= ((uint64_t) 1 << count) - 1;
+  if(count > MAX_WRITE_BITS){
+    write_bits(w, value >> MAX_WRITE_BITS, count - MAX_WRITE_BITS);
+    count = MAX_WRITE_BITS;
+  }
+  write_bits(w, value & (((uint64_t) 1 << count) - 1), count);
+}
+
+static inline void flush_bits(bit_writer_t* w){
+  if(w->bits > 0){
+    *w->out++ = (byte) (w->buffer << (8 - w->bits));
+    w->bits = 0;
+  }
+}
+
+// afterwards at least 57 bits are available unless the stream ends
+static inline void refill(bit_reader_t* r){
+  if(r->end - r->in >= 8){
+    r->buffer |= __builtin_bswap64(scil_entropy_load_word(r->in)) >> r->bits;
+    r->in += (63 - r->bits) >> 3;
+    r->bits |= 56;
+  }else{
+    while(r->bits <= 56 && r->in < r->end){
+      r->buffer |= (uint64_t) *r->in++ << (56 - r->bits);
+      r->bits += 8;
+    }
+  }
+}
+
+static inline void consume(bit_reader_t* r, int count){
+  r->buffer <<= count;
+  r->bits -= count;
+}
+
+// reads up to 32 bits, there must be enough bits in the buffer
+static inline uint64_t read_bits(bit_reader_t* r, int count){
+  if(count == 0){
+    return 0;
+  }
+  uint64_t value = r->buffer >> (64 - count);
+  consume(r, count);
+  return value;
+}
+
+static inline uint64_t read_long(bit_reader_t* r, int count){
+  uint64_t value = 0;
+  if(count > MAX_WRITE_BITS){
+    refill(r);
+    value = read_bits(r, count - MAX_WRITE_BITS) << MAX_WRITE_BITS;
+    count = MAX_WRITE_BITS;
+  }
+  refill(r);
+  return value | read_bits(r, count);
+}
+
+/*
+ * Decodes the next entry of the stream, that is a single or two words.
+ * Words of a stream are STREAMS words apart.
+ */
+static inline void decode_step(bit_reader_t* r, const table_entry_t* table, byte* out){
+  refill(r);
+  const table_entry_t e = table[r->buffer >> (64 - MAX_CODE_LENGTH)];
+  if(e.count == 2 && r->left >= 2){
+    scil_entropy_store_word(out + 8 * r->word, scil_entropy_unzigzag(e.symbol[0]));
+    scil_entropy_store_word(out + 8 * (r->word + STREAMS), scil_entropy_unzigzag(e.symbol[1]));
+    consume(r, e.bits);
+    r->word += 2 * STREAMS;
+    r->left -= 2;
+    return;
+  }
+  consume(r, e.length);
+  uint64_t z = e.symbol[0];
+  if(z >= SCIL_ENTROPY_DIRECT_SYMBOLS){
+    const int extra = scil_entropy_extra_bits(e.symbol[0]);
+    z = ((uint64_t) 1 << extra) | read_long(r, extra);
+  }
+  scil_entropy_store_word(out + 8 * r->word, scil_entropy_unzigzag(z));
+  r->word += STREAMS;
+  r->left--;
+}
+
+static void build_table(table_entry_t* table, const uint8_t* lengths, const uint32_t* codes, const int alphabet){
+  for(int s=0; s < alphabet; s++){
+    if(lengths[s] == 0){
+      continue;
+    }
+    const int shift = MAX_CODE_LENGTH - lengths[s];
+    const uint32_t first = codes[s] << shift;
+    for(uint32_t i = first; i < first + (1u << shift); i++){
+      table[i].symbol[0] = (uint16_t) s;
+      table[i].length = lengths[s];
+      table[i].bits = lengths[s];
+      table[i].count = 1;
+    }
+  }
+  // append a second symbol, if its code is fully contained in the remaining bits of the index
+  for(uint32_t i=0; i < TABLE_SIZE; i++){
+    if(table[i].symbol[0] >= SCIL_ENTROPY_DIRECT_SYMBOLS){
+      continue;
+    }
+    const table_entry_t* next = & table[(i << table[i].length) & (TABLE_SIZE - 1)];
+    if(next->symbol[0] < SCIL_ENTROPY_DIRECT_SYMBOLS && table[i].length + next->length <= MAX_CODE_LENGTH){
+      table[i].symbol[1] = next->symbol[0];
+      table[i].bits = (uint8_t) (table[i].length + next->length);
+      table[i].count = 2;
+    }
+  }
+}
+
+static int compress_stored(byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
+  dest[0] = MODE_STORED;
+  memcpy(dest + 1, source, source_size);
+  *out_size = source_size + 1;
+  return SCIL_NO_ERR;
+}
+
+int scil_huffman_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
+  const size_t words = source_size / 8;
+  const size_t remainder = source_size % 8;
+  if(words == 0){
+    return compress_stored(dest, out_size, source, source_size);
+  }
+
+  uint16_t* symbols = (uint16_t*) scilU_safe_malloc(words * sizeof(uint16_t));
+  uint64_t counts[SCIL_ENTROPY_ALPHABET_SIZE] = {0};
+  const int alphabet = scil_entropy_symbolize(symbols, counts, source, words);
+
+  uint8_t lengths[SCIL_ENTROPY_ALPHABET_SIZE];
+  uint32_t codes[SCIL_ENTROPY_ALPHABET_SIZE];
+  huffman_code_lengths(counts, alphabet, MAX_CODE_LENGTH, lengths);
+  huffman_canonical_codes(lengths, alphabet, codes);
+
+  // the exact size of each stream
+  uint64_t stream_bits[STREAMS] = {0};
+  for(size_t i=0; i < words; i++){
+    stream_bits[i % STREAMS] += lengths[symbols[i]] + scil_entropy_extra_bits(symbols[i]);
+  }
+
+  size_t header_size = 1 + 8 + 2 + (alphabet + 1) / 2 + 4 * STREAMS;
+  size_t stream_offset[STREAMS + 1];
+  stream_offset[0] = header_size;
+  for(int k=0; k < STREAMS; k++){
+    stream_offset[k + 1] = stream_offset[k] + (stream_bits[k] + 7) / 8;
+  }
+  const size_t total = stream_offset[STREAMS] + remainder;
+  if(total >= source_size + 1){
+    free(symbols);
+    return compress_stored(dest, out_size, source, source_size);
+  }
+
+  byte* p = dest;
+  *p++ = MODE_HUFFMAN;
+  uint64_t size = source_size;
+  scilU_pack8((p), size);
+  p += 8;
+  *p++ = (byte) (alphabet & 0xFF);
+  *p++ = (byte) (alphabet >> 8);
+  for(int s=0; s < alphabet; s += 2){
+    *p++ = (byte) (lengths[s] | (s + 1 < alphabet ? lengths[s + 1] << 4 : 0));
+  }
+  for(int k=0; k < STREAMS; k++){
+    uint32_t bytes = (uint32_t) (stream_offset[k + 1] - stream_offset[k]);
+    scilU_pack4((p), bytes);
+    p += 4;
+  }
+
+  const int threads = ctx != NULL && ctx->hints.thread_count > 1 ? (ctx->hints.thread_count < STREAMS ? ctx->hints.thread_count : STREAMS) : 1;
+  #pragma omp parallel for num_threads(threads) if(threads > 1)
+  for(int k=0; k < STREAMS; k++){
+    bit_writer_t w = {0, 0, dest + stream_offset[k]};
+    for(size_t i=k; i < words; i += STREAMS){
+      const uint16_t s = symbols[i];
+      write_bits(& w, codes[s], lengths[s]);
+      if(s >= SCIL_ENTROPY_DIRECT_SYMBOLS){
+        const int extra = scil_entropy_extra_bits(s);
+        write_long(& w, scil_entropy_zigzag(scil_entropy_load_word(source + 8 * i)), extra);
+      }
+    }
+    flush_bits(& w);
+  }
+  memcpy(dest + stream_offset[STREAMS], source + 8 * words, remainder);
+  *out_size = total;
+
+  free(symbols);
+  return SCIL_NO_ERR;
+}
+
+int scil_huffman_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out){
+  if(in_size < 1){
+    return SCIL_BUFFER_ERR;
+  }
+  if(src[0] == MODE_STORED){
+    if(in_size - 1 > buff_size){
+      return SCIL_BUFFER_ERR;
+    }
+    memcpy(dest, src + 1, in_size - 1);
+    *uncomp_size_out = in_size - 1;
+    return SCIL_NO_ERR;
+  }
+  if(src[0] != MODE_HUFFMAN || in_size < 1 + 8 + 2){
+    return SCIL_BUFFER_ERR;
+  }
+
+  const byte* p = src + 1;
+  uint64_t size;
+  scilU_unpack8(p, & size);
+  p += 8;
+  const int alphabet = p[0] | (p[1] << 8);
+  p += 2;
+  if(size > buff_size || alphabet < 1 || alphabet > SCIL_ENTROPY_ALPHABET_SIZE){
+    return SCIL_BUFFER_ERR;
+  }
+  const size_t words = size / 8;
+  const size_t remainder = size % 8;
+  if((size_t) (p - src) + (alphabet + 1) / 2 + 4 * STREAMS > in_size){
+    return SCIL_BUFFER_ERR;
+  }
+
+  uint8_t lengths[SCIL_ENTROPY_ALPHABET_SIZE];
+  uint32_t codes[SCIL_ENTROPY_ALPHABET_SIZE];
+  uint64_t kraft = 0;
+  for(int s=0; s < alphabet; s++){
+    lengths[s] = (p[s / 2] >> (4 * (s % 2))) & 0xF;
+    if(lengths[s] > MAX_CODE_LENGTH){
+      return SCIL_BUFFER_ERR;
+    }
+    if(lengths[s] > 0){
+      kraft += (uint64_t) 1 << (MAX_CODE_LENGTH - lengths[s]);
+    }
+  }
+  p += (alphabet + 1) / 2;
+  if(kraft > TABLE_SIZE){
+    return SCIL_BUFFER_ERR;
+  }
+  huffman_canonical_codes(lengths, alphabet, codes);
+
+  bit_reader_t r[STREAMS];
+  const byte* stream = p + 4 * STREAMS;
+  for(int k=0; k < STREAMS; k++){
+    uint32_t bytes;
+    scilU_unpack4((p + 4 * k), & bytes);
+    r[k].buffer = 0;
+    r[k].bits = 0;
+    r[k].in = stream;
+    r[k].end = stream + bytes;
+    r[k].word = k;
+    r[k].left = words > (size_t) k ? (words - k + STREAMS - 1) / STREAMS : 0;
+    stream += bytes;
+  }
+  if((size_t) (stream - src) + remainder != in_size){
+    return SCIL_BUFFER_ERR;
+  }
+
+  // an incomplete code leaves entries without symbol, they decode to zero
+  table_entry_t* table = (table_entry_t*) scilU_safe_malloc(TABLE_SIZE * sizeof(table_entry_t));
+  memset(table, 0, TABLE_SIZE * sizeof(table_entry_t));
+  build_table(table, lengths, codes, alphabet);
+
+  // the streams are independent, interleaving them hides the latency of the table lookups
+  while(r[0].left >= 2 && r[1].left >= 2 && r[2].left >= 2 && r[3].left >= 2){
+    decode_step(& r[0], table, dest);
+    decode_step(& r[1], table, dest);
+    decode_step(& r[2], table, dest);
+    decode_step(& r[3], table, dest);
+  }
+  for(int k=0; k < STREAMS; k++){
+    while(r[k].left > 0){
+      decode_step(& r[k], table, dest);
+    }
+  }
+  free(table);
+
+  memcpy(dest + 8 * words, stream, remainder);
+  *uncomp_size_out = size;
+  return SCIL_NO_ERR;
+}
+
+scilU_algorithm_t algo_huffman = {
+    .c.Btype = {
+        scil_huffman_compress,
+        scil_huffman_decompress
+    },
+    "huffman",
+    25,
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES,
+    0,
+    1
+};
@@ -0,0 +1,38 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_ALGO_HUFFMAN_H_
+#define SCIL_ALGO_HUFFMAN_H_
+
+/**
+ * \file
+ * \brief Entropy coder for the int64 output of converters such as quantize.
+ *
+ * The input is read as 64-bit words, i.e., the integers of the converter, that are mapped with zigzag coding.
+ * Small values are Huffman symbols of their own, larger ones are coded by their bit length followed by the raw bits.
+ * The canonical code is limited to 12 bits, so a table with 4096 entries decodes up to two symbols per lookup.
+ * Words are distributed round robin to four bitstreams that are decoded in an interleaved fashion.
+ * If the input does not compress, it is stored as is.
+ */
+
+#include <scil-algorithm-impl.h>
+
+int scil_huffman_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size);
+
+int scil_huffman_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out);
+
+extern scilU_algorithm_t algo_huffman;
+
+#endif
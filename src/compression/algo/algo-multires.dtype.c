@@ -0,0 +1,457 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-multires.h>
+
+#include <scil-bitpack.h>
+#include <scil-entropy.h>
+#include <scil-util.h>
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+/*
+ * Layout: the number of levels L (1 byte), the quantization step (8 bytes), the end of each of the L + 1 levels
+ * relative to the end of the header (8 bytes each), the levels from the coarsest to the finest.
+ * A level stores the bits of its largest code (1 byte) and the PFOR stream of the zigzag coded quantized errors.
+ *
+ * Level 0 holds the points whose indices are multiples of 2^L, each is predicted by its predecessor.
+ * Level l adds the points of the grid with the stride s = 2^(L - l) that are not on the grid of level l - 1.
+ * Such a point is predicted by the mean of the 2^k points at +-s in the k dimensions in which its index is
+ * an odd multiple of s, they belong to the coarser levels. Thus, the points of a level are independent.
+ * They are processed in slabs of the highest dimension, each slab contributes a known number of points.
+ */
+#define MAX_LEVELS 8
+
+#define EPSILON_FLOAT FLT_EPSILON
+#define EPSILON_DOUBLE DBL_EPSILON
+
+#define HEADER_SIZE(levels) (9 + 8 * ((size_t) (levels) + 1))
+
+// every unit-th point of a field in each dimension, dimension 0 is contiguous
+typedef struct{
+  int dims;
+  size_t length[SCIL_DIMS_MAX];
+  size_t unit;
+  size_t stride[SCIL_DIMS_MAX];
+} grid_t;
+
+static size_t get_points(size_t length, size_t stride){
+  return (length - 1) / stride + 1;
+}
+
+static void grid_initialize(grid_t* g, const scil_dims_t* dims, size_t unit){
+  g->dims = dims->dims;
+  g->unit = unit;
+  size_t stride = 1;
+  for(int d=0; d < dims->dims; d++){
+    g->length[d] = dims->length[d];
+    g->stride[d] = stride;
+    stride *= get_points(dims->length[d], unit);
+  }
+}
+
+static size_t get_position(const grid_t* g, const size_t* x){
+  size_t pos = 0;
+  for(int d=0; d < g->dims; d++){
+    pos += x[d] / g->unit * g->stride[d];
+  }
+  return pos;
+}
+
+// the number of points with the given stride in the dimensions below dim
+static size_t get_count_below(const grid_t* g, int dim, size_t stride){
+  size_t count = 1;
+  for(int d=0; d < dim; d++){
+    count *= get_points(g->length[d], stride);
+  }
+  return count;
+}
+
+// moves x to the next point with the given stride in the dimensions below dim, returns 0 after the last point
+static int next_point(size_t* x, const grid_t* g, int dim, size_t stride){
+  for(int d=0; d < dim; d++){
+    x[d] += stride;
+    if(x[d] < g->length[d]){
+      return 1;
+    }
+    x[d] = 0;
+  }
+  return 0;
+}
+
+static int is_new_point(const size_t* x, int dims, size_t stride){
+  for(int d=0; d < dims; d++){
+    if((x[d] / stride) & 1){
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// the first point of each slab of the level with the given stride in the code array, offsets has slabs + 1 entries
+static void get_slab_offsets(size_t* offsets, const grid_t* g, size_t stride, size_t slabs){
+  const int top = g->dims - 1;
+  const size_t all = get_count_below(g, top, stride);
+  const size_t coarse = get_count_below(g, top, 2 * stride);
+  offsets[0] = 0;
+  for(size_t c=0; c < slabs; c++){
+    offsets[c + 1] = offsets[c] + ((c & 1) ? all : all - coarse);
+  }
+}
+
+// the number of points added by the level with the given stride
+static size_t get_new_points(const grid_t* g, size_t stride){
+  return get_count_below(g, g->dims, stride) - get_count_below(g, g->dims, 2 * stride);
+}
+
+static int get_level_count(const scil_dims_t* dims){
+  size_t longest = 1;
+  for(int d=0; d < dims->dims; d++){
+    if(dims->length[d] > longest){
+      longest = dims->length[d];
+    }
+  }
+  // the coarsest level keeps at least two points of the longest dimension
+  int levels = 0;
+  while(levels < MAX_LEVELS && ((size_t) 2 << levels) < longest){
+    levels++;
+  }
+  return levels;
+}
+
+void scil_multires_preview_dims(scil_dims_t* out_dims, const scil_dims_t* dims, int reduction){
+  const size_t stride = (size_t) 1 << (reduction < 62 ? reduction : 62);
+  scil_dims_copy(out_dims, dims);
+  for(int d=0; d < dims->dims; d++){
+    out_dims->length[d] = get_points(dims->length[d], stride);
+  }
+}
+
+static int read_header(const byte* source, size_t source_size, int* levels, double* step, uint64_t* ends){
+  if(source_size < HEADER_SIZE(0)){
+    return SCIL_BUFFER_ERR;
+  }
+  *levels = source[0];
+  if(*levels > MAX_LEVELS || source_size < HEADER_SIZE(*levels)){
+    return SCIL_BUFFER_ERR;
+  }
+  scilU_unpack8((source + 1), step);
+  for(int l=0; l <= *levels; l++){
+    scilU_unpack8((source + 9 + 8 * l), & ends[l]);
+    if(ends[l] < (l > 0 ? ends[l - 1] : 0) + 1){
+      return SCIL_BUFFER_ERR;
+    }
+  }
+  return SCIL_NO_ERR;
+}
+
+static int unpack_level(uint64_t* restrict codes, size_t count, const byte* restrict source, size_t source_size){
+  const int max_bits = source[0];
+  size_t parsed;
+  if(max_bits > 64 || scil_pfor_decompress(codes, count, max_bits, source + 1, source_size - 1, & parsed) != SCIL_NO_ERR){
+    return SCIL_BUFFER_ERR;
+  }
+  return SCIL_NO_ERR;
+}
+
+static size_t pack_level(byte* restrict dest, const uint64_t* restrict codes, size_t count){
+  uint64_t all = 0;
+  for(size_t i=0; i < count; i++){
+    all |= codes[i];
+  }
+  const int max_bits = scil_bits_needed(all);
+  dest[0] = (byte) max_bits;
+  return 1 + scil_pfor_compress(dest + 1, codes, count, max_bits);
+}
+
+//Repeat for each data type
+//Supported datatypes: float double
+
+static double predict_<DATATYPE>(const <DATATYPE>* restrict buf, const grid_t* g, const size_t* x, size_t stride){
+  size_t base = 0;
+  size_t offsets[SCIL_DIMS_MAX];
+  int k = 0;
+  for(int d=0; d < g->dims; d++){
+    if((x[d] / stride) & 1){
+      base += (x[d] - stride) / g->unit * g->stride[d];
+      // at the upper boundary only the lower neighbour exists
+      offsets[k++] = x[d] + stride < g->length[d] ? 2 * stride / g->unit * g->stride[d] : 0;
+    }else{
+      base += x[d] / g->unit * g->stride[d];
+    }
+  }
+  double sum = 0;
+  for(int m=0; m < 1 << k; m++){
+    size_t pos = base;
+    for(int j=0; j < k; j++){
+      if((m >> j) & 1){
+        pos += offsets[j];
+      }
+    }
+    sum += (double) buf[pos];
+  }
+  return sum / (1 << k);
+}
+
+static <DATATYPE> reconstruct_<DATATYPE>(double prediction, uint64_t code, double step){
+  return (<DATATYPE>) (prediction + (double) (int64_t) scil_entropy_unzigzag(code) * step);
+}
+
+// replaces the value by its reconstruction, returns 0 if the tolerance cannot be kept
+static int quantize_<DATATYPE>(uint64_t* restrict code, <DATATYPE>* restrict value, double prediction, double step, double tolerance){
+  const double q = round(((double) *value - prediction) / step);
+  if(! (fabs(q) < 0x1p52)){
+    return 0;
+  }
+  *code = scil_entropy_zigzag((uint64_t) (int64_t) q);
+  const <DATATYPE> reconstructed = reconstruct_<DATATYPE>(prediction, *code, step);
+  if(! (fabs((double) reconstructed - (double) *value) <= tolerance)){
+    return 0;
+  }
+  *value = reconstructed;
+  return 1;
+}
+
+// returns 0 if the tolerance cannot be kept
+static int encode_level_<DATATYPE>(uint64_t* restrict codes, <DATATYPE>* restrict buf, const grid_t* g, size_t stride, double step, double tolerance, int threads){
+  const int top = g->dims - 1;
+  const size_t slabs = get_points(g->length[top], stride);
+  size_t* offsets = (size_t*) scilU_safe_malloc((slabs + 1) * sizeof(size_t));
+  get_slab_offsets(offsets, g, stride, slabs);
+  int ok = 1;
+
+  #pragma omp parallel for num_threads(threads) if(threads > 1 && slabs > 1) reduction(&: ok)
+  for(size_t c=0; c < slabs; c++){
+    size_t x[SCIL_DIMS_MAX] = {0};
+    x[top] = c * stride;
+    size_t j = offsets[c];
+    do{
+      if(is_new_point(x, g->dims, stride)){
+        const double prediction = predict_<DATATYPE>(buf, g, x, stride);
+        ok &= quantize_<DATATYPE>(& codes[j], & buf[get_position(g, x)], prediction, step, tolerance);
+        j++;
+      }
+    }while(next_point(x, g, top, stride));
+  }
+  free(offsets);
+  return ok;
+}
+
+static void decode_level_<DATATYPE>(<DATATYPE>* restrict buf, const uint64_t* restrict codes, const grid_t* g, size_t stride, double step){
+  const int top = g->dims - 1;
+  const size_t slabs = get_points(g->length[top], stride);
+  size_t* offsets = (size_t*) scilU_safe_malloc((slabs + 1) * sizeof(size_t));
+  get_slab_offsets(offsets, g, stride, slabs);
+
+  #pragma omp parallel for if(slabs > 1)
+  for(size_t c=0; c < slabs; c++){
+    size_t x[SCIL_DIMS_MAX] = {0};
+    x[top] = c * stride;
+    size_t j = offsets[c];
+    do{
+      if(is_new_point(x, g->dims, stride)){
+        const double prediction = predict_<DATATYPE>(buf, g, x, stride);
+        buf[get_position(g, x)] = reconstruct_<DATATYPE>(prediction, codes[j], step);
+        j++;
+      }
+    }while(next_point(x, g, top, stride));
+  }
+  free(offsets);
+}
+
+// decodes the levels up to last into buf, a grid with the stride of this level
+static int decode_levels_<DATATYPE>(<DATATYPE>* restrict buf, const grid_t* g, const byte* restrict source, size_t source_size, int last){
+  int levels;
+  double step;
+  uint64_t ends[MAX_LEVELS + 1];
+  int ret = read_header(source, source_size, & levels, & step, ends);
+  if(ret != SCIL_NO_ERR){
+    return ret;
+  }
+  const size_t header = HEADER_SIZE(levels);
+  // only the levels decoded must be present
+  if(source_size - header < ends[last]){
+    return SCIL_BUFFER_ERR;
+  }
+  source += header;
+
+  const size_t coarsest = (size_t) 1 << levels;
+  const size_t count = get_count_below(g, g->dims, coarsest);
+  uint64_t* codes = (uint64_t*) scilU_safe_malloc(get_count_below(g, g->dims, g->unit) * sizeof(uint64_t));
+  ret = unpack_level(codes, count, source, ends[0]);
+  if(ret == SCIL_NO_ERR){
+    size_t x[SCIL_DIMS_MAX] = {0};
+    double prediction = 0;
+    size_t j = 0;
+    do{
+      const size_t pos = get_position(g, x);
+      buf[pos] = reconstruct_<DATATYPE>(prediction, codes[j++], step);
+      prediction = buf[pos];
+    }while(next_point(x, g, g->dims, coarsest));
+  }
+
+  for(int l=1; l <= last && ret == SCIL_NO_ERR; l++){
+    const size_t stride = coarsest >> l;
+    ret = unpack_level(codes, get_new_points(g, stride), source + ends[l - 1], ends[l] - ends[l - 1]);
+    if(ret == SCIL_NO_ERR){
+      decode_level_<DATATYPE>(buf, codes, g, stride, step);
+    }
+  }
+  free(codes);
+  return ret;
+}
+
+int scil_multires_compress_<DATATYPE>(const scil_context_t* ctx,
+                                   byte* restrict dest,
+                                   size_t* restrict dest_size,
+                                   <DATATYPE>* restrict source,
+                                   const scil_dims_t* dims){
+  assert(dest != NULL);
+  assert(dest_size != NULL);
+  assert(source != NULL);
+  assert(dims != NULL);
+
+  const double tolerance = ctx->hints.absolute_tolerance;
+  const size_t count = scil_dims_get_count(dims);
+  if(tolerance <= SCIL_ACCURACY_DBL_IGNORE || count == 0){
+    return SCIL_PRECISION_ERR;
+  }
+  // the step leaves room for the rounding of the reconstruction of the largest values
+  double largest = 0;
+  for(size_t i=0; i < count; i++){
+    if(fabs((double) source[i]) > largest){
+      largest = fabs((double) source[i]);
+    }
+  }
+  const double step = 2 * (tolerance - 2 * largest * (double) EPSILON_<DATATYPE_UPPER>);
+  if(! (step > 0)){
+    return SCIL_PRECISION_ERR;
+  }
+  const int levels = get_level_count(dims);
+  const size_t coarsest = (size_t) 1 << levels;
+  grid_t g;
+  grid_initialize(& g, dims, 1);
+
+  // the values are replaced by their reconstruction, the finer levels are predicted from them
+  <DATATYPE>* buf = (<DATATYPE>*) scilU_safe_malloc(count * sizeof(<DATATYPE>));
+  memcpy(buf, source, count * sizeof(<DATATYPE>));
+  uint64_t* codes = (uint64_t*) scilU_safe_malloc(count * sizeof(uint64_t));
+  uint64_t ends[MAX_LEVELS + 1];
+  const size_t header = HEADER_SIZE(levels);
+  byte* out = dest + header;
+  int ret = SCIL_NO_ERR;
+
+  size_t x[SCIL_DIMS_MAX] = {0};
+  double prediction = 0;
+  size_t j = 0;
+  do{
+    const size_t pos = get_position(& g, x);
+    if(! quantize_<DATATYPE>(& codes[j++], & buf[pos], prediction, step, tolerance)){
+      ret = SCIL_PRECISION_ERR;
+      break;
+    }
+    prediction = buf[pos];
+  }while(next_point(x, & g, g.dims, coarsest));
+  size_t size = ret == SCIL_NO_ERR ? pack_level(out, codes, j) : 0;
+  ends[0] = size;
+
+  for(int l=1; l <= levels && ret == SCIL_NO_ERR; l++){
+    const size_t stride = coarsest >> l;
+    if(! encode_level_<DATATYPE>(codes, buf, & g, stride, step, tolerance, ctx->hints.thread_count)){
+      ret = SCIL_PRECISION_ERR;
+      break;
+    }
+    size += pack_level(out + size, codes, get_new_points(& g, stride));
+    ends[l] = size;
+  }
+  free(codes);
+  free(buf);
+  if(ret != SCIL_NO_ERR){
+    return ret;
+  }
+
+  dest[0] = (byte) levels;
+  scilU_pack8((dest + 1), step);
+  for(int l=0; l <= levels; l++){
+    scilU_pack8((dest + 9 + 8 * l), ends[l]);
+  }
+  *dest_size = header + size;
+  return SCIL_NO_ERR;
+}
+
+int scil_multires_decompress_preview_<DATATYPE>(<DATATYPE>* restrict dest,
+                                             scil_dims_t* dims,
+                                             byte* restrict source,
+                                             size_t source_size,
+                                             int reduction){
+  assert(dest != NULL);
+  assert(source != NULL);
+  assert(dims != NULL);
+
+  if(reduction < 0){
+    return SCIL_EINVAL;
+  }
+  if(source_size < 1 || source[0] > MAX_LEVELS){
+    return SCIL_BUFFER_ERR;
+  }
+  const int levels = source[0];
+  if(reduction <= levels){
+    // the grid of the last level read is the preview
+    grid_t g;
+    grid_initialize(& g, dims, (size_t) 1 << reduction);
+    return decode_levels_<DATATYPE>(dest, & g, source, source_size, levels - reduction);
+  }
+
+  // coarser than the coarsest level, it is decimated further
+  grid_t g;
+  grid_initialize(& g, dims, (size_t) 1 << levels);
+  <DATATYPE>* buf = (<DATATYPE>*) scilU_safe_malloc(get_count_below(& g, g.dims, g.unit) * sizeof(<DATATYPE>));
+  int ret = decode_levels_<DATATYPE>(buf, & g, source, source_size, 0);
+  if(ret == SCIL_NO_ERR){
+    const size_t stride = (size_t) 1 << (reduction < 62 ? reduction : 62);
+    size_t x[SCIL_DIMS_MAX] = {0};
+    size_t j = 0;
+    do{
+      dest[j++] = buf[get_position(& g, x)];
+    }while(next_point(x, & g, g.dims, stride));
+  }
+  free(buf);
+  return ret;
+}
+
+int scil_multires_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                     scil_dims_t* dims,
+                                     byte* restrict source,
+                                     size_t source_size){
+  return scil_multires_decompress_preview_<DATATYPE>(dest, dims, source, source_size, 0);
+}
+// End repeat
+
+scilU_algorithm_t algo_multires = {
+    .c.DNtype = {
+        CREATE_INITIALIZER(scil_multires)
+    },
+    "multires",
+    41,
+    SCIL_COMPRESSOR_TYPE_DATATYPES,
+    1,
+    .preview = {
+        scil_multires_decompress_preview_float,
+        scil_multires_decompress_preview_double
+    }
+};
@@ -0,0 +1,66 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_MULTIRES_H_
+#define SCIL_MULTIRES_H_
+
+/**
+ * \file
+ * \brief Multi-resolution compression with the absolute tolerance.
+ *
+ * The field is decomposed into levels of decimated grids, the coarsest level holds every 2^levels-th point
+ * in each dimension, each further level halves the stride.
+ * The points of a level are predicted by interpolating the coarser levels, the prediction errors are quantized
+ * and coded with PFOR level by level.
+ * An index of the levels allows to decode a preview with a reduced resolution from the coarse levels only.
+ */
+
+#include <scil-algorithm-impl.h>
+
+//Repeat for each data type
+//Supported datatypes: float double
+
+int scil_multires_compress_<DATATYPE>(const scil_context_t* ctx,
+                                   byte* restrict dest,
+                                   size_t* restrict dest_size,
+                                   <DATATYPE>* restrict source,
+                                   const scil_dims_t* dims);
+
+int scil_multires_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                     scil_dims_t* dims,
+                                     byte* restrict source,
+                                     size_t source_size);
+
+/**
+ * \brief Decompresses every 2^reduction-th point in each dimension
+ * Only the header and the levels needed for this resolution are read, thus source_size may cover only these.
+ * \param dims The dimensions of the full field, dest receives the points of scil_multires_preview_dims()
+ * \param reduction The resolution is reduced by 2^reduction, 0 decodes the full field
+ */
+int scil_multires_decompress_preview_<DATATYPE>(<DATATYPE>* restrict dest,
+                                             scil_dims_t* dims,
+                                             byte* restrict source,
+                                             size_t source_size,
+                                             int reduction);
+// End repeat
+
+/**
+ * \brief The dimensions of the preview of a field, every 2^reduction-th point
+ */
+void scil_multires_preview_dims(scil_dims_t* out_dims, const scil_dims_t* dims, int reduction);
+
+extern scilU_algorithm_t algo_multires;
+
+#endif /* SCIL_MULTIRES_H_ */
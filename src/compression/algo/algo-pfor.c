@@ -0,0 +1,178 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-pfor.h>
+
+#include <scil-bitpack.h>
+#include <scil-blocks.h>
+#include <scil-entropy.h>
+#include <scil-util.h>
+
+#include <string.h>
+
+/*
+ * Layout of a block: mode (1 byte), for MODE_STORED the input follows.
+ * Otherwise: the reference (8 bytes), the width of the largest value (1 byte), the PFOR stream,
+ * the input bytes after the last full word.
+ */
+#define MODE_STORED 0
+#define MODE_REFERENCE 1
+#define MODE_ZIGZAG 2
+
+#define BLOCK_HEADER_SIZE 10
+
+static size_t compress_stored(byte* restrict dest, const byte* restrict source, size_t source_size){
+  dest[0] = MODE_STORED;
+  memcpy(dest + 1, source, source_size);
+  return source_size + 1;
+}
+
+static size_t pfor_compress_block(const scil_context_t* ctx, byte* restrict dest, size_t dest_capacity, const byte* restrict source, size_t source_size){
+  const size_t words = source_size / 8;
+  const size_t remainder = source_size % 8;
+  if(words == 0){
+    return compress_stored(dest, source, source_size);
+  }
+  uint64_t* values = (uint64_t*) scilU_safe_malloc(words * sizeof(uint64_t));
+  memcpy(values, source, words * sizeof(uint64_t));
+  uint64_t all = 0;
+  size_t negative = 0;
+  for(size_t i=0; i < words; i++){
+    all |= values[i];
+    negative += values[i] >> 63;
+  }
+
+  // a few negative words such as a trailing header are exceptions, signed residuals are zigzag coded
+  int mode;
+  uint64_t reference = 0;
+  int max_bits;
+  if(negative > words * SCIL_PFOR_REFERENCE_PERMILLE / 1000){
+    mode = MODE_ZIGZAG;
+    all = 0;
+    for(size_t i=0; i < words; i++){
+      values[i] = scil_entropy_zigzag(values[i]);
+      all |= values[i];
+    }
+    max_bits = scil_bits_needed(all);
+  }else{
+    mode = MODE_REFERENCE;
+    max_bits = scil_bits_needed(all);
+    reference = scil_pfor_reference(values, words, max_bits);
+    const uint64_t mask = max_bits == 64 ? ~(uint64_t) 0 : ((uint64_t) 1 << max_bits) - 1;
+    for(size_t i=0; i < words; i++){
+      values[i] = (values[i] - reference) & mask;
+    }
+  }
+
+  // the bound of wide values exceeds the block, such streams are written to a scratch buffer first
+  const size_t bound = scil_pfor_bound(words, max_bits);
+  byte* stream = BLOCK_HEADER_SIZE + bound + remainder <= dest_capacity ? dest + BLOCK_HEADER_SIZE : (byte*) scilU_safe_malloc(bound);
+  const size_t stream_size = scil_pfor_compress(stream, values, words, max_bits);
+  free(values);
+  const size_t total = BLOCK_HEADER_SIZE + stream_size + remainder;
+  if(total >= source_size + 1 || total > dest_capacity){
+    if(stream != dest + BLOCK_HEADER_SIZE){
+      free(stream);
+    }
+    return compress_stored(dest, source, source_size);
+  }
+  if(stream != dest + BLOCK_HEADER_SIZE){
+    memcpy(dest + BLOCK_HEADER_SIZE, stream, stream_size);
+    free(stream);
+  }
+  dest[0] = (byte) mode;
+  scilU_pack8((dest + 1), reference);
+  dest[9] = (byte) max_bits;
+  memcpy(dest + BLOCK_HEADER_SIZE + stream_size, source + 8 * words, remainder);
+  return total;
+}
+
+static int pfor_decompress_block(byte* restrict dest, size_t dest_size, const byte* restrict src, size_t src_size){
+  if(src_size < 1){
+    return SCIL_BUFFER_ERR;
+  }
+  if(src[0] == MODE_STORED){
+    if(src_size - 1 != dest_size){
+      return SCIL_BUFFER_ERR;
+    }
+    memcpy(dest, src + 1, dest_size);
+    return SCIL_NO_ERR;
+  }
+  const size_t words = dest_size / 8;
+  const size_t remainder = dest_size % 8;
+  const int mode = src[0];
+  if((mode != MODE_REFERENCE && mode != MODE_ZIGZAG) || src_size < BLOCK_HEADER_SIZE + remainder){
+    return SCIL_BUFFER_ERR;
+  }
+  uint64_t reference;
+  scilU_unpack8((src + 1), & reference);
+  const int max_bits = src[9];
+  if(max_bits > 64){
+    return SCIL_BUFFER_ERR;
+  }
+
+  uint64_t* values = (uint64_t*) scilU_safe_malloc(words * sizeof(uint64_t) + 1);
+  size_t parsed;
+  const size_t stream_size = src_size - BLOCK_HEADER_SIZE - remainder;
+  int ret = scil_pfor_decompress(values, words, max_bits, src + BLOCK_HEADER_SIZE, stream_size, & parsed);
+  if(ret != SCIL_NO_ERR || parsed != stream_size){
+    free(values);
+    return SCIL_BUFFER_ERR;
+  }
+  if(mode == MODE_ZIGZAG){
+    for(size_t i=0; i < words; i++){
+      values[i] = scil_entropy_unzigzag(values[i]);
+    }
+  }else{
+    const uint64_t mask = max_bits == 64 ? ~(uint64_t) 0 : ((uint64_t) 1 << max_bits) - 1;
+    for(size_t i=0; i < words; i++){
+      values[i] = (values[i] + reference) & mask;
+    }
+  }
+  memcpy(dest, values, words * sizeof(uint64_t));
+  free(values);
+  memcpy(dest + 8 * words, src + src_size - remainder, remainder);
+  return SCIL_NO_ERR;
+}
+
+static size_t pfor_bound(size_t source_size){
+  return source_size + 1;
+}
+
+static const scil_block_codec_t pfor_codec = {
+  pfor_compress_block,
+  pfor_decompress_block,
+  pfor_bound
+};
+
+int scil_pfor_stage_compress(const scil_context_t* ctx, byte* restrict dest, size_t* restrict out_size, const byte*restrict source, const size_t source_size){
+  return scil_blocks_compress(ctx, & pfor_codec, dest, out_size, source, source_size);
+}
+
+int scil_pfor_stage_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out){
+  return scil_blocks_decompress(& pfor_codec, dest, buff_size, src, in_size, uncomp_size_out);
+}
+
+scilU_algorithm_t algo_pfor = {
+    .c.Btype = {
+        scil_pfor_stage_compress,
+        scil_pfor_stage_decompress
+    },
+    "pfor",
+    31,
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES,
+    0,
+    1
+};
@@ -0,0 +1,36 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_ALGO_PFOR_H_
+#define SCIL_ALGO_PFOR_H_
+
+/**
+ * \file
+ * \brief Patched frame-of-reference coder for the int64 output of converters such as quantize.
+ *
+ * Each block of scil-blocks.h is bit packed with the width chosen by scil_pfor_compress(), rare outliers
+ * are stored as exceptions instead of widening all values. Non-negative words are coded relative to a low
+ * percentile, signed words such as prediction residuals with zigzag coding.
+ */
+
+#include <scil-algorithm-impl.h>
+
+int scil_pfor_stage_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size);
+
+int scil_pfor_stage_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out);
+
+extern scilU_algorithm_t algo_pfor;
+
+#endif
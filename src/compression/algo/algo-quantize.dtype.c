@@ -4,6 +4,7 @@
 
 #include <algo-quantize.h>
 #include <scil-quantizer.h>
+#include <scil-statistics.h>
 #include <scil-util.h>
 
 
@@ -18,18 +19,18 @@ int scil_quantize_compress_<DATATYPE>(const scil_context_t* ctx,
 {
     size_t count = scil_dims_get_count(dims);
 
-    <DATATYPE> minimum, maximum;
-    scilU_find_minimum_maximum_<DATATYPE>(source, count, &minimum, &maximum);
+    scilU_statistics_<DATATYPE>_t statistics;
+    scil_get_statistics_all_<DATATYPE>(ctx, source, count, & statistics);
+    const <DATATYPE> minimum = statistics.minimum;
+    const <DATATYPE> maximum = statistics.maximum;
 
     uint8_t bits_per_value = scil_calculate_bits_needed_<DATATYPE>(minimum, maximum, ctx->hints.absolute_tolerance, 0, NULL);
     if (bits_per_value > 64)
         return 1; // Quantizing would result in values bigger than UINT64_MAX
 
-    *(double*)dest = (double)minimum;
-    ++dest;
-
-    *(double*)dest = ctx->hints.absolute_tolerance;
-    ++dest;
+    // the header follows the quantized values, so that a second preconditioner can process them in place
+    *(double*)(dest + count) = (double)minimum;
+    *(double*)(dest + count + 1) = ctx->hints.absolute_tolerance;
 
     *out_size = 16;
     *out_size += count * sizeof(int64_t);
@@ -46,16 +47,40 @@ int scil_quantize_decompress_<DATATYPE>(<DATATYPE>*restrict dest,
                                         int64_t*restrict source,
                                         const size_t in_size)
 {
-    double minimum = *(double*)source;
-    ++source;
+    const size_t count = scil_dims_get_count(dims);
+    double minimum = *(double*)(source + count);
+    double abstol  = *(double*)(source + count + 1);
 
-    double abstol  = *(double*)source;
-    ++source;
+    return scil_unquantize_buffer_<DATATYPE>(dest, (uint64_t*)source, count, abstol, minimum);
+}
 
-    return scil_unquantize_buffer_<DATATYPE>(dest, (uint64_t*)source, scil_dims_get_count(dims), abstol, minimum);
+// the layout written before the header followed the values, it precedes them
+static int scil_quantize_v1_decompress_<DATATYPE>(<DATATYPE>*restrict dest,
+                                               scil_dims_t* dims,
+                                               int64_t*restrict source,
+                                               const size_t in_size)
+{
+    double minimum = *(double*)source;
+    double abstol  = *(double*)(source + 1);
+
+    return scil_unquantize_buffer_<DATATYPE>(dest, (uint64_t*)(source + 2), scil_dims_get_count(dims), abstol, minimum);
 }
 // End repeat
 
+// not registered, decodes the streams of the ID 9 written without the chain format flag
+scilU_algorithm_t algo_quantize_v1 = {
+    .c.Ctype = {
+        NULL,
+        scil_quantize_v1_decompress_float,
+        NULL,
+        scil_quantize_v1_decompress_double
+    },
+    "quantize-v1",
+    9,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_CONVERTER,
+    1
+};
+
 scilU_algorithm_t algo_quantize = {
     .c.Ctype = {
         CREATE_INITIALIZER(scil_quantize)
@@ -63,5 +88,6 @@ scilU_algorithm_t algo_quantize = {
     "quantize",
     9,
     SCIL_COMPRESSOR_TYPE_DATATYPES_CONVERTER,
-    1
+    1,
+    .legacy = & algo_quantize_v1
 };
@@ -19,5 +19,6 @@ int scil_quantize_decompress_<DATATYPE>(<DATATYPE>*restrict dest,
 // End repeat
 
 extern scilU_algorithm_t algo_quantize;
+extern scilU_algorithm_t algo_quantize_v1;
 
 #endif /* SCIL_QUANTIZE_H_<DATATYPE> */
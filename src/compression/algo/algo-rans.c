@@ -0,0 +1,315 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-rans.h>
+
+#include <scil-blocks.h>
+#include <scil-entropy.h>
+#include <scil-util.h>
+
+#include <string.h>
+
+/*
+ * The blocks of scil-blocks.h are coded independently.
+ * Layout of a block: mode (1 byte), for MODE_STORED the input follows.
+ * MODE_RANS: alphabet size (2 bytes), the frequency of each symbol (LEB128),
+ * the stream starting with the final states, the input bytes after the last full word.
+ */
+#define MODE_STORED 0
+#define MODE_RANS 1
+
+#define STATES 4
+#define PROB_BITS 14
+#define PROB_SCALE (1u << PROB_BITS)
+// the lower bound of the states, they are renormalized by 16 bits
+#define RANS_L (1u << 16)
+#define RAW_BITS 16
+
+typedef struct{
+  uint32_t freq[SCIL_ENTROPY_ALPHABET_SIZE];
+  uint32_t start[SCIL_ENTROPY_ALPHABET_SIZE];
+} rans_model_t;
+
+// scales the counts to PROB_SCALE, each used symbol keeps a frequency of at least one
+static void normalize(rans_model_t* m, const uint64_t* counts, const int alphabet, const uint64_t total){
+  int64_t sum = 0;
+  int largest = 0;
+  for(int s=0; s < alphabet; s++){
+    m->freq[s] = 0;
+    if(counts[s] > 0){
+      uint64_t f = (counts[s] * PROB_SCALE + total / 2) / total;
+      m->freq[s] = f > 0 ? (uint32_t) f : 1;
+      sum += m->freq[s];
+      if(counts[s] > counts[largest]){
+        largest = s;
+      }
+    }
+  }
+  if(sum < (int64_t) PROB_SCALE){
+    m->freq[largest] += (uint32_t) (PROB_SCALE - sum);
+  }
+  // rounding up rare symbols exceeds the scale, take from the most frequent ones
+  while(sum > (int64_t) PROB_SCALE){
+    int s_max = 0;
+    for(int s=1; s < alphabet; s++){
+      if(m->freq[s] > m->freq[s_max]){
+        s_max = s;
+      }
+    }
+    uint32_t take = m->freq[s_max] / 2;
+    if(take > sum - (int64_t) PROB_SCALE){
+      take = (uint32_t) (sum - PROB_SCALE);
+    }
+    m->freq[s_max] -= take;
+    sum -= take;
+  }
+}
+
+static void cumulate(rans_model_t* m, const int alphabet){
+  uint32_t start = 0;
+  for(int s=0; s < alphabet; s++){
+    m->start[s] = start;
+    start += m->freq[s];
+  }
+}
+
+static inline void encode_put(uint32_t* x, byte** p, uint32_t start, uint32_t freq, int scale_bits){
+  const uint64_t x_max = ((uint64_t) (RANS_L >> scale_bits) << 16) * freq;
+  if(*x >= x_max){
+    *p -= 2;
+    (*p)[0] = (byte) *x;
+    (*p)[1] = (byte) (*x >> 8);
+    *x >>= 16;
+  }
+  *x = ((*x / freq) << scale_bits) + (*x % freq) + start;
+}
+
+static inline uint32_t renormalize(uint32_t x, const byte** p, const byte* end){
+  if(x < RANS_L && *p + 2 <= end){
+    x = (x << 16) | (*p)[0] | ((uint32_t) (*p)[1] << 8);
+    *p += 2;
+  }
+  return x;
+}
+
+static inline uint32_t decode_word(uint32_t x, const byte** p, const byte* end, const uint16_t* slot_symbol, const rans_model_t* m, byte* out){
+  const uint32_t slot = x & (PROB_SCALE - 1);
+  const uint16_t s = slot_symbol[slot];
+  x = renormalize(m->freq[s] * (x >> PROB_BITS) + slot - m->start[s], p, end);
+  uint64_t z = s;
+  if(s >= SCIL_ENTROPY_DIRECT_SYMBOLS){
+    const int extra = scil_entropy_extra_bits(s);
+    z = (uint64_t) 1 << extra;
+    for(int shift=0; shift < extra; shift += RAW_BITS){
+      const int n = extra - shift < RAW_BITS ? extra - shift : RAW_BITS;
+      z |= (uint64_t) (x & ((1u << n) - 1)) << shift;
+      x = renormalize(x >> n, p, end);
+    }
+  }
+  scil_entropy_store_word(out, scil_entropy_unzigzag(z));
+  return x;
+}
+
+static size_t compress_stored(byte* restrict dest, const byte* restrict source, size_t source_size){
+  dest[0] = MODE_STORED;
+  memcpy(dest + 1, source, source_size);
+  return source_size + 1;
+}
+
+static size_t rans_compress_block(const scil_context_t* ctx, byte* restrict dest, size_t dest_capacity, const byte* restrict source, size_t source_size){
+  const size_t words = source_size / 8;
+  const size_t remainder = source_size % 8;
+  if(words == 0){
+    return compress_stored(dest, source, source_size);
+  }
+
+  uint16_t* symbols = (uint16_t*) scilU_safe_malloc(words * sizeof(uint16_t));
+  uint64_t counts[SCIL_ENTROPY_ALPHABET_SIZE] = {0};
+  const int alphabet = scil_entropy_symbolize(symbols, counts, source, words);
+  rans_model_t m;
+  normalize(& m, counts, alphabet, words);
+  cumulate(& m, alphabet);
+
+  // the stream is written backwards, a word emits at most five times 16 bits
+  const size_t capacity = 10 * words + 4 * STATES;
+  byte* buffer = (byte*) scilU_safe_malloc(capacity);
+  byte* end = buffer + capacity;
+  byte* p = end;
+  uint32_t x[STATES];
+  for(int k=0; k < STATES; k++){
+    x[k] = RANS_L;
+  }
+  for(size_t i = words; i-- > 0; ){
+    uint32_t* state = & x[i % STATES];
+    const uint16_t s = symbols[i];
+    if(s >= SCIL_ENTROPY_DIRECT_SYMBOLS){
+      const int extra = scil_entropy_extra_bits(s);
+      const uint64_t z = scil_entropy_zigzag(scil_entropy_load_word(source + 8 * i));
+      // the decoder reads the raw bits starting with the lowest ones
+      for(int shift = (extra - 1) / RAW_BITS * RAW_BITS; shift >= 0; shift -= RAW_BITS){
+        const int n = extra - shift < RAW_BITS ? extra - shift : RAW_BITS;
+        encode_put(state, & p, (uint32_t) ((z >> shift) & ((1u << n) - 1)), 1, n);
+      }
+    }
+    encode_put(state, & p, m.start[s], m.freq[s], PROB_BITS);
+  }
+  for(int k = STATES - 1; k >= 0; k--){
+    p -= 4;
+    scilU_pack4((p), x[k]);
+  }
+  free(symbols);
+
+  size_t header_size = 1 + 2;
+  byte freqs[3 * SCIL_ENTROPY_ALPHABET_SIZE];
+  size_t freqs_size = 0;
+  for(int s=0; s < alphabet; s++){
+    uint32_t f = m.freq[s];
+    while(f >= 0x80){
+      freqs[freqs_size++] = (byte) (f | 0x80);
+      f >>= 7;
+    }
+    freqs[freqs_size++] = (byte) f;
+  }
+  header_size += freqs_size;
+  const size_t stream_size = end - p;
+  const size_t total = header_size + stream_size + remainder;
+  if(total >= source_size + 1 || total > dest_capacity){
+    free(buffer);
+    return compress_stored(dest, source, source_size);
+  }
+
+  byte* out = dest;
+  *out++ = MODE_RANS;
+  *out++ = (byte) (alphabet & 0xFF);
+  *out++ = (byte) (alphabet >> 8);
+  memcpy(out, freqs, freqs_size);
+  out += freqs_size;
+  memcpy(out, p, stream_size);
+  out += stream_size;
+  memcpy(out, source + 8 * words, remainder);
+  free(buffer);
+  return total;
+}
+
+static int rans_decompress_block(byte* restrict dest, size_t dest_size, const byte* restrict src, size_t src_size){
+  if(src_size < 1){
+    return SCIL_BUFFER_ERR;
+  }
+  if(src[0] == MODE_STORED){
+    if(src_size - 1 != dest_size){
+      return SCIL_BUFFER_ERR;
+    }
+    memcpy(dest, src + 1, dest_size);
+    return SCIL_NO_ERR;
+  }
+  const size_t words = dest_size / 8;
+  const size_t remainder = dest_size % 8;
+  if(src[0] != MODE_RANS || src_size < 3 + 4 * STATES + remainder){
+    return SCIL_BUFFER_ERR;
+  }
+  const int alphabet = src[1] | (src[2] << 8);
+  if(alphabet < 1 || alphabet > SCIL_ENTROPY_ALPHABET_SIZE){
+    return SCIL_BUFFER_ERR;
+  }
+
+  const byte* p = src + 3;
+  const byte* end = src + src_size - remainder;
+  rans_model_t m;
+  uint32_t sum = 0;
+  for(int s=0; s < alphabet; s++){
+    uint32_t f = 0;
+    for(int shift=0; ; shift += 7){
+      if(p >= end || shift > 14){
+        return SCIL_BUFFER_ERR;
+      }
+      f |= (uint32_t) (*p & 0x7F) << shift;
+      if((*p++ & 0x80) == 0){
+        break;
+      }
+    }
+    m.freq[s] = f;
+    sum += f;
+  }
+  if(sum != PROB_SCALE || end - p < 4 * STATES){
+    return SCIL_BUFFER_ERR;
+  }
+  cumulate(& m, alphabet);
+
+  uint16_t* slot_symbol = (uint16_t*) scilU_safe_malloc(PROB_SCALE * sizeof(uint16_t));
+  for(int s=0; s < alphabet; s++){
+    for(uint32_t i=0; i < m.freq[s]; i++){
+      slot_symbol[m.start[s] + i] = (uint16_t) s;
+    }
+  }
+
+  uint32_t x[STATES];
+  for(int k=0; k < STATES; k++){
+    scilU_unpack4(p, & x[k]);
+    p += 4;
+  }
+  // the states are independent except for the shared stream
+  size_t i = 0;
+  for(; i + STATES <= words; i += STATES){
+    for(int k=0; k < STATES; k++){
+      x[k] = decode_word(x[k], & p, end, slot_symbol, & m, dest + 8 * (i + k));
+    }
+  }
+  for(; i < words; i++){
+    x[i % STATES] = decode_word(x[i % STATES], & p, end, slot_symbol, & m, dest + 8 * i);
+  }
+  free(slot_symbol);
+
+  // the encoder started with the initial states and consumed the whole stream
+  for(int k=0; k < STATES; k++){
+    if(x[k] != RANS_L){
+      return SCIL_BUFFER_ERR;
+    }
+  }
+  if(p != end){
+    return SCIL_BUFFER_ERR;
+  }
+  memcpy(dest + 8 * words, end, remainder);
+  return SCIL_NO_ERR;
+}
+
+static size_t rans_bound(size_t source_size){
+  return source_size + 1;
+}
+
+static const scil_block_codec_t rans_codec = {
+  rans_compress_block,
+  rans_decompress_block,
+  rans_bound
+};
+
+int scil_rans_compress(const scil_context_t* ctx, byte* restrict dest, size_t* restrict out_size, const byte*restrict source, const size_t source_size){
+  return scil_blocks_compress(ctx, & rans_codec, dest, out_size, source, source_size);
+}
+
+int scil_rans_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out){
+  return scil_blocks_decompress(& rans_codec, dest, buff_size, src, in_size, uncomp_size_out);
+}
+
+scilU_algorithm_t algo_rans = {
+    .c.Btype = {
+        scil_rans_compress,
+        scil_rans_decompress
+    },
+    "rans",
+    26,
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES,
+    0,
+    1
+};
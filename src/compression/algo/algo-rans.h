@@ -0,0 +1,37 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_ALGO_RANS_H_
+#define SCIL_ALGO_RANS_H_
+
+/**
+ * \file
+ * \brief Range asymmetric numeral system coder for the int64 output of converters such as quantize.
+ *
+ * It uses the symbol model of scil-entropy.h with frequencies normalized to 2^14 and four interleaved
+ * 32-bit states that share one stream of 16-bit words, the raw bits of large values are coded as uniform symbols.
+ * In contrast to the huffman stage, a symbol may cost a fraction of a bit, which pays off for skewed histograms.
+ * If the input does not compress, it is stored as is.
+ */
+
+#include <scil-algorithm-impl.h>
+
+int scil_rans_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size);
+
+int scil_rans_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out);
+
+extern scilU_algorithm_t algo_rans;
+
+#endif
@@ -21,6 +21,9 @@
 #include <math.h>
 #include <string.h>
 
+// flags signs_id if an exponent dictionary follows the header
+#define DICTIONARY_FLAG 0x80
+
 static uint64_t mask[] = {
     0,
     1,
@@ -226,6 +229,112 @@ static uint64_t get_mantissa_double(uint64_t value, uint8_t mantissa_bit_count){
     return (value & mask[mantissa_bit_count]) << (MANTISSA_LENGTH_DOUBLE - mantissa_bit_count);
 }
 
+/*
+ * Exponent dictionary: if only a few of the encoded exponents occur, e.g. clustered exponents with rare outliers,
+ * each value stores the index of its exponent in a dictionary instead.
+ * The dictionary is built from the encoded values, thus it covers exponents incremented by rounding and the
+ * exponents reserved for the fill and zero value.
+ */
+static uint16_t build_exponent_dictionary(const uint64_t* values,
+                                          size_t count,
+                                          uint8_t exponent_bit_count,
+                                          uint8_t mantissa_bit_count,
+                                          uint16_t* dictionary,
+                                          uint16_t* lookup){
+
+    const uint32_t exponents = 1u << exponent_bit_count;
+    memset(lookup, 0, exponents * sizeof(uint16_t));
+    for(size_t i = 0; i < count; ++i){
+        lookup[(values[i] >> mantissa_bit_count) & mask[exponent_bit_count]] = 1;
+    }
+
+    // the lookup table maps each used exponent to its index in the dictionary
+    uint16_t entries = 0;
+    for(uint32_t e = 0; e < exponents; ++e){
+        if(lookup[e]){
+            dictionary[entries] = (uint16_t) e;
+            lookup[e] = entries++;
+        }
+    }
+    return entries;
+}
+
+// replaces the exponent of each value by table[exponent], it encodes with the lookup table and decodes with the dictionary
+static void remap_exponents(uint64_t* values,
+                            size_t count,
+                            uint8_t signs_id,
+                            uint8_t from_bit_count,
+                            uint8_t to_bit_count,
+                            uint8_t mantissa_bit_count,
+                            const uint16_t* table){
+
+    const uint64_t sign_mask = signs_id == 2;
+    for(size_t i = 0; i < count; ++i){
+        const uint64_t value = values[i];
+        const uint64_t sign = (value >> (mantissa_bit_count + from_bit_count)) & sign_mask;
+        const uint64_t exponent = table[(value >> mantissa_bit_count) & mask[from_bit_count]];
+        values[i] = (sign << (mantissa_bit_count + to_bit_count)) | (exponent << mantissa_bit_count) | (value & mask[mantissa_bit_count]);
+    }
+}
+
+static uint8_t get_index_bit_count(uint16_t entries){
+
+    uint8_t bits = 0;
+    while((1u << bits) < entries) ++bits;
+    return bits;
+}
+
+/*
+ * Progressive layout: the encoded values are stored as bit planes from the most significant bit,
+ * i.e., the sign, the exponent and then the mantissa from its highest bit.
+ * A word of a plane holds one bit of 64 consecutive values, the planes follow each other.
+ * Thus, reading the first planes yields all values with fewer mantissa bits.
+ */
+#define PLANE_VALUES 64
+
+static size_t get_plane_size(size_t count){
+
+    return (count + PLANE_VALUES - 1) / PLANE_VALUES * sizeof(uint64_t);
+}
+
+static void write_planes(byte* restrict dest, const uint64_t* restrict values, size_t count, uint8_t planes, int threads){
+
+    const size_t words = get_plane_size(count) / sizeof(uint64_t);
+    #pragma omp parallel for num_threads(threads) if(threads > 1)
+    for(size_t w = 0; w < words; ++w){
+        const uint64_t* block = values + w * PLANE_VALUES;
+        const size_t n = count - w * PLANE_VALUES < PLANE_VALUES ? count - w * PLANE_VALUES : PLANE_VALUES;
+        for(uint8_t p = 0; p < planes; ++p){
+            const int bit = planes - 1 - p;
+            uint64_t word = 0;
+            for(size_t j = 0; j < n; ++j){
+                word |= ((block[j] >> bit) & 1) << j;
+            }
+            memcpy(dest + (p * words + w) * sizeof(uint64_t), & word, sizeof(uint64_t));
+        }
+    }
+}
+
+// reads the first planes_read of the planes, the bits of the remaining planes are 0
+static void read_planes(uint64_t* restrict values, const byte* restrict source, size_t count, uint8_t planes, uint8_t planes_read){
+
+    const size_t words = get_plane_size(count) / sizeof(uint64_t);
+    #pragma omp parallel for
+    for(size_t w = 0; w < words; ++w){
+        uint64_t* block = values + w * PLANE_VALUES;
+        const size_t n = count - w * PLANE_VALUES < PLANE_VALUES ? count - w * PLANE_VALUES : PLANE_VALUES;
+        memset(block, 0, n * sizeof(uint64_t));
+        for(uint8_t p = 0; p < planes_read; ++p){
+            const int bit = planes - 1 - p;
+            uint64_t word;
+            memcpy(& word, source + (p * words + w) * sizeof(uint64_t), sizeof(uint64_t));
+            for(size_t j = 0; j < n; ++j){
+                block[j] |= ((word >> j) & 1) << bit;
+            }
+        }
+    }
+}
+
 //Supported datatypes: double float
 // Repeat for each data type
 
@@ -547,8 +656,10 @@ static void get_header_data_fill_<DATATYPE>(const <DATATYPE>* source,
     int16_t maximum_exponent;
     uint8_t minimum_sign, maximum_sign;
 
-    byte *keys = (byte*)scilU_safe_malloc((EXPONENT_LENGTH_<DATATYPE_UPPER> - 1) << 2);
-    memset(keys, 0, (EXPONENT_LENGTH_<DATATYPE_UPPER> - 1) << 2);
+    // one bit per exponent
+    const size_t keys_size = (1 << (EXPONENT_LENGTH_<DATATYPE_UPPER> - 1)) / 8;
+    byte *keys = (byte*)scilU_safe_malloc(keys_size);
+    memset(keys, 0, keys_size);
 
     find_minimums_and_maximums_fill_<DATATYPE>(source,
                                           count,
@@ -642,30 +753,31 @@ static void get_header_data_fill_<DATATYPE>(const <DATATYPE>* source,
     return;
 }
 
-int scil_sigbits_compress_<DATATYPE>(const scil_context_t* ctx,
-                                     byte * restrict dest,
-                                     size_t* dest_size,
-                                     <DATATYPE>*restrict source,
-                                     const scil_dims_t* dims){
-
-    assert(ctx != NULL);
-    assert(dest != NULL);
-    assert(dest_size != NULL);
-    assert(source != NULL);
-    assert(dims != NULL);
-
-    // ==================== Initialization =====================================
+/*
+ * Quantizes the values according to the hints into sign, exponent and mantissa bits, as used by sigbits and its progressive variant.
+ * The encoded values are stored in dest, the parameters needed for decoding are returned.
+ */
+static int encode_values_<DATATYPE>(const scil_context_t* ctx,
+                                    uint64_t* restrict dest,
+                                    const <DATATYPE>* restrict source,
+                                    size_t count,
+                                    uint8_t* signs_id,
+                                    uint8_t* exponent_bit_count,
+                                    uint8_t* mantissa_bit_count,
+                                    int16_t* minimum_exponent,
+                                    uint64_t* fill_value_mask,
+                                    uint64_t* zero_value_mask){
 
     // If neither hint 'sigbits' nor 'reltol' is given,
     // this initializes to -1 as unsigned = 255
     // and will fail the test mantissa_bit_count >= MANTISSA_LENGTH_<DATATYPE_UPPER>
-    uint8_t mantissa_bit_count = ctx->hints.significant_bits - 1;
+    *mantissa_bit_count = ctx->hints.significant_bits - 1;
 
     // Calculate mantissa bits from hint 'reltol', apply when more strict
     if (ctx->hints.relative_tolerance_percent > 0.0) {
         uint8_t mantissa_bits_rel = scilU_relative_tolerance_to_significant_bits(ctx->hints.relative_tolerance_percent) - 1;
-        if (ctx->hints.significant_bits == 0 || mantissa_bits_rel > mantissa_bit_count)
-            mantissa_bit_count = mantissa_bits_rel;
+        if (ctx->hints.significant_bits == 0 || mantissa_bits_rel > *mantissa_bit_count)
+            *mantissa_bit_count = mantissa_bits_rel;
     }
     //printf("#mantissa_bit_count = %d\n", mantissa_bit_count);
 
@@ -681,55 +793,111 @@ int scil_sigbits_compress_<DATATYPE>(const scil_context_t* ctx,
     finest.f = finest_value;
 
     // Check whether sigbit compression makes sense
-    if(mantissa_bit_count == SCIL_ACCURACY_INT_FINEST || mantissa_bit_count >= MANTISSA_LENGTH_<DATATYPE_UPPER>){
+    if(*mantissa_bit_count == SCIL_ACCURACY_INT_FINEST || *mantissa_bit_count >= MANTISSA_LENGTH_<DATATYPE_UPPER>){
         return SCIL_PRECISION_ERR;
     }
 
-    size_t count = scil_dims_get_count(dims);
-
-    uint8_t signs_id, exponent_bit_count;
-    int16_t minimum_exponent;
-    uint64_t fill_value_mask, zero_value_mask;
-
+    *fill_value_mask = 0;
     if (ctx->hints.fill_value == DBL_MAX){
-      get_header_data_<DATATYPE>(source, count, &signs_id, &exponent_bit_count, mantissa_bit_count, &minimum_exponent, finest.p.exponent, &zero_value_mask);
+      get_header_data_<DATATYPE>(source, count, signs_id, exponent_bit_count, *mantissa_bit_count, minimum_exponent, finest.p.exponent, zero_value_mask);
     }else{ // use the fill value
-      get_header_data_fill_<DATATYPE>(source, count, &signs_id, &exponent_bit_count, mantissa_bit_count, &minimum_exponent, ctx->hints.fill_value, &fill_value_mask, finest.p.exponent, &zero_value_mask);
+      get_header_data_fill_<DATATYPE>(source, count, signs_id, exponent_bit_count, *mantissa_bit_count, minimum_exponent, ctx->hints.fill_value, fill_value_mask, finest.p.exponent, zero_value_mask);
 
-      if(!fill_value_mask){
+      if(!*fill_value_mask){
         return SCIL_FILL_VAL_ERR;
       }
       //if(!zero_value_mask) is ok, it's just the normal 0.0 then
     }
 
+    if (ctx->hints.fill_value == DBL_MAX){
+      // Compress each value in source buffer
+      if(compress_buffer_<DATATYPE>(dest, source, count, *signs_id, *exponent_bit_count, *mantissa_bit_count, *minimum_exponent, *zero_value_mask)){
+        return SCIL_BUFFER_ERR;
+      }
+    }else{ // don't compress the fill value
+      if(compress_buffer_fill_<DATATYPE>(dest, source, count, *signs_id, *exponent_bit_count, *mantissa_bit_count, *minimum_exponent, ctx->hints.fill_value, *fill_value_mask, *zero_value_mask)){
+        return SCIL_BUFFER_ERR;
+      }
+    }
+    return SCIL_NO_ERR;
+}
+
+static int decode_values_<DATATYPE>(<DATATYPE>* restrict dest,
+                                    const uint64_t* restrict source,
+                                    size_t count,
+                                    uint8_t signs_id,
+                                    uint8_t exponent_bit_count,
+                                    uint8_t mantissa_bit_count,
+                                    int16_t minimum_exponent,
+                                    double fill_value,
+                                    uint64_t fill_value_mask,
+                                    uint64_t zero_value_mask){
+
     uint8_t bit_count_per_value = get_bit_count_per_value(signs_id, exponent_bit_count, mantissa_bit_count);
 
-    // About finest: After finding min/max, the minimum_exponent will be the finest_exponent, so we use minimum_exponent from now on
-    int header = write_header(dest, signs_id, exponent_bit_count, mantissa_bit_count, minimum_exponent, ctx->hints.fill_value, fill_value_mask, zero_value_mask);
-    dest += header;
+    if (fill_value == DBL_MAX){
+      // Deompress each value in source buffer
+      return decompress_buffer_<DATATYPE>(dest, source, count, bit_count_per_value, signs_id, exponent_bit_count, mantissa_bit_count, minimum_exponent, zero_value_mask);
+    }
+    // set fill value
+    return decompress_buffer_fill_<DATATYPE>(dest, source, count, bit_count_per_value, signs_id, exponent_bit_count, mantissa_bit_count, minimum_exponent, fill_value, fill_value_mask, zero_value_mask);
+}
 
-    *dest_size = round_up_byte(bit_count_per_value * count) + header;
+int scil_sigbits_compress_<DATATYPE>(const scil_context_t* ctx,
+                                     byte * restrict dest,
+                                     size_t* dest_size,
+                                     <DATATYPE>*restrict source,
+                                     const scil_dims_t* dims){
 
-    int ret = SCIL_NO_ERR;
+    assert(ctx != NULL);
+    assert(dest != NULL);
+    assert(dest_size != NULL);
+    assert(source != NULL);
+    assert(dims != NULL);
+
+    // ==================== Initialization =====================================
+
+    size_t count = scil_dims_get_count(dims);
+
+    uint8_t signs_id, exponent_bit_count, mantissa_bit_count;
+    int16_t minimum_exponent;
+    uint64_t fill_value_mask, zero_value_mask;
 
     // ==================== Compression ========================================
 
     // Allocate intermediate buffer
     uint64_t* compressed_buffer = (uint64_t*)scilU_safe_malloc(count * sizeof(uint64_t));
 
-    if (ctx->hints.fill_value == DBL_MAX){
-      // Compress each value in source buffer
-      if(compress_buffer_<DATATYPE>(compressed_buffer, source, count, signs_id, exponent_bit_count, mantissa_bit_count, minimum_exponent, zero_value_mask)){
-        ret = SCIL_BUFFER_ERR;
-        goto comp_cleanup;
-      }
-    }else{ // don't compress the fill value
-      if(compress_buffer_fill_<DATATYPE>(compressed_buffer, source, count, signs_id, exponent_bit_count, mantissa_bit_count, minimum_exponent, ctx->hints.fill_value, fill_value_mask, zero_value_mask)){
-        ret = SCIL_BUFFER_ERR;
+    int ret = encode_values_<DATATYPE>(ctx, compressed_buffer, source, count, &signs_id, &exponent_bit_count, &mantissa_bit_count, &minimum_exponent, &fill_value_mask, &zero_value_mask);
+    if(ret != SCIL_NO_ERR){
         goto comp_cleanup;
-      }
     }
 
+    uint8_t bit_count_per_value = get_bit_count_per_value(signs_id, exponent_bit_count, mantissa_bit_count);
+
+    // Encode the exponents by their index in a dictionary if it saves more bits than it takes
+    uint16_t dictionary[1 << EXPONENT_LENGTH_<DATATYPE_UPPER>];
+    uint16_t lookup[1 << EXPONENT_LENGTH_<DATATYPE_UPPER>];
+    uint16_t entries = build_exponent_dictionary(compressed_buffer, count, exponent_bit_count, mantissa_bit_count, dictionary, lookup);
+    uint8_t index_bit_count = get_index_bit_count(entries);
+    uint8_t dictionary_bit_count = get_bit_count_per_value(signs_id, index_bit_count, mantissa_bit_count);
+    int use_dictionary = dictionary_bit_count > 0 && (uint64_t)(exponent_bit_count - index_bit_count) * count > 8 * (2 + 2 * (uint64_t) entries) + 8;
+
+    // About finest: After finding min/max, the minimum_exponent will be the finest_exponent, so we use minimum_exponent from now on
+    int header = write_header(dest, signs_id | (use_dictionary ? DICTIONARY_FLAG : 0), exponent_bit_count, mantissa_bit_count, minimum_exponent, ctx->hints.fill_value, fill_value_mask, zero_value_mask);
+    dest += header;
+
+    if(use_dictionary){
+        remap_exponents(compressed_buffer, count, signs_id, exponent_bit_count, index_bit_count, mantissa_bit_count, lookup);
+        memcpy(dest, & entries, sizeof(uint16_t));
+        memcpy(dest + 2, dictionary, entries * sizeof(uint16_t));
+        dest += 2 + entries * sizeof(uint16_t);
+        header += 2 + entries * sizeof(uint16_t);
+        bit_count_per_value = dictionary_bit_count;
+    }
+
+    *dest_size = round_up_byte((uint64_t)bit_count_per_value * count) + header;
+
     // Pack compressed values tightly
     if(scil_swage(dest, compressed_buffer, count, bit_count_per_value)){
         ret = SCIL_BUFFER_ERR;
@@ -770,6 +938,25 @@ int scil_sigbits_decompress_<DATATYPE>(<DATATYPE>*restrict dest,
     int header = read_header(source, &source_size_cp, &signs_id, &exponent_bit_count, &mantissa_bit_count, &minimum_exponent, &fill_value, &fill_value_mask, &zero_value_mask);
     source += header;
 
+    // the exponent dictionary follows the header, unused indices decode to exponent 0
+    const int use_dictionary = signs_id & DICTIONARY_FLAG;
+    signs_id &= ~DICTIONARY_FLAG;
+    uint16_t dictionary[1 << EXPONENT_LENGTH_<DATATYPE_UPPER>] = {0};
+    uint8_t index_bit_count = 0;
+    if(use_dictionary){
+        if(exponent_bit_count > EXPONENT_LENGTH_<DATATYPE_UPPER> || source_size_cp < 2){
+            return SCIL_BUFFER_ERR;
+        }
+        uint16_t entries;
+        memcpy(& entries, source, sizeof(uint16_t));
+        if(entries > (1u << exponent_bit_count) || source_size_cp < 2 + entries * sizeof(uint16_t)){
+            return SCIL_BUFFER_ERR;
+        }
+        memcpy(dictionary, source + 2, entries * sizeof(uint16_t));
+        source += 2 + entries * sizeof(uint16_t);
+        index_bit_count = get_index_bit_count(entries);
+    }
+
     uint8_t bit_count_per_value = get_bit_count_per_value(signs_id, exponent_bit_count, mantissa_bit_count);
 
     // ==================== Decompression ======================================
@@ -778,22 +965,17 @@ int scil_sigbits_decompress_<DATATYPE>(<DATATYPE>*restrict dest,
 
     int ret = SCIL_NO_ERR;
 
-    if(scil_unswage(unswaged_buffer, source, count, bit_count_per_value)){
+    if(scil_unswage(unswaged_buffer, source, count, use_dictionary ? get_bit_count_per_value(signs_id, index_bit_count, mantissa_bit_count) : bit_count_per_value)){
         ret = SCIL_BUFFER_ERR;
         goto decomp_cleanup;
     }
+    if(use_dictionary){
+        remap_exponents(unswaged_buffer, count, signs_id, index_bit_count, exponent_bit_count, mantissa_bit_count, dictionary);
+    }
 
-    if (fill_value == DBL_MAX){
-      // Deompress each value in source buffer
-      if(decompress_buffer_<DATATYPE>(dest, unswaged_buffer, count, bit_count_per_value, signs_id, exponent_bit_count, mantissa_bit_count, minimum_exponent, zero_value_mask) ){
-          ret = SCIL_BUFFER_ERR;
-          goto decomp_cleanup;
-      }
-    }else{ // set fill value
-      if(decompress_buffer_fill_<DATATYPE>(dest, unswaged_buffer, count, bit_count_per_value, signs_id, exponent_bit_count, mantissa_bit_count, minimum_exponent, fill_value, fill_value_mask, zero_value_mask) ){
-          ret = SCIL_BUFFER_ERR;
-          goto decomp_cleanup;
-      }
+    if(decode_values_<DATATYPE>(dest, unswaged_buffer, count, signs_id, exponent_bit_count, mantissa_bit_count, minimum_exponent, fill_value, fill_value_mask, zero_value_mask)){
+        ret = SCIL_BUFFER_ERR;
+        goto decomp_cleanup;
     }
 
     // ==================== Cleanup ============================================
@@ -803,6 +985,116 @@ int scil_sigbits_decompress_<DATATYPE>(<DATATYPE>*restrict dest,
     return ret;
 }
 
+int scil_sigbits_progressive_compress_<DATATYPE>(const scil_context_t* ctx,
+                                                 byte * restrict dest,
+                                                 size_t* dest_size,
+                                                 <DATATYPE>*restrict source,
+                                                 const scil_dims_t* dims){
+
+    assert(ctx != NULL);
+    assert(dest != NULL);
+    assert(dest_size != NULL);
+    assert(source != NULL);
+    assert(dims != NULL);
+
+    size_t count = scil_dims_get_count(dims);
+
+    uint8_t signs_id, exponent_bit_count, mantissa_bit_count;
+    int16_t minimum_exponent;
+    uint64_t fill_value_mask, zero_value_mask;
+
+    uint64_t* compressed_buffer = (uint64_t*)scilU_safe_malloc(count * sizeof(uint64_t));
+
+    int ret = encode_values_<DATATYPE>(ctx, compressed_buffer, source, count, &signs_id, &exponent_bit_count, &mantissa_bit_count, &minimum_exponent, &fill_value_mask, &zero_value_mask);
+    if(ret != SCIL_NO_ERR){
+        free(compressed_buffer);
+        return ret;
+    }
+
+    // NaN is marked by the highest mantissa bit instead of the lowest, thus it stays NaN if the lower planes are not read
+    if(mantissa_bit_count > 0){
+        for(size_t i = 0; i < count; ++i){
+            const uint64_t value = compressed_buffer[i];
+            if((value & mask[mantissa_bit_count]) && get_exponent(value, exponent_bit_count, mantissa_bit_count, minimum_exponent) == MAX_EXPONENT_<DATATYPE>){
+                compressed_buffer[i] = (value & ~mask[mantissa_bit_count]) | ((uint64_t) 1 << (mantissa_bit_count - 1));
+            }
+        }
+    }
+
+    int header = write_header(dest, signs_id, exponent_bit_count, mantissa_bit_count, minimum_exponent, ctx->hints.fill_value, fill_value_mask, zero_value_mask);
+    const uint8_t planes = get_bit_count_per_value(signs_id, exponent_bit_count, mantissa_bit_count);
+    write_planes(dest + header, compressed_buffer, count, planes, ctx->hints.thread_count);
+    *dest_size = header + planes * get_plane_size(count);
+
+    free(compressed_buffer);
+    return SCIL_NO_ERR;
+}
+
+int scil_sigbits_progressive_decompress_precision_<DATATYPE>(<DATATYPE>*restrict dest,
+                                                             scil_dims_t* dims,
+                                                             byte*restrict source,
+                                                             size_t source_size,
+                                                             int significant_bits){
+
+    assert(dest != NULL);
+    assert(dims != NULL);
+    assert(source != NULL);
+
+    double fill_value = DBL_MAX;
+    size_t count = scil_dims_get_count(dims);
+    size_t source_size_cp = source_size;
+
+    uint8_t signs_id, exponent_bit_count, mantissa_bit_count;
+    int16_t minimum_exponent;
+    uint64_t fill_value_mask = 0, zero_value_mask = 0;
+    int header = read_header(source, &source_size_cp, &signs_id, &exponent_bit_count, &mantissa_bit_count, &minimum_exponent, &fill_value, &fill_value_mask, &zero_value_mask);
+    source += header;
+
+    const uint8_t planes = get_bit_count_per_value(signs_id, exponent_bit_count, mantissa_bit_count);
+    if(signs_id > 2 || planes > 64){
+        return SCIL_BUFFER_ERR;
+    }
+    uint8_t mantissa_read = significant_bits <= 0 || significant_bits - 1 >= mantissa_bit_count ? mantissa_bit_count : significant_bits - 1;
+    // the highest mantissa bit distinguishes NaN from infinity
+    if(mantissa_read == 0 && mantissa_bit_count > 0){
+        mantissa_read = 1;
+    }
+    const uint8_t planes_read = planes - (mantissa_bit_count - mantissa_read);
+    // only the planes read must be present
+    if(source_size_cp < planes_read * get_plane_size(count)){
+        return SCIL_BUFFER_ERR;
+    }
+
+    uint64_t* unswaged_buffer = (uint64_t*)scilU_safe_malloc(count * sizeof(uint64_t));
+    read_planes(unswaged_buffer, source, count, planes, planes_read);
+
+    if(mantissa_read < mantissa_bit_count){
+        // the bits not read are set to the middle of their interval, which halves the maximum error
+        const uint64_t middle = (uint64_t) 1 << (mantissa_bit_count - mantissa_read - 1);
+        const int has_fill = ! scilU_double_equal(fill_value, DBL_MAX);
+        for(size_t i = 0; i < count; ++i){
+            const uint64_t value = unswaged_buffer[i];
+            const int16_t exponent = get_exponent(value, exponent_bit_count, mantissa_bit_count, minimum_exponent);
+            const int special = value == zero_value_mask || (has_fill && value == fill_value_mask);
+            if(! special && exponent > 0 && exponent < MAX_EXPONENT_<DATATYPE>){
+                unswaged_buffer[i] = value | middle;
+            }
+        }
+    }
+
+    int ret = decode_values_<DATATYPE>(dest, unswaged_buffer, count, signs_id, exponent_bit_count, mantissa_bit_count, minimum_exponent, fill_value, fill_value_mask, zero_value_mask);
+    free(unswaged_buffer);
+    return ret == SCIL_NO_ERR ? SCIL_NO_ERR : SCIL_BUFFER_ERR;
+}
+
+int scil_sigbits_progressive_decompress_<DATATYPE>(<DATATYPE>*restrict dest,
+                                                   scil_dims_t* dims,
+                                                   byte*restrict source,
+                                                   size_t source_size){
+
+    return scil_sigbits_progressive_decompress_precision_<DATATYPE>(dest, dims, source, source_size, 0);
+}
+
 // End repeat
 
 scilU_algorithm_t algo_sigbits = {
@@ -814,3 +1106,17 @@ scilU_algorithm_t algo_sigbits = {
     SCIL_COMPRESSOR_TYPE_DATATYPES,
     1
 };
+
+scilU_algorithm_t algo_sigbits_progressive = {
+    .c.DNtype = {
+        CREATE_INITIALIZER(scil_sigbits_progressive)
+    },
+    "sigbits-progressive",
+    40,
+    SCIL_COMPRESSOR_TYPE_DATATYPES,
+    1,
+    .precision = {
+        scil_sigbits_progressive_decompress_precision_float,
+        scil_sigbits_progressive_decompress_precision_double
+    }
+};
@@ -48,9 +48,26 @@ int scil_sigbits_compress_<DATATYPE>(const scil_context_t* ctx, byte* restrict d
  */
 int scil_sigbits_decompress_<DATATYPE>( <DATATYPE>*restrict dest, scil_dims_t* dims, byte*restrict source, const size_t source_size);
 
+/**
+ * \brief Compression function of the progressive variant of sigbits
+ * The values are quantized like by sigbits and stored as bit planes from the most significant bit,
+ * so that a reader of fewer significant bits only needs the first planes.
+ */
+int scil_sigbits_progressive_compress_<DATATYPE>(const scil_context_t* ctx, byte* restrict dest, size_t* restrict dest_size, <DATATYPE>*restrict source, const scil_dims_t* dims);
+
+int scil_sigbits_progressive_decompress_<DATATYPE>( <DATATYPE>*restrict dest, scil_dims_t* dims, byte*restrict source, const size_t source_size);
+
+/**
+ * \brief Decompresses the progressive variant with at most significant_bits, all bits are decoded if it is <= 0
+ * Only the header and the planes of the bits requested are read, thus source_size may cover only these.
+ * The relative error compared to the uncompressed data is at most 2^-significant_bits plus the error of the stored bits.
+ */
+int scil_sigbits_progressive_decompress_precision_<DATATYPE>( <DATATYPE>*restrict dest, scil_dims_t* dims, byte*restrict source, const size_t source_size, int significant_bits);
+
 // End repeat
 
 
 extern scilU_algorithm_t algo_sigbits;
+extern scilU_algorithm_t algo_sigbits_progressive;
 
 #endif /* SCIL_SIGBITS_H_ */
@@ -0,0 +1,373 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-sz-native.h>
+#include <algo/algo-rans.h>
+
+#include <scil-util.h>
+
+#include <math.h>
+#include <string.h>
+
+/*
+ * Layout: mode (1 byte), for MODE_STORED the data follows.
+ * MODE_PREDICTED: absolute tolerance (8 bytes), planes of the slowest dimension per block (8 bytes),
+ * the compressed size of each block (8 bytes each), the blocks.
+ * A block: size of the coded quantization codes (8 bytes), the codes, the unpredictable values.
+ */
+#define MODE_STORED 0
+#define MODE_PREDICTED 1
+#define HEADER_SIZE 17
+
+#define BLOCK_TARGET_COUNT (1 << 18)
+
+// codes are within (-QUANT_RADIUS, QUANT_RADIUS), QUANT_RADIUS marks an unpredictable value
+#define QUANT_RADIUS (1 << 15)
+#define UNPREDICTABLE QUANT_RADIUS
+
+// the size of the rans output for count codes, rans stores incompressible blocks of 1 MiB
+#define CODES_BOUND(count) (8 * (count) + 16 + 5 * ((8 * (count) >> 20) + 1))
+
+// the Lorenzo predictor for each combination of dimensions with a preceding neighbor
+#define LORENZO_MASKS (1 << SCIL_DIMS_MAX)
+
+typedef struct{
+  int count;
+  size_t offset[LORENZO_MASKS - 1];
+  int sign[LORENZO_MASKS - 1];
+} lorenzo_terms_t;
+
+typedef struct{
+  size_t planes;
+  size_t plane_size;
+  size_t blocks;
+} block_layout_t;
+
+/*
+ * The prediction is the sum over all neighbors in the hypercube before the value,
+ * neighbors that differ in an odd number of dimensions are added, the others subtracted.
+ * Dimensions in which the value is at the border are ignored.
+ */
+static void lorenzo_terms(lorenzo_terms_t* terms, const scil_dims_t* dims){
+  size_t stride[SCIL_DIMS_MAX];
+  size_t s = 1;
+  for(int d=0; d < dims->dims; d++){
+    stride[d] = s;
+    s *= dims->length[d];
+  }
+  for(int mask=0; mask < (1 << dims->dims); mask++){
+    lorenzo_terms_t* t = & terms[mask];
+    t->count = 0;
+    for(int sub=mask; sub != 0; sub = (sub - 1) & mask){
+      size_t offset = 0;
+      for(int d=0; d < dims->dims; d++){
+        if(sub & (1 << d)){
+          offset += stride[d];
+        }
+      }
+      t->offset[t->count] = offset;
+      t->sign[t->count] = __builtin_popcount(sub) % 2 ? 1 : -1;
+      t->count++;
+    }
+  }
+}
+
+// the dimensions except the first one in which row r has a predecessor
+static int row_mask(size_t r, const scil_dims_t* dims){
+  int mask = 0;
+  for(int d=1; d < dims->dims; d++){
+    if(r % dims->length[d] > 0){
+      mask |= 1 << d;
+    }
+    r /= dims->length[d];
+  }
+  return mask;
+}
+
+static void get_block_layout(block_layout_t* l, const scil_dims_t* dims){
+  const size_t count = scil_dims_get_count(dims);
+  const size_t outer = dims->length[dims->dims - 1];
+  l->plane_size = count / outer;
+  l->planes = BLOCK_TARGET_COUNT / l->plane_size;
+  if(l->planes == 0){
+    l->planes = 1;
+  }
+  l->blocks = (outer + l->planes - 1) / l->planes;
+}
+
+static void get_block_dims(scil_dims_t* out, const scil_dims_t* dims, const block_layout_t* l, size_t block){
+  *out = *dims;
+  const size_t outer = dims->length[dims->dims - 1];
+  const size_t first = block * l->planes;
+  out->length[dims->dims - 1] = outer - first < l->planes ? outer - first : l->planes;
+}
+
+//Supported datatypes: double float
+// Repeat for each data type
+
+static inline double predict_<DATATYPE>(const <DATATYPE>* value, const lorenzo_terms_t* t){
+  double prediction = 0;
+  for(int k=0; k < t->count; k++){
+    prediction += t->sign[k] * (double) *(value - t->offset[k]);
+  }
+  return prediction;
+}
+
+// compression and decompression must reconstruct identical values
+static inline <DATATYPE> reconstruct_<DATATYPE>(double prediction, int64_t code, double step){
+  return (<DATATYPE>) (prediction + (double) code * step);
+}
+
+// the block is written to out if it fits into capacity, otherwise SCIL_BUFFER_ERR is returned
+static int compress_block_<DATATYPE>(const scil_context_t* ctx, byte* restrict out, size_t capacity, size_t* out_size, const <DATATYPE>* restrict in, const scil_dims_t* dims, double abstol){
+  const size_t count = scil_dims_get_count(dims);
+  const size_t row = dims->length[0];
+  const size_t rows = count / row;
+  const double step = 2 * abstol;
+  lorenzo_terms_t terms[LORENZO_MASKS];
+  lorenzo_terms(terms, dims);
+
+  <DATATYPE>* recon = (<DATATYPE>*) scilU_safe_malloc(count * sizeof(<DATATYPE>));
+  int64_t* codes = (int64_t*) scilU_safe_malloc(count * sizeof(int64_t));
+  <DATATYPE>* unpredictable = (<DATATYPE>*) scilU_safe_malloc(count * sizeof(<DATATYPE>));
+  size_t unpredictable_count = 0;
+
+  for(size_t r=0; r < rows; r++){
+    const int mask = row_mask(r, dims);
+    for(size_t x=0; x < row; x++){
+      const size_t i = r * row + x;
+      const double prediction = predict_<DATATYPE>(recon + i, & terms[mask | (x > 0)]);
+      const double value = (double) in[i];
+      const double diff = (value - prediction) / step;
+      // NaN and infinite values are always unpredictable
+      if(fabs(diff) < QUANT_RADIUS - 1){
+        const int64_t code = llround(diff);
+        const <DATATYPE> v = reconstruct_<DATATYPE>(prediction, code, step);
+        if(fabs((double) v - value) <= abstol){
+          codes[i] = code;
+          recon[i] = v;
+          continue;
+        }
+      }
+      codes[i] = UNPREDICTABLE;
+      recon[i] = in[i];
+      unpredictable[unpredictable_count++] = in[i];
+    }
+  }
+
+  free(recon);
+  // the output of rans is only bounded by the size of the codes, so it is staged per block
+  const size_t unpredictable_size = unpredictable_count * sizeof(<DATATYPE>);
+  byte* coded = (byte*) scilU_safe_malloc(CODES_BOUND(count));
+  size_t codes_size = 0;
+  int ret = scil_rans_compress(ctx, coded, & codes_size, (byte*) codes, count * sizeof(int64_t));
+  free(codes);
+  if(ret == SCIL_NO_ERR && 8 + codes_size + unpredictable_size > capacity){
+    ret = SCIL_BUFFER_ERR;
+  }
+  if(ret == SCIL_NO_ERR){
+    uint64_t size = codes_size;
+    scilU_pack8(out, size);
+    memcpy(out + 8, coded, codes_size);
+    memcpy(out + 8 + codes_size, unpredictable, unpredictable_size);
+    *out_size = 8 + codes_size + unpredictable_size;
+  }
+  free(coded);
+  free(unpredictable);
+  return ret;
+}
+
+static int decompress_block_<DATATYPE>(<DATATYPE>* restrict out, const scil_dims_t* dims, const byte* restrict in, size_t in_size, double abstol){
+  const size_t count = scil_dims_get_count(dims);
+  const size_t row = dims->length[0];
+  const size_t rows = count / row;
+  const double step = 2 * abstol;
+  lorenzo_terms_t terms[LORENZO_MASKS];
+  lorenzo_terms(terms, dims);
+
+  uint64_t codes_size;
+  if(in_size < 8){
+    return SCIL_BUFFER_ERR;
+  }
+  scilU_unpack8(in, & codes_size);
+  if(codes_size > in_size - 8){
+    return SCIL_BUFFER_ERR;
+  }
+  int64_t* codes = (int64_t*) scilU_safe_malloc(count * sizeof(int64_t));
+  size_t codes_bytes;
+  int ret = scil_rans_decompress((byte*) codes, count * sizeof(int64_t), in + 8, codes_size, & codes_bytes);
+  if(ret != SCIL_NO_ERR || codes_bytes != count * sizeof(int64_t)){
+    free(codes);
+    return ret != SCIL_NO_ERR ? ret : SCIL_BUFFER_ERR;
+  }
+  const byte* unpredictable = in + 8 + codes_size;
+  const size_t unpredictable_count = (in_size - 8 - codes_size) / sizeof(<DATATYPE>);
+  size_t u = 0;
+
+  for(size_t r=0; r < rows; r++){
+    const int mask = row_mask(r, dims);
+    for(size_t x=0; x < row; x++){
+      const size_t i = r * row + x;
+      if(codes[i] == UNPREDICTABLE){
+        if(u == unpredictable_count){
+          free(codes);
+          return SCIL_BUFFER_ERR;
+        }
+        memcpy(out + i, unpredictable + u * sizeof(<DATATYPE>), sizeof(<DATATYPE>));
+        u++;
+        continue;
+      }
+      const double prediction = predict_<DATATYPE>(out + i, & terms[mask | (x > 0)]);
+      out[i] = reconstruct_<DATATYPE>(prediction, codes[i], step);
+    }
+  }
+  free(codes);
+  return SCIL_NO_ERR;
+}
+
+int scil_sz_native_compress_<DATATYPE>(const scil_context_t* ctx,
+                                    byte* restrict dest,
+                                    size_t* restrict dest_size,
+                                    <DATATYPE>* restrict source,
+                                    const scil_dims_t* dims){
+  const double abstol = ctx->hints.absolute_tolerance;
+  if(! (abstol > 0.0)){
+    return SCIL_PRECISION_ERR;
+  }
+  const size_t count = scil_dims_get_count(dims);
+  block_layout_t l;
+  get_block_layout(& l, dims);
+  const size_t block_count = l.planes * l.plane_size;
+  const size_t block_size = block_count * sizeof(<DATATYPE>);
+  const size_t data_offset = HEADER_SIZE + 8 * l.blocks;
+  // the prediction pays off only if the stream is smaller than the stored data
+  int ret = data_offset < 1 + count * sizeof(<DATATYPE>) ? SCIL_NO_ERR : SCIL_BUFFER_ERR;
+
+  if(ret == SCIL_NO_ERR){
+    // each block is compressed into dest at the offset of its uncompressed data
+    int* status = (int*) scilU_safe_malloc(l.blocks * sizeof(int));
+    size_t* sizes = (size_t*) scilU_safe_malloc(l.blocks * sizeof(size_t));
+    const int threads = ctx->hints.thread_count;
+
+    #pragma omp parallel for num_threads(threads) if(threads > 1 && l.blocks > 1) schedule(dynamic)
+    for(size_t b=0; b < l.blocks; b++){
+      scil_dims_t block_dims;
+      get_block_dims(& block_dims, dims, & l, b);
+      const size_t capacity = scil_dims_get_count(& block_dims) * sizeof(<DATATYPE>);
+      status[b] = compress_block_<DATATYPE>(ctx, dest + data_offset + b * block_size, capacity, & sizes[b], source + b * block_count, & block_dims, abstol);
+    }
+
+    size_t total = data_offset;
+    for(size_t b=0; b < l.blocks && ret == SCIL_NO_ERR; b++){
+      ret = status[b];
+      if(ret == SCIL_NO_ERR){
+        uint64_t size = sizes[b];
+        scilU_pack8((dest + HEADER_SIZE + 8 * b), size);
+        // the blocks only move towards the beginning of the buffer
+        memmove(dest + total, dest + data_offset + b * block_size, sizes[b]);
+        total += sizes[b];
+      }
+    }
+    if(ret == SCIL_NO_ERR && total >= 1 + count * sizeof(<DATATYPE>)){
+      ret = SCIL_BUFFER_ERR;
+    }
+    if(ret == SCIL_NO_ERR){
+      dest[0] = MODE_PREDICTED;
+      uint64_t planes = l.planes;
+      scilU_pack8((dest + 1), abstol);
+      scilU_pack8((dest + 9), planes);
+      *dest_size = total;
+    }
+    free(sizes);
+    free(status);
+  }
+  if(ret == SCIL_BUFFER_ERR){
+    // the data is too noisy for the tolerance
+    dest[0] = MODE_STORED;
+    memcpy(dest + 1, source, count * sizeof(<DATATYPE>));
+    *dest_size = 1 + count * sizeof(<DATATYPE>);
+    ret = SCIL_NO_ERR;
+  }
+  return ret;
+}
+
+int scil_sz_native_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                      scil_dims_t* dims,
+                                      byte* restrict source,
+                                      size_t in_size){
+  const size_t count = scil_dims_get_count(dims);
+  if(in_size < 1){
+    return SCIL_BUFFER_ERR;
+  }
+  if(source[0] == MODE_STORED){
+    if(in_size != 1 + count * sizeof(<DATATYPE>)){
+      return SCIL_BUFFER_ERR;
+    }
+    memcpy(dest, source + 1, count * sizeof(<DATATYPE>));
+    return SCIL_NO_ERR;
+  }
+  if(source[0] != MODE_PREDICTED || in_size < HEADER_SIZE){
+    return SCIL_BUFFER_ERR;
+  }
+  double abstol;
+  uint64_t planes;
+  scilU_unpack8((source + 1), & abstol);
+  scilU_unpack8((source + 9), & planes);
+  block_layout_t l;
+  get_block_layout(& l, dims);
+  if(planes != l.planes || HEADER_SIZE + 8 * l.blocks > in_size){
+    return SCIL_BUFFER_ERR;
+  }
+  const size_t block_count = l.planes * l.plane_size;
+
+  size_t* offsets = (size_t*) scilU_safe_malloc((l.blocks + 1) * sizeof(size_t));
+  offsets[0] = HEADER_SIZE + 8 * l.blocks;
+  for(size_t b=0; b < l.blocks; b++){
+    uint64_t size;
+    scilU_unpack8((source + HEADER_SIZE + 8 * b), & size);
+    offsets[b + 1] = offsets[b] + size;
+  }
+  if(offsets[l.blocks] > in_size){
+    free(offsets);
+    return SCIL_BUFFER_ERR;
+  }
+
+  int* status = (int*) scilU_safe_malloc(l.blocks * sizeof(int));
+  #pragma omp parallel for if(l.blocks > 1) schedule(dynamic)
+  for(size_t b=0; b < l.blocks; b++){
+    scil_dims_t block_dims;
+    get_block_dims(& block_dims, dims, & l, b);
+    status[b] = decompress_block_<DATATYPE>(dest + b * block_count, & block_dims, source + offsets[b], offsets[b + 1] - offsets[b], abstol);
+  }
+  int ret = SCIL_NO_ERR;
+  for(size_t b=0; b < l.blocks && ret == SCIL_NO_ERR; b++){
+    ret = status[b];
+  }
+  free(status);
+  free(offsets);
+  return ret;
+}
+
+// End repeat
+
+scilU_algorithm_t algo_sz_native = {
+    .c.DNtype = {
+        CREATE_INITIALIZER(scil_sz_native)
+    },
+    "sz-native",
+    27,
+    SCIL_COMPRESSOR_TYPE_DATATYPES,
+    1
+};
@@ -0,0 +1,53 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_SZ_NATIVE_H_
+#define SCIL_SZ_NATIVE_H_
+
+/**
+ * \file
+ * \brief Error-bounded predict-quantize-encode compressor in the style of SZ.
+ *
+ * Each value is predicted by the Lorenzo predictor from the already reconstructed neighbors,
+ * the prediction error is quantized with a step of twice the absolute tolerance.
+ * Values whose reconstruction misses the tolerance are unpredictable and stored in a list.
+ * The quantization codes are entropy coded with the rans stage.
+ * The data is split along the slowest dimension into blocks that are processed in parallel.
+ */
+
+#include <scil-algorithm-impl.h>
+
+//Repeat for each data type
+//Supported datatypes:double float
+
+/**
+ * \brief Compresses with the absolute_tolerance hint and thread_count threads
+ * \return SCIL_PRECISION_ERR if no absolute tolerance is set
+ */
+int scil_sz_native_compress_<DATATYPE>(const scil_context_t* ctx,
+                                    byte* restrict dest,
+                                    size_t* restrict dest_size,
+                                    <DATATYPE>* restrict source,
+                                    const scil_dims_t* dims);
+
+int scil_sz_native_decompress_<DATATYPE>(<DATATYPE>* restrict dest,
+                                      scil_dims_t* dims,
+                                      byte* restrict source,
+                                      size_t in_size);
+// End repeat
+
+extern scilU_algorithm_t algo_sz_native;
+
+#endif /* SCIL_SZ_NATIVE_H_ */
@@ -0,0 +1,537 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-wavelets.h>
+
+#include <algo/algo-rans.h>
+#include <scil-bitpack.h>
+#include <scil-entropy.h>
+#include <scil-util.h>
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+ * Layout: the filter (1 byte), the number of levels (1 byte), the quantization step of the coefficients (8 bytes),
+ * the step of the corrections (8 bytes), the size of the coefficient stream (8 bytes), the number of corrected points (8 bytes),
+ * the rANS coded coefficients, the distances between the corrected points and their zigzag coded corrections.
+ * The last two are PFOR streams preceded by the bits of their largest value (1 byte).
+ *
+ * A level transforms the low pass band of the previous level along every dimension of length > 1, the low pass
+ * coefficients of a dimension are stored before the high pass coefficients.
+ * The signal is extended symmetrically at the boundaries.
+ * The lines along a dimension are lifted in tiles of TILE_LINES lines, a tile keeps the values of one position
+ * of all its lines next to each other, thus a lifting step processes vectors of the lines.
+ */
+#define FILTER_CDF97 0
+#define FILTER_CDF53 1
+
+#define MAX_LEVELS 6
+
+#define TILE_LINES 16
+
+// the length of the segments sampled to choose the filter
+#define FILTER_SEGMENT 1024
+
+#define HEADER_SIZE 34
+
+// the quantization step of the coefficients relative to the tolerance
+#define COEFFICIENT_STEP 0.5
+
+// lifting coefficients of the CDF 9/7 wavelet as in JPEG 2000
+#define CDF97_ALPHA -1.586134342059924
+#define CDF97_BETA -0.052980118572961
+#define CDF97_GAMMA 0.882911075530934
+#define CDF97_DELTA 0.443506852043971
+#define CDF97_K 1.230174104914001
+
+#define EPSILON_FLOAT FLT_EPSILON
+#define EPSILON_DOUBLE DBL_EPSILON
+
+// a part of an array with the strides of the full array, dimension 0 is contiguous
+typedef struct{
+  int dims;
+  size_t length[SCIL_DIMS_MAX];
+  size_t stride[SCIL_DIMS_MAX];
+} region_t;
+
+static int get_level_count(const scil_dims_t* dims){
+  size_t longest = 1;
+  for(int d=0; d < dims->dims; d++){
+    if(dims->length[d] > longest){
+      longest = dims->length[d];
+    }
+  }
+  // the low pass band of the last level keeps at least 4 points of the longest dimension
+  int levels = 0;
+  while(levels < MAX_LEVELS && (longest >> (levels + 1)) >= 4){
+    levels++;
+  }
+  return levels;
+}
+
+// the low pass band of the given level
+static void get_region(region_t* r, const scil_dims_t* dims, int level){
+  r->dims = dims->dims;
+  size_t stride = 1;
+  for(int d=0; d < dims->dims; d++){
+    r->length[d] = ((dims->length[d] - 1) >> level) + 1;
+    r->stride[d] = stride;
+    stride *= dims->length[d];
+  }
+}
+
+static size_t get_line_count(const region_t* r, int dim){
+  size_t count = 1;
+  for(int d=0; d < r->dims; d++){
+    if(d != dim){
+      count *= r->length[d];
+    }
+  }
+  return count;
+}
+
+// the position of the first value of a line along dim, consecutive lines are neighbours in the lowest other dimension
+static size_t get_line_start(const region_t* r, int dim, size_t line){
+  size_t pos = 0;
+  for(int d=0; d < r->dims; d++){
+    if(d != dim){
+      pos += (line % r->length[d]) * r->stride[d];
+      line /= r->length[d];
+    }
+  }
+  return pos;
+}
+
+// row[l] += weight * (a[l] + b[l]) for the lines of a tile, a and b may be the same row
+static inline void lift_row(double* restrict row, const double* a, const double* b, double weight){
+#ifdef __SSE2__
+  const __m128d w = _mm_set1_pd(weight);
+  for(int l=0; l < TILE_LINES; l += 2){
+    const __m128d sum = _mm_add_pd(_mm_loadu_pd(a + l), _mm_loadu_pd(b + l));
+    _mm_storeu_pd(row + l, _mm_add_pd(_mm_loadu_pd(row + l), _mm_mul_pd(w, sum)));
+  }
+#else
+  for(int l=0; l < TILE_LINES; l++){
+    row[l] += weight * (a[l] + b[l]);
+  }
+#endif
+}
+
+// odd[i] += weight * (even[i] + even[i + 1]) on a tile with the even positions first
+static void lift_odd(double* restrict tile, size_t n, double weight){
+  const size_t evens = (n + 1) / 2;
+  const size_t odds = n / 2;
+  for(size_t i=0; i < odds; i++){
+    lift_row(tile + (evens + i) * TILE_LINES, tile + i * TILE_LINES, tile + (i + 1 < evens ? i + 1 : i) * TILE_LINES, weight);
+  }
+}
+
+// even[i] += weight * (odd[i - 1] + odd[i]) on a tile with the even positions first
+static void lift_even(double* restrict tile, size_t n, double weight){
+  const size_t evens = (n + 1) / 2;
+  const size_t odds = n / 2;
+  for(size_t i=0; i < evens; i++){
+    lift_row(tile + i * TILE_LINES, tile + (evens + (i > 0 ? i - 1 : 0)) * TILE_LINES, tile + (evens + (i < odds ? i : odds - 1)) * TILE_LINES, weight);
+  }
+}
+
+static void scale(double* restrict tile, size_t n, double even_factor, double odd_factor){
+  const size_t evens = (n + 1) / 2;
+  for(size_t i=0; i < n * TILE_LINES; i++){
+    tile[i] *= i < evens * TILE_LINES ? even_factor : odd_factor;
+  }
+}
+
+static void lift_forward(double* restrict tile, size_t n, int filter){
+  if(filter == FILTER_CDF97){
+    lift_odd(tile, n, CDF97_ALPHA);
+    lift_even(tile, n, CDF97_BETA);
+    lift_odd(tile, n, CDF97_GAMMA);
+    lift_even(tile, n, CDF97_DELTA);
+    scale(tile, n, 1 / CDF97_K, CDF97_K);
+  }else{
+    lift_odd(tile, n, -0.5);
+    lift_even(tile, n, 0.25);
+  }
+}
+
+static void lift_inverse(double* restrict tile, size_t n, int filter){
+  if(filter == FILTER_CDF97){
+    scale(tile, n, CDF97_K, 1 / CDF97_K);
+    lift_even(tile, n, -CDF97_DELTA);
+    lift_odd(tile, n, -CDF97_GAMMA);
+    lift_even(tile, n, -CDF97_BETA);
+    lift_odd(tile, n, -CDF97_ALPHA);
+  }else{
+    lift_even(tile, n, -0.25);
+    lift_odd(tile, n, 0.5);
+  }
+}
+
+// copies up to TILE_LINES lines into the tile, the even positions of a line go to its first half if split is set
+static int gather(double* restrict tile, const double* restrict buf, const region_t* r, int dim, size_t first, size_t lines, int split, size_t* starts){
+  const size_t n = r->length[dim];
+  const size_t evens = (n + 1) / 2;
+  const size_t stride = r->stride[dim];
+  const int valid = lines - first < TILE_LINES ? (int) (lines - first) : TILE_LINES;
+  for(int l=0; l < valid; l++){
+    starts[l] = get_line_start(r, dim, first + l);
+  }
+  for(size_t i=0; i < n; i++){
+    const size_t row = split ? ((i & 1) ? evens + i / 2 : i / 2) : i;
+    for(int l=0; l < valid; l++){
+      tile[row * TILE_LINES + l] = buf[starts[l] + i * stride];
+    }
+  }
+  return valid;
+}
+
+static void scatter(double* restrict buf, const double* restrict tile, const region_t* r, int dim, int valid, int split, const size_t* starts){
+  const size_t n = r->length[dim];
+  const size_t evens = (n + 1) / 2;
+  const size_t stride = r->stride[dim];
+  for(size_t i=0; i < n; i++){
+    const size_t row = split ? ((i & 1) ? evens + i / 2 : i / 2) : i;
+    for(int l=0; l < valid; l++){
+      buf[starts[l] + i * stride] = tile[row * TILE_LINES + l];
+    }
+  }
+}
+
+static void transform_forward(double* restrict buf, const region_t* r, int dim, int filter, int threads){
+  const size_t n = r->length[dim];
+  if(n < 2){
+    return;
+  }
+  const size_t lines = get_line_count(r, dim);
+  const size_t tiles = (lines + TILE_LINES - 1) / TILE_LINES;
+  #pragma omp parallel num_threads(threads) if(threads > 1 && tiles > 1)
+  {
+    double* tile = (double*) scilU_safe_malloc(n * TILE_LINES * sizeof(double));
+    memset(tile, 0, n * TILE_LINES * sizeof(double));
+    size_t starts[TILE_LINES];
+    #pragma omp for
+    for(size_t t=0; t < tiles; t++){
+      const int valid = gather(tile, buf, r, dim, t * TILE_LINES, lines, 1, starts);
+      lift_forward(tile, n, filter);
+      scatter(buf, tile, r, dim, valid, 0, starts);
+    }
+    free(tile);
+  }
+}
+
+static void transform_inverse(double* restrict buf, const region_t* r, int dim, int filter){
+  const size_t n = r->length[dim];
+  if(n < 2){
+    return;
+  }
+  const size_t lines = get_line_count(r, dim);
+  const size_t tiles = (lines + TILE_LINES - 1) / TILE_LINES;
+  #pragma omp parallel if(tiles > 1)
+  {
+    double* tile = (double*) scilU_safe_malloc(n * TILE_LINES * sizeof(double));
+    memset(tile, 0, n * TILE_LINES * sizeof(double));
+    size_t starts[TILE_LINES];
+    #pragma omp for
+    for(size_t t=0; t < tiles; t++){
+      const int valid = gather(tile, buf, r, dim, t * TILE_LINES, lines, 0, starts);
+      lift_inverse(tile, n, filter);
+      scatter(buf, tile, r, dim, valid, 1, starts);
+    }
+    free(tile);
+  }
+}
+
+static void wavelet_forward(double* restrict buf, const scil_dims_t* dims, int levels, int filter, int threads){
+  for(int level=0; level < levels; level++){
+    region_t r;
+    get_region(& r, dims, level);
+    for(int d=0; d < dims->dims; d++){
+      transform_forward(buf, & r, d, filter, threads);
+    }
+  }
+}
+
+static void wavelet_inverse(double* restrict buf, const scil_dims_t* dims, int levels, int filter){
+  for(int level=levels - 1; level >= 0; level--){
+    region_t r;
+    get_region(& r, dims, level);
+    for(int d=dims->dims - 1; d >= 0; d--){
+      transform_inverse(buf, & r, d, filter);
+    }
+  }
+}
+
+static void dequantize(double* restrict buf, const uint64_t* restrict codes, size_t count, double step){
+  for(size_t i=0; i < count; i++){
+    buf[i] = (double) (int64_t) codes[i] * step;
+  }
+}
+
+static size_t pack_values(byte* restrict dest, const uint64_t* restrict values, size_t count){
+  uint64_t all = 0;
+  for(size_t i=0; i < count; i++){
+    all |= values[i];
+  }
+  const int max_bits = scil_bits_needed(all);
+  dest[0] = (byte) max_bits;
+  return 1 + scil_pfor_compress(dest + 1, values, count, max_bits);
+}
+
+static int unpack_values(uint64_t* restrict values, size_t count, const byte* restrict source, size_t source_size, size_t* parsed){
+  if(source_size < 1 || source[0] > 64){
+    return SCIL_BUFFER_ERR;
+  }
+  if(scil_pfor_decompress(values, count, source[0], source + 1, source_size - 1, parsed) != SCIL_NO_ERR){
+    return SCIL_BUFFER_ERR;
+  }
+  *parsed += 1;
+  return SCIL_NO_ERR;
+}
+
+//Repeat for each data type
+//Supported datatypes: float double
+
+// the filter with the smaller estimated coded size of the levels of segments spread over the data,
+// the shorter CDF 5/3 filter pays off for data with steps
+static int choose_filter_<DATATYPE>(const <DATATYPE>* restrict source, size_t count, int levels, double step){
+  const size_t n = count < FILTER_SEGMENT ? count : FILTER_SEGMENT;
+  if(n < 4){
+    return FILTER_CDF97;
+  }
+  double* sample = (double*) scilU_safe_malloc(3 * n * TILE_LINES * sizeof(double));
+  double* tile = sample + n * TILE_LINES;
+  double* low = tile + n * TILE_LINES;
+  for(int l=0; l < TILE_LINES; l++){
+    const size_t start = (count - n) / (TILE_LINES - 1) * (size_t) l;
+    for(size_t i=0; i < n; i++){
+      sample[i * TILE_LINES + l] = (double) source[start + i];
+    }
+  }
+  double cost[2];
+  for(int filter=0; filter < 2; filter++){
+    memcpy(tile, sample, n * TILE_LINES * sizeof(double));
+    size_t len = n;
+    for(int level=0; level < levels && len >= 4; level++){
+      // the positions are split into even and odd like by gather()
+      const size_t evens = (len + 1) / 2;
+      for(size_t i=0; i < len; i++){
+        memcpy(low + ((i & 1) ? evens + i / 2 : i / 2) * TILE_LINES, tile + i * TILE_LINES, TILE_LINES * sizeof(double));
+      }
+      lift_forward(low, len, filter);
+      memcpy(tile, low, len * TILE_LINES * sizeof(double));
+      len = evens;
+    }
+    cost[filter] = 0;
+    for(size_t i=0; i < n * TILE_LINES; i++){
+      cost[filter] += log2(1 + fabs(tile[i]) / step);
+    }
+  }
+  free(sample);
+  return cost[FILTER_CDF53] < cost[FILTER_CDF97] ? FILTER_CDF53 : FILTER_CDF97;
+}
+
+static <DATATYPE> correct_<DATATYPE>(<DATATYPE> value, uint64_t correction, double step){
+  return (<DATATYPE>) ((double) value + (double) (int64_t) scil_entropy_unzigzag(correction) * step);
+}
+
+// compresses with one filter, returns the compressed size or 0 if the tolerance cannot be kept
+static size_t compress_filter_<DATATYPE>(const scil_context_t* ctx, byte* restrict dest, const <DATATYPE>* restrict source, const scil_dims_t* dims, int filter, double correction_step){
+  const size_t count = scil_dims_get_count(dims);
+  const double tolerance = ctx->hints.absolute_tolerance;
+  const double step = COEFFICIENT_STEP * tolerance;
+  const int levels = get_level_count(dims);
+  size_t size = 0;
+
+  double* buf = (double*) scilU_safe_malloc(count * sizeof(double));
+  uint64_t* codes = (uint64_t*) scilU_safe_malloc(count * sizeof(uint64_t));
+  for(size_t i=0; i < count; i++){
+    buf[i] = (double) source[i];
+  }
+  wavelet_forward(buf, dims, levels, filter, ctx->hints.thread_count);
+  int ok = 1;
+  for(size_t i=0; i < count; i++){
+    const double q = round(buf[i] / step);
+    ok &= fabs(q) < 0x1p52;
+    codes[i] = (uint64_t) (int64_t) (ok ? q : 0);
+  }
+  size_t coefficients_size;
+  if(! ok || scil_rans_compress(ctx, dest + HEADER_SIZE, & coefficients_size, (byte*) codes, count * sizeof(uint64_t)) != SCIL_NO_ERR){
+    goto end;
+  }
+
+  // the reconstruction is computed like by the decompression, the points beyond the tolerance are corrected
+  dequantize(buf, codes, count, step);
+  wavelet_inverse(buf, dims, levels, filter);
+  // the positions and corrections trail the reads of the codes and the reconstruction
+  uint64_t* positions = codes;
+  uint64_t* corrections = (uint64_t*) buf;
+  size_t corrected = 0;
+  size_t last = 0;
+  for(size_t i=0; i < count; i++){
+    const <DATATYPE> value = (<DATATYPE>) buf[i];
+    if(fabs((double) value - (double) source[i]) <= tolerance){
+      continue;
+    }
+    const double k = round(((double) source[i] - (double) value) / correction_step);
+    corrections[corrected] = scil_entropy_zigzag((uint64_t) (int64_t) k);
+    if(! (fabs(k) < 0x1p52) || ! (fabs((double) correct_<DATATYPE>(value, corrections[corrected], correction_step) - (double) source[i]) <= tolerance)){
+      ok = 0;
+      break;
+    }
+    positions[corrected++] = i - last;
+    last = i;
+  }
+  if(ok){
+    size = HEADER_SIZE + coefficients_size;
+    size += pack_values(dest + size, positions, corrected);
+    size += pack_values(dest + size, corrections, corrected);
+
+    dest[0] = (byte) filter;
+    dest[1] = (byte) levels;
+    scilU_pack8((dest + 2), step);
+    scilU_pack8((dest + 10), correction_step);
+    scilU_pack8((dest + 18), coefficients_size);
+    scilU_pack8((dest + 26), corrected);
+  }
+
+end:
+  free(codes);
+  free(buf);
+  return size;
+}
+
+int scil_wavelets_compress_<DATATYPE>(const scil_context_t* ctx,
+                        byte * restrict dest,
+                        size_t* restrict dest_size,
+                        <DATATYPE>*restrict source,
+                        const scil_dims_t* dims)
+{
+  assert(dest != NULL);
+  assert(dest_size != NULL);
+  assert(source != NULL);
+  assert(dims != NULL);
+
+  const double tolerance = ctx->hints.absolute_tolerance;
+  const size_t count = scil_dims_get_count(dims);
+  if(tolerance <= SCIL_ACCURACY_DBL_IGNORE || count == 0){
+    return SCIL_PRECISION_ERR;
+  }
+  // the step leaves room for the rounding of the corrected values
+  double largest = 0;
+  for(size_t i=0; i < count; i++){
+    if(fabs((double) source[i]) > largest){
+      largest = fabs((double) source[i]);
+    }
+  }
+  const double correction_step = 2 * (tolerance - 2 * largest * (double) EPSILON_<DATATYPE_UPPER>);
+  if(! (correction_step > 0)){
+    return SCIL_PRECISION_ERR;
+  }
+
+  const int filter = choose_filter_<DATATYPE>(source, count, get_level_count(dims), COEFFICIENT_STEP * tolerance);
+  *dest_size = compress_filter_<DATATYPE>(ctx, dest, source, dims, filter, correction_step);
+  if(*dest_size == 0){
+    // the other filter may keep the tolerance
+    *dest_size = compress_filter_<DATATYPE>(ctx, dest, source, dims, filter == FILTER_CDF97 ? FILTER_CDF53 : FILTER_CDF97, correction_step);
+  }
+  return *dest_size > 0 ? SCIL_NO_ERR : SCIL_PRECISION_ERR;
+}
+
+int scil_wavelets_decompress_<DATATYPE>( <DATATYPE>*restrict data_out,
+                            scil_dims_t* dims,
+                            byte*restrict compressed_buf_in,
+                            const size_t in_size)
+{
+  assert(data_out != NULL);
+  assert(compressed_buf_in != NULL);
+  assert(dims != NULL);
+
+  if(in_size < HEADER_SIZE){
+    return SCIL_BUFFER_ERR;
+  }
+  const byte* in = compressed_buf_in;
+  const int filter = in[0];
+  const int levels = in[1];
+  double step, correction_step;
+  uint64_t coefficients_size, corrected;
+  scilU_unpack8((in + 2), & step);
+  scilU_unpack8((in + 10), & correction_step);
+  scilU_unpack8((in + 18), & coefficients_size);
+  scilU_unpack8((in + 26), & corrected);
+  const size_t count = scil_dims_get_count(dims);
+  if((filter != FILTER_CDF97 && filter != FILTER_CDF53) || levels > MAX_LEVELS || coefficients_size > in_size - HEADER_SIZE || corrected > count){
+    return SCIL_BUFFER_ERR;
+  }
+
+  uint64_t* codes = (uint64_t*) scilU_safe_malloc(count * sizeof(uint64_t));
+  double* buf = (double*) scilU_safe_malloc(count * sizeof(double));
+  size_t uncompressed;
+  int ret = scil_rans_decompress((byte*) codes, count * sizeof(uint64_t), in + HEADER_SIZE, coefficients_size, & uncompressed);
+  if(ret != SCIL_NO_ERR || uncompressed != count * sizeof(uint64_t)){
+    ret = SCIL_BUFFER_ERR;
+    goto end;
+  }
+  dequantize(buf, codes, count, step);
+  wavelet_inverse(buf, dims, levels, filter);
+  for(size_t i=0; i < count; i++){
+    data_out[i] = (<DATATYPE>) buf[i];
+  }
+
+  size_t pos = HEADER_SIZE + coefficients_size;
+  size_t parsed;
+  uint64_t* positions = codes;
+  uint64_t* corrections = (uint64_t*) buf;
+  ret = unpack_values(positions, corrected, in + pos, in_size - pos, & parsed);
+  if(ret == SCIL_NO_ERR){
+    pos += parsed;
+    ret = unpack_values(corrections, corrected, in + pos, in_size - pos, & parsed);
+  }
+  if(ret != SCIL_NO_ERR){
+    goto end;
+  }
+  size_t i = 0;
+  for(size_t c=0; c < corrected; c++){
+    i += positions[c];
+    if(i >= count){
+      ret = SCIL_BUFFER_ERR;
+      break;
+    }
+    data_out[i] = correct_<DATATYPE>(data_out[i], corrections[c], correction_step);
+  }
+
+end:
+  free(codes);
+  free(buf);
+  return ret;
+}
+// End repeat
+
+scilU_algorithm_t algo_wavelets = {
+    .c.DNtype = {
+        CREATE_INITIALIZER(scil_wavelets)
+    },
+    "wavelets",
+    11,
+    SCIL_COMPRESSOR_TYPE_DATATYPES,
+    1
+};
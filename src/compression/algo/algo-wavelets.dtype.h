@@ -13,18 +13,22 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
 
+//Supported datatypes: float double
+
+#ifndef SCIL_WAVELETS_H_
+#define SCIL_WAVELETS_H_
+
 /**
  * \file
- * \brief Header containing gzip of the Scientific Compression Interface Library
+ * \brief Wavelet compression with the absolute tolerance
  * \author Julian Kunkel <juliankunkel@googlemail.com>
  * \author Armin Schaare <3schaare@informatik.uni-hamburg.de>
+ *
+ * The data is decomposed by the lifting scheme of the CDF 9/7 or the CDF 5/3 wavelet along every dimension,
+ * whichever yields the smaller output. The coefficients are quantized uniformly and coded with rANS.
+ * The points whose reconstruction exceeds the tolerance are corrected explicitly.
  */
 
-//Supported datatypes: float double
-
-#ifndef SCIL_WAVELETS_H_
-#define SCIL_WAVELETS_H_
-
 #include <scil-algorithm-impl.h>
 
 // Repeat for each data type
@@ -19,7 +19,8 @@
 
 #include <scil-util.h>
 
-#include <zfp.h>
+#include <scil-zfp.h>
+#include <scil-statistics.h>
 
 static int read_header(const byte* source,
                         size_t source_size,
@@ -83,14 +84,14 @@ int scil_zfp_abstol_compress_<DATATYPE>(const scil_context_t* ctx,
     double abs_tol = (ctx->hints.absolute_tolerance == SCIL_ACCURACY_DBL_FINEST) ? 0 : ctx->hints.absolute_tolerance;
 
     if (ctx->hints.fill_value != DBL_MAX){
+      // Finding minimum and maximum values in data
+      scilU_statistics_<DATATYPE>_t statistics;
+      scil_get_statistics_<DATATYPE>(ctx, source, count, & statistics);
+
       in = (<DATATYPE>*)scilU_safe_malloc(count * sizeof(<DATATYPE>));
       memcpy(in, source, count * sizeof(<DATATYPE>));
 
-      // Finding minimum and maximum values in data
-      <DATATYPE> min, max;
-      scilU_find_minimum_maximum_with_excluded_points_<DATATYPE>(in, count, &min, &max, ctx->hints.lossless_data_range_up_to,  ctx->hints.lossless_data_range_from, ctx->hints.fill_value);
-
-      next_free_number = max + 2 * abs_tol;
+      next_free_number = statistics.maximum + 2 * abs_tol;
 
       const <DATATYPE> fill_value_d = (<DATATYPE>) ctx->hints.fill_value;
       const <DATATYPE> next_free_d = (<DATATYPE>)next_free_number;
@@ -108,12 +109,7 @@ int scil_zfp_abstol_compress_<DATATYPE>(const scil_context_t* ctx,
     // Compress
     zfp_field* field = NULL;
 
-    switch(dims->dims){
-        case 1: field = zfp_field_1d(in, zfp_type_<DATATYPE>, dims->length[0]); break;
-        case 2: field = zfp_field_2d(in, zfp_type_<DATATYPE>, dims->length[0], dims->length[1]); break;
-        case 3: field = zfp_field_3d(in, zfp_type_<DATATYPE>, dims->length[0], dims->length[1], dims->length[2]); break;
-        default: field = zfp_field_1d(in, zfp_type_<DATATYPE>, scil_dims_get_count(dims));
-    }
+    field = scil_zfp_field(in, zfp_type_<DATATYPE>, dims);
 
     zfp_stream* zfp = zfp_stream_open(NULL);
 
@@ -121,6 +117,8 @@ int scil_zfp_abstol_compress_<DATATYPE>(const scil_context_t* ctx,
     /*  zfp_stream_set_precision(zfp, precision, type); */
     zfp_stream_set_accuracy(zfp, ctx->hints.absolute_tolerance);
 
+    scil_zfp_set_execution(zfp, ctx);
+
     size_t bufsize = zfp_stream_maximum_size(zfp, field);
     bitstream* stream = stream_open(dest, bufsize);
     zfp_stream_set_bit_stream(zfp, stream);
@@ -162,12 +160,7 @@ int scil_zfp_abstol_decompress_<DATATYPE>( <DATATYPE>*restrict data_out,
     // Decompress
     zfp_field* field = NULL;
 
-    switch(dims->dims){
-        case 1: field = zfp_field_1d(data_out, zfp_type_<DATATYPE>, dims->length[0]); break;
-        case 2: field = zfp_field_2d(data_out, zfp_type_<DATATYPE>, dims->length[0], dims->length[1]); break;
-        case 3: field = zfp_field_3d(data_out, zfp_type_<DATATYPE>, dims->length[0], dims->length[1], dims->length[2]); break;
-        default: field = zfp_field_1d(data_out, zfp_type_<DATATYPE>, count);
-    }
+    field = scil_zfp_field(data_out, zfp_type_<DATATYPE>, dims);
 
     zfp_stream* zfp = zfp_stream_open(NULL);
 
@@ -19,7 +19,7 @@
 
 #include <algo/algo-zfp-precision.h>
 
-#include <zfp.h>
+#include <scil-zfp.h>
 
 #include <scil-util.h>
 
@@ -65,12 +65,7 @@ int scil_zfp_precision_compress_<DATATYPE>(const scil_context_t* ctx,
     zfp_field* field = NULL;
     size_t count = scil_dims_get_count(dims);
 
-    switch(dims->dims){
-        case 1: field = zfp_field_1d(source, zfp_type_<DATATYPE>, dims->length[0]); break;
-        case 2: field = zfp_field_2d(source, zfp_type_<DATATYPE>, dims->length[0], dims->length[1]); break;
-        case 3: field = zfp_field_3d(source, zfp_type_<DATATYPE>, dims->length[0], dims->length[1], dims->length[2]); break;
-        default: field = zfp_field_1d(source, zfp_type_<DATATYPE>, count);
-    }
+    field = scil_zfp_field(source, zfp_type_<DATATYPE>, dims);
 
     // determine number of bits for the exponent
     uint8_t minimum_sign, maximum_sign;
@@ -101,6 +96,8 @@ int scil_zfp_precision_compress_<DATATYPE>(const scil_context_t* ctx,
     uint actual_precision = zfp_stream_set_precision(zfp, precision);
     //assert(actual_precision == precision);
 
+    scil_zfp_set_execution(zfp, ctx);
+
     size_t bufsize = zfp_stream_maximum_size(zfp, field);
     bitstream* stream = stream_open(dest, bufsize);
     zfp_stream_set_bit_stream(zfp, stream);
@@ -133,12 +130,7 @@ int scil_zfp_precision_decompress_<DATATYPE>(   <DATATYPE>*restrict data_out,
     // Decompress
     zfp_field* field = NULL;
 
-    switch(dims->dims){
-        case 1: field = zfp_field_1d(data_out, zfp_type_<DATATYPE>, dims->length[0]); break;
-        case 2: field = zfp_field_2d(data_out, zfp_type_<DATATYPE>, dims->length[0], dims->length[1]); break;
-        case 3: field = zfp_field_3d(data_out, zfp_type_<DATATYPE>, dims->length[0], dims->length[1], dims->length[2]); break;
-        default: field = zfp_field_1d(data_out, zfp_type_<DATATYPE>, scil_dims_get_count(dims));
-    }
+    field = scil_zfp_field(data_out, zfp_type_<DATATYPE>, dims);
 
     zfp_stream* zfp = zfp_stream_open(NULL);
 
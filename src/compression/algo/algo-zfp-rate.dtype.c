@@ -0,0 +1,148 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-zfp-rate.h>
+
+#include <scil-zfp.h>
+#include <scil-util.h>
+
+#define HEADER_SIZE 8
+
+// the number of blocks of the field created by scil_zfp_field()
+static size_t block_count(const scil_dims_t* dims){
+  const int field_dims = scil_zfp_field_dims(dims);
+  if(field_dims != dims->dims){
+    return (scil_dims_get_count(dims) + 3) / 4;
+  }
+  size_t blocks = 1;
+  for(int i=0; i < field_dims; i++){
+    blocks *= (dims->length[i] + 3) / 4;
+  }
+  return blocks;
+}
+
+//Supported datatypes: float double
+// Repeat for each data type
+
+int scil_zfp_rate_compress_<DATATYPE>(const scil_context_t* ctx,
+                        byte * restrict dest,
+                        size_t* restrict dest_size,
+                        <DATATYPE>*restrict source,
+                        const scil_dims_t* dims)
+{
+    if(ctx->hints.fixed_rate <= 0){
+      return SCIL_EINVAL;
+    }
+    double rate = ctx->hints.fixed_rate > <DATATYPE_SIZE> ? <DATATYPE_SIZE> : ctx->hints.fixed_rate;
+    scilU_pack8(dest, rate);
+
+    zfp_field* field = scil_zfp_field(source, zfp_type_<DATATYPE>, dims);
+    zfp_stream* zfp = zfp_stream_open(NULL);
+    zfp_stream_set_rate(zfp, rate, zfp_type_<DATATYPE>, scil_zfp_field_dims(dims), 1);
+    scil_zfp_set_execution(zfp, ctx);
+
+    size_t bufsize = zfp_stream_maximum_size(zfp, field);
+    bitstream* stream = stream_open(dest + HEADER_SIZE, bufsize);
+    zfp_stream_set_bit_stream(zfp, stream);
+    zfp_stream_rewind(zfp);
+
+    size_t size = zfp_compress(zfp, field);
+    *dest_size = HEADER_SIZE + size;
+
+    zfp_field_free(field);
+    zfp_stream_close(zfp);
+    stream_close(stream);
+
+    return size == 0 ? SCIL_UNKNOWN_ERR : SCIL_NO_ERR;
+}
+
+int scil_zfp_rate_decompress_<DATATYPE>( <DATATYPE>*restrict data_out,
+                            scil_dims_t* dims,
+                            byte*restrict compressed_buf_in,
+                            const size_t in_size)
+{
+    if(in_size < HEADER_SIZE){
+      return SCIL_BUFFER_ERR;
+    }
+    double rate;
+    scilU_unpack8(compressed_buf_in, & rate);
+
+    zfp_field* field = scil_zfp_field(data_out, zfp_type_<DATATYPE>, dims);
+    zfp_stream* zfp = zfp_stream_open(NULL);
+    zfp_stream_set_rate(zfp, rate, zfp_type_<DATATYPE>, scil_zfp_field_dims(dims), 1);
+
+    bitstream* stream = stream_open(compressed_buf_in + HEADER_SIZE, in_size - HEADER_SIZE);
+    zfp_stream_set_bit_stream(zfp, stream);
+    zfp_stream_rewind(zfp);
+
+    size_t size = zfp_decompress(zfp, field);
+
+    zfp_field_free(field);
+    zfp_stream_close(zfp);
+    stream_close(stream);
+
+    return size == 0 ? SCIL_BUFFER_ERR : SCIL_NO_ERR;
+}
+
+int scil_zfp_rate_decompress_block_<DATATYPE>(<DATATYPE>*restrict block,
+                            const scil_dims_t* dims,
+                            const byte*restrict compressed_buf_in,
+                            const size_t in_size,
+                            size_t block_index)
+{
+    if(in_size < HEADER_SIZE || block_index >= block_count(dims)){
+      return SCIL_EINVAL;
+    }
+    double rate;
+    scilU_unpack8(compressed_buf_in, & rate);
+
+    const int field_dims = scil_zfp_field_dims(dims);
+    zfp_stream* zfp = zfp_stream_open(NULL);
+    zfp_stream_set_rate(zfp, rate, zfp_type_<DATATYPE>, field_dims, 1);
+    // each block is padded to maxbits in fixed-rate mode
+    const size_t offset = block_index * zfp->maxbits;
+    if(offset + zfp->maxbits > 8 * (in_size - HEADER_SIZE)){
+      zfp_stream_close(zfp);
+      return SCIL_BUFFER_ERR;
+    }
+
+    bitstream* stream = stream_open((void*) (compressed_buf_in + HEADER_SIZE), in_size - HEADER_SIZE);
+    zfp_stream_set_bit_stream(zfp, stream);
+    stream_rseek(stream, offset);
+
+    switch(field_dims){
+      case 2: zfp_decode_block_<DATATYPE>_2(zfp, block); break;
+      case 3: zfp_decode_block_<DATATYPE>_3(zfp, block); break;
+      case 4: zfp_decode_block_<DATATYPE>_4(zfp, block); break;
+      default: zfp_decode_block_<DATATYPE>_1(zfp, block);
+    }
+
+    zfp_stream_close(zfp);
+    stream_close(stream);
+
+    return SCIL_NO_ERR;
+}
+
+// End repeat
+
+scilU_algorithm_t algo_zfp_rate = {
+    .c.DNtype = {
+        CREATE_INITIALIZER(scil_zfp_rate)
+    },
+    "zfp-rate",
+    28,
+    SCIL_COMPRESSOR_TYPE_DATATYPES,
+    1
+};
@@ -0,0 +1,60 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_ZFP_RATE_H_
+#define SCIL_ZFP_RATE_H_
+
+/**
+ * \file
+ * \brief zfp in fixed-rate mode, each block of 4^d values occupies the same number of bits.
+ *
+ * The fixed_rate hint sets the bits per value, rates above the width of the type are capped.
+ * The rate bounds the size only, zfp-rate guarantees no precision: the error depends on the data
+ * and may exceed the tolerance hints, hence, it must be forced explicitly and is never chosen automatically.
+ * As the blocks are aligned to 64-bit words, any block can be decoded
+ * from its offset without touching the others, see scil_zfp_rate_decompress_block_<DATATYPE>().
+ * Layout: the rate (8 bytes), the zfp stream.
+ */
+
+#include <scil-algorithm-impl.h>
+
+//Supported datatypes: float double
+// Repeat for each data type
+
+/**
+ * \brief Compresses with fixed_rate bits per value and thread_count threads
+ * \return SCIL_EINVAL if the rate is not set
+ */
+int scil_zfp_rate_compress_<DATATYPE>(const scil_context_t* ctx, byte* restrict dest, size_t* restrict dest_size, <DATATYPE>*restrict source, const scil_dims_t* dims);
+
+int scil_zfp_rate_decompress_<DATATYPE>( <DATATYPE>*restrict data_out, scil_dims_t* dims, byte*restrict compressed_buf_in, const size_t in_size);
+
+/**
+ * \brief Decodes a single block of the data compressed by zfp-rate
+ *
+ * The blocks are numbered in the order zfp traverses them, i.e., the block containing the element at (x, y, z)
+ * has the index x/4 + bx * (y/4 + by * z/4) with bx and by being the number of blocks in the first two dimensions.
+ * Data that zfp cannot map to its dimensions is treated as 1D.
+ * \param block Receives the 4^d values of the block with x varying fastest,
+ * values beyond the borders of the data are padding.
+ * \param compressed_buf_in The output of the compression without the chain header
+ * \return SCIL_EINVAL if the block does not exist
+ */
+int scil_zfp_rate_decompress_block_<DATATYPE>(<DATATYPE>*restrict block, const scil_dims_t* dims, const byte*restrict compressed_buf_in, const size_t in_size, size_t block_index);
+// End repeat
+
+extern scilU_algorithm_t algo_zfp_rate;
+
+#endif /* SCIL_ZFP_RATE_H_ */
@@ -0,0 +1,84 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/algo-zfp-reversible.h>
+
+#include <scil-zfp.h>
+
+// the zfp names of the integer types
+#define zfp_type_int32_t zfp_type_int32
+#define zfp_type_int64_t zfp_type_int64
+
+//Supported datatypes: float double int32_t int64_t
+// Repeat for each data type
+
+int scil_zfp_reversible_compress_<DATATYPE>(const scil_context_t* ctx,
+                        byte * restrict dest,
+                        size_t* restrict dest_size,
+                        <DATATYPE>*restrict source,
+                        const scil_dims_t* dims)
+{
+    zfp_field* field = scil_zfp_field(source, zfp_type_<DATATYPE>, dims);
+    zfp_stream* zfp = zfp_stream_open(NULL);
+    zfp_stream_set_reversible(zfp);
+    scil_zfp_set_execution(zfp, ctx);
+
+    size_t bufsize = zfp_stream_maximum_size(zfp, field);
+    bitstream* stream = stream_open(dest, bufsize);
+    zfp_stream_set_bit_stream(zfp, stream);
+    zfp_stream_rewind(zfp);
+
+    *dest_size = zfp_compress(zfp, field);
+
+    zfp_field_free(field);
+    zfp_stream_close(zfp);
+    stream_close(stream);
+
+    return *dest_size == 0 ? SCIL_UNKNOWN_ERR : SCIL_NO_ERR;
+}
+
+int scil_zfp_reversible_decompress_<DATATYPE>( <DATATYPE>*restrict data_out,
+                            scil_dims_t* dims,
+                            byte*restrict compressed_buf_in,
+                            const size_t in_size)
+{
+    zfp_field* field = scil_zfp_field(data_out, zfp_type_<DATATYPE>, dims);
+    zfp_stream* zfp = zfp_stream_open(NULL);
+    zfp_stream_set_reversible(zfp);
+
+    bitstream* stream = stream_open(compressed_buf_in, in_size);
+    zfp_stream_set_bit_stream(zfp, stream);
+    zfp_stream_rewind(zfp);
+
+    size_t size = zfp_decompress(zfp, field);
+
+    zfp_field_free(field);
+    zfp_stream_close(zfp);
+    stream_close(stream);
+
+    return size == 0 ? SCIL_BUFFER_ERR : SCIL_NO_ERR;
+}
+
+// End repeat
+
+scilU_algorithm_t algo_zfp_reversible = {
+    .c.DNtype = {
+        CREATE_INITIALIZER(scil_zfp_reversible)
+    },
+    "zfp-reversible",
+    29,
+    SCIL_COMPRESSOR_TYPE_DATATYPES,
+    0
+};
@@ -0,0 +1,39 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_ZFP_REVERSIBLE_H_
+#define SCIL_ZFP_REVERSIBLE_H_
+
+/**
+ * \file
+ * \brief zfp in reversible mode, a lossless compressor that exploits the smoothness in up to four dimensions.
+ */
+
+#include <scil-algorithm-impl.h>
+
+//Supported datatypes: float double int32_t int64_t
+// Repeat for each data type
+
+/**
+ * \brief Compresses with thread_count threads
+ */
+int scil_zfp_reversible_compress_<DATATYPE>(const scil_context_t* ctx, byte* restrict dest, size_t* restrict dest_size, <DATATYPE>*restrict source, const scil_dims_t* dims);
+
+int scil_zfp_reversible_decompress_<DATATYPE>( <DATATYPE>*restrict data_out, scil_dims_t* dims, byte*restrict compressed_buf_in, const size_t in_size);
+// End repeat
+
+extern scilU_algorithm_t algo_zfp_reversible;
+
+#endif /* SCIL_ZFP_REVERSIBLE_H_ */
@@ -1,115 +1,194 @@
 // Huffman code implementation
-// Used as prefix for SCIL allquant algorithm
+// Used as prefix for SCIL allquant algorithm and by the huffman entropy coder
 // Author: Oliver Pola <5pola@informatik.uni-hamburg.de>
 
 #include <algo/huffman.h>
 #include <scil-util.h>
 
-typedef struct huffman_node huffman_node;
-struct huffman_node {
-  huffman_entity* entity;
-  // don't want to create entities for "virtual" ones, so copy the count
-  size_t count;
-  huffman_node* queue_next;
-  huffman_node* tree_left;
-  huffman_node* tree_right;
-};
-
-void huffman_enqueue(huffman_node** queue, int* queuecount,
-                     huffman_node* newnode) {
-  huffman_node* pre = NULL;
-  huffman_node* post = *queue;
-  while(post != NULL && post->count < newnode->count) {
-    pre = post;
-    post = post->queue_next;
-  }
-  // post points to entry with count >= newnode->count
-  // pre points to entry before
-  newnode->queue_next = post;
-  if(pre == NULL)
-    *queue = newnode;
-  else
-    pre->queue_next = newnode;
-  (*queuecount)++;
+#include <string.h>
+
+typedef struct huffman_node {
+  uint64_t count;
+  // leaves are numbered before the inner nodes, ties are broken by the number
+  uint32_t node;
+} huffman_node;
+
+typedef struct huffman_leaf {
+  uint64_t count;
+  uint32_t symbol;
+} huffman_leaf;
+
+static inline int huffman_less(const huffman_node a, const huffman_node b) {
+  return a.count < b.count || (a.count == b.count && a.node < b.node);
+}
+
+static void huffman_sift_down(huffman_node* heap, size_t heapcount, size_t pos) {
+  huffman_node item = heap[pos];
+  while(2 * pos + 1 < heapcount) {
+    size_t child = 2 * pos + 1;
+    if(child + 1 < heapcount && huffman_less(heap[child + 1], heap[child]))
+      child++;
+    if(! huffman_less(heap[child], item))
+      break;
+    heap[pos] = heap[child];
+    pos = child;
+  }
+  heap[pos] = item;
 }
 
-huffman_node* huffman_dequeue(huffman_node** queue, int* queuecount) {
-  huffman_node* result = *queue;
-  *queue = result->queue_next;
-  result->queue_next = NULL;
-  (*queuecount)--;
+static huffman_node huffman_pop(huffman_node* heap, size_t* heapcount) {
+  huffman_node result = heap[0];
+  (*heapcount)--;
+  heap[0] = heap[*heapcount];
+  huffman_sift_down(heap, *heapcount, 0);
   return result;
 }
 
-void huffman_tree_traverse(huffman_node* node,
-                      uint8_t  bitmask, uint8_t bitvalue, uint8_t bitcount) {
-  if(node->tree_left == NULL || node->tree_right == NULL) {
-    node->entity->bitmask = bitmask;
-    node->entity->bitvalue = bitvalue;
-    node->entity->bitcount = bitcount;
-  } else {
-    bitcount++;
-    uint8_t shifts = 8 - bitcount;
-    uint8_t one = 1 << shifts;
-    bitmask = bitmask | one;
-    huffman_tree_traverse(node->tree_left, bitmask, bitvalue, bitcount);
-    bitvalue = bitvalue | one;
-    huffman_tree_traverse(node->tree_right, bitmask, bitvalue, bitcount);
+// most frequent symbols first, they get the shortest codes
+static int huffman_leaf_compare(const void* pa, const void* pb) {
+  const huffman_leaf* a = (const huffman_leaf*) pa;
+  const huffman_leaf* b = (const huffman_leaf*) pb;
+  if(a->count != b->count)
+    return a->count > b->count ? -1 : 1;
+  return a->symbol < b->symbol ? -1 : (a->symbol > b->symbol);
+}
+
+void huffman_code_lengths(const uint64_t* counts, size_t size, int max_length, uint8_t* lengths) {
+  memset(lengths, 0, size);
+  size_t used = 0;
+  for(size_t i = 0; i < size; i++) {
+    used += counts[i] > 0;
+  }
+  if(used == 0) return;
+
+  huffman_leaf* leaves = (huffman_leaf*)scilU_safe_malloc(used * sizeof(huffman_leaf));
+  used = 0;
+  for(size_t i = 0; i < size; i++) {
+    if(counts[i] > 0) {
+      leaves[used].count = counts[i];
+      leaves[used].symbol = (uint32_t) i;
+      used++;
+    }
+  }
+  if(used == 1) {
+    lengths[leaves[0].symbol] = 1;
+    free(leaves);
+    return;
+  }
+  qsort(leaves, used, sizeof(huffman_leaf), huffman_leaf_compare);
+
+  // pick the two least frequent nodes and combine them to a new inner node,
+  // each inner node is created after its children, the last one is the root
+  const size_t nodecount = 2 * used - 1;
+  huffman_node* heap = (huffman_node*)scilU_safe_malloc(used * sizeof(huffman_node));
+  uint32_t* parent = (uint32_t*)scilU_safe_malloc(nodecount * sizeof(uint32_t));
+  size_t heapcount = used;
+  for(size_t i = 0; i < used; i++) {
+    heap[i].count = leaves[i].count;
+    heap[i].node = (uint32_t) i;
+  }
+  for(size_t i = used / 2; i-- > 0; ) {
+    huffman_sift_down(heap, heapcount, i);
+  }
+  uint32_t next = (uint32_t) used;
+  while(heapcount > 1) {
+    huffman_node left = huffman_pop(heap, &heapcount);
+    huffman_node right = heap[0];
+    parent[left.node] = next;
+    parent[right.node] = next;
+    heap[0].count = left.count + right.count;
+    heap[0].node = next;
+    huffman_sift_down(heap, heapcount, 0);
+    next++;
+  }
+
+  // the depth of a node follows from its parent, which has a larger number
+  uint32_t* depth = parent;
+  depth[nodecount - 1] = 0;
+  unsigned length_count[33] = {0};
+  for(size_t i = nodecount - 1; i-- > 0; ) {
+    depth[i] = depth[parent[i]] + 1;
+    if(i < used) {
+      length_count[depth[i] < (uint32_t) max_length ? depth[i] : (uint32_t) max_length]++;
+    }
+  }
+
+  // limit the code length: truncated codes violate the Kraft inequality,
+  // each step moves one leaf from max_length below a shorter leaf until the sum matches
+  uint64_t kraft = 0;
+  for(int l = 1; l <= max_length; l++) {
+    kraft += (uint64_t) length_count[l] << (max_length - l);
   }
+  while(kraft > ((uint64_t) 1 << max_length)) {
+    length_count[max_length]--;
+    for(int l = max_length - 1; l > 0; l--) {
+      if(length_count[l] > 0) {
+        length_count[l]--;
+        length_count[l + 1] += 2;
+        break;
+      }
+    }
+    kraft--;
+  }
+
+  size_t leaf = 0;
+  for(int l = 1; l <= max_length; l++) {
+    for(unsigned i = 0; i < length_count[l]; i++) {
+      lengths[leaves[leaf++].symbol] = (uint8_t) l;
+    }
+  }
+
+  free(parent);
+  free(heap);
+  free(leaves);
 }
 
-void huffman_tree_delete(huffman_node* node) {
-  if(node == NULL) return;
-  huffman_tree_delete(node->tree_left);
-  huffman_tree_delete(node->tree_right);
-  free(node);
+void huffman_canonical_codes(const uint8_t* lengths, size_t size, uint32_t* codes) {
+  unsigned length_count[33] = {0};
+  uint32_t next_code[34];
+  for(size_t i = 0; i < size; i++) {
+    length_count[lengths[i]]++;
+  }
+  length_count[0] = 0;
+  uint32_t code = 0;
+  for(int l = 1; l <= 32; l++) {
+    code = (code + length_count[l - 1]) << 1;
+    next_code[l] = code;
+  }
+  for(size_t i = 0; i < size; i++) {
+    codes[i] = lengths[i] > 0 ? next_code[lengths[i]]++ : 0;
+  }
 }
 
 void huffman_encode(huffman_entity* entities, size_t size) {
   if(size < 1) return;
 
-  // the priority queue of nodes to be added to the tree
-  // sorted by least count first
-  huffman_node* queue = NULL;
-  int queuecount = 0;
+  uint64_t counts[256];
+  uint8_t lengths[256];
+  uint32_t codes[256];
+  size_t used = 0;
+  for(size_t i = 0; i < size; i++) {
+    counts[i] = entities[i].count;
+    used += counts[i] > 0;
+  }
+  huffman_code_lengths(counts, size, 8, lengths);
+  huffman_canonical_codes(lengths, size, codes);
 
-  // enqueue all given entitiies
   for(size_t i = 0; i < size; i++) {
-    if(entities[i].count > 0) {
-      huffman_node* newnode = (huffman_node*)scilU_safe_malloc(sizeof(huffman_node));
-      newnode->entity = &entities[i];
-      newnode->count = entities[i].count;
-      newnode->queue_next = NULL;
-      newnode->tree_left = NULL;
-      newnode->tree_right = NULL;
-      huffman_enqueue(&queue, &queuecount, newnode);
-    } else {
+    if(entities[i].count == 0) {
       entities[i].bitmask = 0;
       entities[i].bitvalue = 1; // will never fit, masked with 0
       entities[i].bitcount = 0;
+    } else if(used == 1) {
+      // the only entity does not need any prefix
+      entities[i].bitmask = 0;
+      entities[i].bitvalue = 0;
+      entities[i].bitcount = 0;
+    } else {
+      const int shifts = 8 - lengths[i];
+      entities[i].bitmask = (uint8_t) (0xFF << shifts);
+      entities[i].bitvalue = (uint8_t) (codes[i] << shifts);
+      entities[i].bitcount = lengths[i];
     }
   }
-
-  // stupid idea: all may have had count = 0
-  if(queuecount == 0) return;
-
-  // pick first two and combine to new "virtual" node
-  while(queuecount > 1) {
-    huffman_node* left = huffman_dequeue(&queue, &queuecount);
-    huffman_node* right = huffman_dequeue(&queue, &queuecount);
-    huffman_node* merge = (huffman_node*)scilU_safe_malloc(sizeof(huffman_node));
-    merge->entity = NULL;
-    merge->count = left->count + right->count;
-    merge->queue_next = NULL;
-    merge->tree_left = left;
-    merge->tree_right = right;
-    huffman_enqueue(&queue, &queuecount, merge);
-  }
-
-  // now there is only one left in queue, that's parent of huffman tree
-  // traverse and generate bitpatterns
-  huffman_tree_traverse(queue, 0, 0, 0);
-
-  // cleanup
-  huffman_tree_delete(queue);
 }
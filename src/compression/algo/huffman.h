@@ -1,5 +1,5 @@
 // Huffman code implementation
-// Used as prefix for SCIL allquant algorithm
+// Used as prefix for SCIL allquant algorithm and by the huffman entropy coder
 // Author: Oliver Pola <5pola@informatik.uni-hamburg.de>
 
 #ifndef HUFFMAN_H
@@ -16,8 +16,17 @@ typedef struct huffman_entity {
   uint8_t bitcount;
 } huffman_entity;
 
-// pre: data, count is set (count = 0 is allowed)
-// post: bitmask, bitvalue, bitcount will be set
+// pre: data, count is set (count = 0 is allowed), size <= 256
+// post: bitmask, bitvalue, bitcount will be set to a canonical code of at most 8 bits
 void huffman_encode(huffman_entity* entities, size_t size);
 
+// Computes the code lengths of a Huffman code limited to max_length bits.
+// Symbols with count 0 get length 0, a single used symbol gets length 1.
+// pre: the number of used symbols is at most 2^max_length, max_length <= 32
+void huffman_code_lengths(const uint64_t* counts, size_t size, int max_length, uint8_t* lengths);
+
+// Assigns the canonical codes for the given lengths, i.e., shorter codes come first
+// and codes of the same length increase with the symbol.
+void huffman_canonical_codes(const uint8_t* lengths, size_t size, uint32_t* codes);
+
 #endif // HUFFMAN_H
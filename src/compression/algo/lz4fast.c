@@ -14,37 +14,130 @@
 // along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <algo/lz4fast.h>
+#include <scil-blocks.h>
 
+#include <pthread.h>
 #include <string.h>
 #include <lz4/lz4.h>
+#include <lz4/lz4hc.h>
 
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-int scil_lz4fast_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
-    int size;
-    // store the size of the data
-    *((int*) dest) = source_size;
-    // normal compression, not fast
-    size = LZ4_compress_fast((const char *) (source), (char *) dest + 4, source_size, 2*source_size, 4);
-    *out_size = size + 4;
+#define SCIL_LZ4_DEFAULT_ACCELERATION 4
+
+// the HC state is large, therefore, each thread reuses its own, which is freed when the thread exits
+static pthread_key_t hc_state_key;
+static pthread_once_t hc_state_once = PTHREAD_ONCE_INIT;
+
+static void create_hc_state_key(void){
+  pthread_key_create(& hc_state_key, free);
+}
+
+static void * get_hc_state(void){
+  pthread_once(& hc_state_once, create_hc_state_key);
+  void * state = pthread_getspecific(hc_state_key);
+  if(state == NULL){
+    state = scilU_safe_malloc(LZ4_sizeofStateHC());
+    pthread_setspecific(hc_state_key, state);
+  }
+  return state;
+}
+
+static size_t lz4_compress_block(const scil_context_t* ctx, byte* restrict dest, size_t dest_capacity, const byte* restrict source, size_t source_size){
+  int acceleration = SCIL_LZ4_DEFAULT_ACCELERATION;
+  if(ctx != NULL && ctx->hints.byte_compression_level > 0){
+    acceleration = ctx->hints.byte_compression_level;
+  }
+  return LZ4_compress_fast((const char *) source, (char *) dest, source_size, dest_capacity, acceleration);
+}
+
+static size_t lz4hc_compress_level(int level, byte* restrict dest, size_t dest_capacity, const byte* restrict source, size_t source_size){
+  return LZ4_compress_HC_extStateHC(get_hc_state(), (const char *) source, (char *) dest, source_size, dest_capacity, level);
+}
+
+static size_t lz4hc_compress_block(const scil_context_t* ctx, byte* restrict dest, size_t dest_capacity, const byte* restrict source, size_t source_size){
+  int level = LZ4HC_CLEVEL_DEFAULT;
+  if(ctx != NULL && ctx->hints.byte_compression_level > 0){
+    level = ctx->hints.byte_compression_level;
+  }
+  return lz4hc_compress_level(level, dest, dest_capacity, source, source_size);
+}
+
+static size_t lz4hc12_compress_block(const scil_context_t* ctx, byte* restrict dest, size_t dest_capacity, const byte* restrict source, size_t source_size){
+  return lz4hc_compress_level(LZ4HC_CLEVEL_MAX, dest, dest_capacity, source, source_size);
+}
+
+static int lz4_decompress_block(byte* restrict dest, size_t dest_size, const byte* restrict src, size_t src_size){
+  int size = LZ4_decompress_safe((const char *) src, (char *) dest, src_size, dest_size);
+  if(size < 0 || (size_t) size != dest_size){
+    debug("Error in lz4 decompression: %d\n", size);
+    return SCIL_UNKNOWN_ERR;
+  }
+  return SCIL_NO_ERR;
+}
+
+static size_t lz4_bound(size_t source_size){
+  return LZ4_compressBound(source_size);
+}
+
+static const scil_block_codec_t lz4_codec = {
+  lz4_compress_block,
+  lz4_decompress_block,
+  lz4_bound
+};
+
+// all variants share the block format and the decoder
+static const scil_block_codec_t lz4hc_codec = {
+  lz4hc_compress_block,
+  lz4_decompress_block,
+  lz4_bound
+};
+
+static const scil_block_codec_t lz4hc12_codec = {
+  lz4hc12_compress_block,
+  lz4_decompress_block,
+  lz4_bound
+};
 
-    if (size == 0){
-      return -1;
-    }
+// the single LZ4 block written before the block format, decoded for streams without the chain format flag
+static int lz4_v1_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out){
+  int32_t size;
+  if(in_size < 4){
+    return SCIL_BUFFER_ERR;
+  }
+  scilU_unpack4(src, & size);
+  if(size < 0 || (size_t) size > buff_size){
+    return SCIL_BUFFER_ERR;
+  }
+  int ret = lz4_decompress_block(dest, size, src + 4, in_size - 4);
+  *uncomp_size_out = size;
+  return ret;
+}
 
-    return 0;
+int scil_lz4fast_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
+  return scil_blocks_compress(ctx, & lz4_codec, dest, out_size, source, source_size);
 }
 
-#pragma GCC diagnostic ignored "-Wunused-parameter"
 int scil_lz4fast_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out){
-    int size;
-    // retrieve the size of the uncompressed data
-    size = *((int*) src);
-    *uncomp_size_out = size;
-    size = LZ4_decompress_fast((const char *) src + 4, (char *)  dest, size); // LZ4_decompress_safe (source, dest, source_size, exp_size);
+  return scil_blocks_decompress(& lz4_codec, dest, buff_size, src, in_size, uncomp_size_out);
+}
+
+int scil_lz4hc_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
+  return scil_blocks_compress(ctx, & lz4hc_codec, dest, out_size, source, source_size);
+}
 
-    return 0;
+int scil_lz4hc12_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
+  return scil_blocks_compress(ctx, & lz4hc12_codec, dest, out_size, source, source_size);
 }
 
+scilU_algorithm_t algo_lz4_v1 = {
+    .c.Btype = {
+        NULL,
+        lz4_v1_decompress
+    },
+    "lz4-v1",
+    7,
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES
+};
+
 scilU_algorithm_t algo_lz4fast = {
     .c.Btype = {
         scil_lz4fast_compress,
@@ -52,5 +145,26 @@ scilU_algorithm_t algo_lz4fast = {
     },
     "lz4",
     7,
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES,
+    .legacy = & algo_lz4_v1
+};
+
+scilU_algorithm_t algo_lz4hc = {
+    .c.Btype = {
+        scil_lz4hc_compress,
+        scil_lz4fast_decompress
+    },
+    "lz4hc",
+    19,
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES
+};
+
+scilU_algorithm_t algo_lz4hc12 = {
+    .c.Btype = {
+        scil_lz4hc12_compress,
+        scil_lz4fast_decompress
+    },
+    "lz4hc-12",
+    20,
     SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES
 };
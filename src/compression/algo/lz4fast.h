@@ -19,7 +19,7 @@
 #include <scil-algorithm-impl.h>
 
 /**
- * \brief Trivial LZ4 compression function
+ * \brief LZ4 compression function, the byte_compression_level hint sets the acceleration (default 4)
  * \param ctx Compression context used for this compression
  * \param dest Pre allocated buffer which will hold the compressed data
  * \param dest_size Byte size the compressed buffer will have
@@ -40,6 +40,24 @@ int scil_lz4fast_compress(const scil_context_t* ctx, byte* restrict dest, size_t
  */
 int scil_lz4fast_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out);
 
+/**
+ * \brief LZ4 HC compression function, the byte_compression_level hint sets the level (default 9).
+ * Use scil_lz4fast_decompress() for decompression.
+ */
+int scil_lz4hc_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size);
+
+/**
+ * \brief LZ4 HC compression function with the maximum level 12
+ */
+int scil_lz4hc12_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size);
+
 extern scilU_algorithm_t algo_lz4fast;
+/**
+ * \brief LZ4 as a single block, the format of the compressor ID 7 before lz4 used independent blocks.
+ * It is not registered, the streams without the chain format flag are decoded by it.
+ */
+extern scilU_algorithm_t algo_lz4_v1;
+extern scilU_algorithm_t algo_lz4hc;
+extern scilU_algorithm_t algo_lz4hc12;
 
 #endif
@@ -20,6 +20,11 @@
 
 #include <algo/precond-delta.h>
 #include <scil-error.h>
+#include <scil-prefix-sum.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 #include <stdio.h>
@@ -72,43 +77,24 @@ int scil_delta_precond_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>
 
 int scil_delta_precond_decompress_<DATATYPE>(<DATATYPE>*restrict data_out, scil_dims_t* dims, <DATATYPE>*restrict data_in, byte*restrict header, int * header_parsed_out){
   const size_t size = scil_dims_get_count(dims);
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+#else
+  const int threads = 1;
+#endif
   switch(sizeof(<DATATYPE>)){
-    case 8: {
-      uint64_t* din = (uint64_t*) data_in;
-      uint64_t* dout = (uint64_t*) data_out;
-      dout[0] = din[0];
-      for(size_t i=1; i < size; i++){
-        dout[i] = din[i] + dout[i-1];
-      }
+    case 8:
+      scil_prefix_sum_int64_t((uint64_t*) data_out, (uint64_t*) data_in, size, threads);
       break;
-    }
-    case 4: {
-      uint32_t* din = (uint32_t*) data_in;
-      uint32_t* dout = (uint32_t*) data_out;
-      dout[0] = din[0];
-      for(size_t i=1; i < size; i++){
-        dout[i] = din[i] + dout[i-1];
-      }
+    case 4:
+      scil_prefix_sum_int32_t((uint32_t*) data_out, (uint32_t*) data_in, size, threads);
       break;
-    }
-    case 2: {
-      uint16_t* din = (uint16_t*) data_in;
-      uint16_t* dout = (uint16_t*) data_out;
-      dout[0] = din[0];
-      for(size_t i=1; i < size; i++){
-        dout[i] = din[i] + dout[i-1];
-      }
+    case 2:
+      scil_prefix_sum_int16_t((uint16_t*) data_out, (uint16_t*) data_in, size, threads);
       break;
-    }
-    case 1: {
-      uint8_t* din = (uint8_t*) data_in;
-      uint8_t* dout = (uint8_t*) data_out;
-      dout[0] = din[0];
-      for(size_t i=1; i < size; i++){
-        dout[i] = din[i] + dout[i-1];
-      }
+    case 1:
+      scil_prefix_sum_int8_t((uint8_t*) data_out, (uint8_t*) data_in, size, threads);
       break;
-    }
   }
   *header_parsed_out = 0;
   return SCIL_NO_ERR;
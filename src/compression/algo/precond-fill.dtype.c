@@ -0,0 +1,333 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/precond-fill.h>
+#include <scil-error.h>
+#include <scil-util.h>
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+/*
+ * Layout of the header: the payload, the special values, the payload size (8 bytes),
+ * the number of special values (1 byte), the mode (1 byte).
+ * MODE_RUNS: alternating lengths of regular and special runs (LEB128), a special run is followed
+ * by the index of its value (1 byte) if there are multiple special values.
+ * MODE_BITMAP: one bit per value marking the special ones, followed by the index of each special value
+ * if there are multiple special values.
+ * MODE_NONE: the data passes unchanged, the header consists of the mode only. This is the case
+ * without special values or if their header would not fit into the space after the data.
+ */
+#define MODE_NONE 0
+#define MODE_RUNS 1
+#define MODE_BITMAP 2
+
+#define MAX_VALUES 255
+
+static size_t varint_size(uint64_t v){
+  size_t size = 1;
+  while(v >= 0x80){
+    v >>= 7;
+    size++;
+  }
+  return size;
+}
+
+static byte* put_varint(byte* p, uint64_t v){
+  while(v >= 0x80){
+    *p++ = (byte) (v | 0x80);
+    v >>= 7;
+  }
+  *p++ = (byte) v;
+  return p;
+}
+
+static const byte* get_varint(const byte* p, const byte* end, uint64_t* v){
+  *v = 0;
+  for(int shift=0; shift < 64; shift += 7){
+    if(p >= end){
+      return NULL;
+    }
+    *v |= (uint64_t) (*p & 0x7F) << shift;
+    if((*p++ & 0x80) == 0){
+      return p;
+    }
+  }
+  return NULL;
+}
+
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+
+// converting a value outside the range of the datatype is undefined, integer types only hold integers
+static int fill_value_fits(double fill, enum SCIL_Datatype datatype){
+  switch(datatype){
+    case SCIL_TYPE_DOUBLE:
+      return 1;
+    case SCIL_TYPE_FLOAT:
+      return ! isfinite(fill) || fabs(fill) <= (double) FLT_MAX;
+    case SCIL_TYPE_INT8:
+      return fill >= -0x1p7 && fill < 0x1p7 && trunc(fill) == fill;
+    case SCIL_TYPE_INT16:
+      return fill >= -0x1p15 && fill < 0x1p15 && trunc(fill) == fill;
+    case SCIL_TYPE_INT32:
+      return fill >= -0x1p31 && fill < 0x1p31 && trunc(fill) == fill;
+    case SCIL_TYPE_INT64:
+      return fill >= -0x1p63 && fill < 0x1p63 && trunc(fill) == fill;
+    default:
+      return 0;
+  }
+}
+
+// the space after the data is shared by the headers of all first preconditioners
+static size_t header_limit(size_t data_size){
+  return data_size / 2;
+}
+
+int scil_fill_precond_extracted(const byte* header, int header_size){
+  return header[header_size - 1] != MODE_NONE;
+}
+
+//Supported datatypes: float double int8_t int16_t int32_t int64_t
+// Repeat for each data type
+
+// the values are compared by their bits, thus fill values are restored exactly
+static inline int find_<DATATYPE>(uint<DATATYPE_SIZE>_t v, const uint<DATATYPE_SIZE>_t* values, int count){
+  for(int i=0; i < count; i++){
+    if(values[i] == v){
+      return i;
+    }
+  }
+  return -1;
+}
+
+static int add_value_<DATATYPE>(uint<DATATYPE_SIZE>_t v, uint<DATATYPE_SIZE>_t* values, int count){
+  if(find_<DATATYPE>(v, values, count) >= 0){
+    return count;
+  }
+  if(count == MAX_VALUES){
+    return -1;
+  }
+  values[count] = v;
+  return count + 1;
+}
+
+// gathers the fill value hint and the special values of the context, -1 if there are too many
+static int collect_values_<DATATYPE>(const scil_context_t* ctx, uint<DATATYPE_SIZE>_t* values){
+  int count = 0;
+  if(ctx == NULL){
+    return 0;
+  }
+  if(ctx->hints.fill_value != DBL_MAX){
+    const <DATATYPE> fill = (<DATATYPE>) ctx->hints.fill_value;
+    uint<DATATYPE_SIZE>_t v;
+    memcpy(& v, & fill, sizeof(v));
+    count = add_value_<DATATYPE>(v, values, count);
+  }
+  for(int i=0; i < ctx->special_values_count && count >= 0; i++){
+    uint<DATATYPE_SIZE>_t v;
+    memcpy(& v, & ctx->special_values[i].u, sizeof(v));
+    count = add_value_<DATATYPE>(v, values, count);
+  }
+  return count;
+}
+
+int scil_fill_precond_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>* restrict data_out, byte*restrict header, int * header_size_out, <DATATYPE>*restrict data_in, const scil_dims_t* dims){
+  const size_t count = scil_dims_get_count(dims);
+  const uint<DATATYPE_SIZE>_t* restrict in = (uint<DATATYPE_SIZE>_t*) data_in;
+  uint<DATATYPE_SIZE>_t* restrict out = (uint<DATATYPE_SIZE>_t*) data_out;
+  if(ctx != NULL && ctx->hints.fill_value != DBL_MAX && ! fill_value_fits(ctx->hints.fill_value, SCIL_TYPE_<DATATYPE_UPPER>)){
+    return SCIL_FILL_VAL_ERR;
+  }
+  uint<DATATYPE_SIZE>_t values[MAX_VALUES];
+  const int k = collect_values_<DATATYPE>(ctx, values);
+  if(k < 0){
+    return SCIL_EINVAL;
+  }
+
+  // leading special values are replaced by the first regular one
+  uint<DATATYPE_SIZE>_t last = 0;
+  for(size_t i=0; i < count; i++){
+    if(find_<DATATYPE>(in[i], values, k) < 0){
+      last = in[i];
+      break;
+    }
+  }
+  size_t runs_size = 0;
+  size_t specials = 0;
+  for(size_t i=0; i < count; ){
+    const size_t regular = i;
+    while(i < count && find_<DATATYPE>(in[i], values, k) < 0){
+      last = in[i];
+      out[i++] = last;
+    }
+    runs_size += varint_size(i - regular);
+    if(i == count){
+      break;
+    }
+    const size_t special = i;
+    const int v = find_<DATATYPE>(in[i], values, k);
+    while(i < count && find_<DATATYPE>(in[i], values, k) == v){
+      out[i++] = last;
+    }
+    specials += i - special;
+    runs_size += varint_size(i - special) + (k > 1);
+  }
+  if(specials == 0){
+    header[0] = MODE_NONE;
+    *header_size_out = 1;
+    return SCIL_NO_ERR;
+  }
+
+  const size_t bitmap_size = (count + 7) / 8 + (k > 1 ? specials : 0);
+  const int mode = runs_size <= bitmap_size ? MODE_RUNS : MODE_BITMAP;
+  const size_t header_size = (mode == MODE_RUNS ? runs_size : bitmap_size) + k * sizeof(uint<DATATYPE_SIZE>_t) + 10;
+  if(header_size > header_limit(count * sizeof(<DATATYPE>))){
+    // the special values stay in the data and are kept by the following stages
+    memcpy(data_out, data_in, count * sizeof(<DATATYPE>));
+    header[0] = MODE_NONE;
+    *header_size_out = 1;
+    return SCIL_NO_ERR;
+  }
+  byte* pos = header;
+  if(mode == MODE_RUNS){
+    for(size_t i=0; i < count; ){
+      const size_t regular = i;
+      while(i < count && find_<DATATYPE>(in[i], values, k) < 0){
+        i++;
+      }
+      pos = put_varint(pos, i - regular);
+      if(i == count){
+        break;
+      }
+      const size_t special = i;
+      const int v = find_<DATATYPE>(in[i], values, k);
+      while(i < count && find_<DATATYPE>(in[i], values, k) == v){
+        i++;
+      }
+      pos = put_varint(pos, i - special);
+      if(k > 1){
+        *pos++ = (byte) v;
+      }
+    }
+  }else{
+    byte* index = pos + (count + 7) / 8;
+    memset(pos, 0, (count + 7) / 8);
+    for(size_t i=0; i < count; i++){
+      const int v = find_<DATATYPE>(in[i], values, k);
+      if(v >= 0){
+        pos[i / 8] |= (byte) (1 << (i % 8));
+        if(k > 1){
+          *index++ = (byte) v;
+        }
+      }
+    }
+    pos = index;
+  }
+  uint64_t payload = pos - header;
+  memcpy(pos, values, k * sizeof(uint<DATATYPE_SIZE>_t));
+  pos += k * sizeof(uint<DATATYPE_SIZE>_t);
+  scilU_pack8(pos, payload);
+  pos += 8;
+  *pos++ = (byte) k;
+  *pos++ = (byte) mode;
+
+  *header_size_out = pos - header;
+  return SCIL_NO_ERR;
+}
+
+int scil_fill_precond_decompress_<DATATYPE>(<DATATYPE>*restrict data_out, scil_dims_t* dims, <DATATYPE>*restrict data_in, byte*restrict header, int * header_parsed_out){
+  const size_t count = scil_dims_get_count(dims);
+  uint<DATATYPE_SIZE>_t* restrict out = (uint<DATATYPE_SIZE>_t*) data_out;
+  memcpy(data_out, data_in, count * sizeof(<DATATYPE>));
+
+  const int mode = header[0];
+  if(mode == MODE_NONE){
+    *header_parsed_out = 1;
+    return SCIL_NO_ERR;
+  }
+  const int k = header[-1];
+  uint64_t payload;
+  scilU_unpack8((header - 9), & payload);
+  if(k < 1 || (mode != MODE_RUNS && mode != MODE_BITMAP) || payload > ((uint64_t) 1 << 48)){
+    return SCIL_BUFFER_ERR;
+  }
+  const size_t header_size = payload + k * sizeof(uint<DATATYPE_SIZE>_t) + 10;
+  const byte* start = header - header_size + 1;
+  const byte* end = start + payload;
+  uint<DATATYPE_SIZE>_t values[MAX_VALUES];
+  memcpy(values, end, k * sizeof(uint<DATATYPE_SIZE>_t));
+
+  if(mode == MODE_RUNS){
+    const byte* p = start;
+    for(size_t i=0; i < count; ){
+      uint64_t regular, special;
+      p = get_varint(p, end, & regular);
+      if(p == NULL || regular > count - i){
+        return SCIL_BUFFER_ERR;
+      }
+      i += regular;
+      if(i == count){
+        break;
+      }
+      p = get_varint(p, end, & special);
+      if(p == NULL || special == 0 || special > count - i){
+        return SCIL_BUFFER_ERR;
+      }
+      int v = 0;
+      if(k > 1){
+        if(p >= end || *p >= k){
+          return SCIL_BUFFER_ERR;
+        }
+        v = *p++;
+      }
+      for(uint64_t j=0; j < special; j++){
+        out[i++] = values[v];
+      }
+    }
+  }else{
+    const byte* index = start + (count + 7) / 8;
+    if(index > end){
+      return SCIL_BUFFER_ERR;
+    }
+    for(size_t i=0; i < count; i++){
+      if(start[i / 8] & (1 << (i % 8))){
+        int v = 0;
+        if(k > 1){
+          if(index >= end || *index >= k){
+            return SCIL_BUFFER_ERR;
+          }
+          v = *index++;
+        }
+        out[i] = values[v];
+      }
+    }
+  }
+
+  *header_parsed_out = header_size;
+  return SCIL_NO_ERR;
+}
+
+// End repeat
+
+scilU_algorithm_t algo_precond_fill = {
+    .c.PFtype = {
+        CREATE_INITIALIZER(scil_fill_precond)
+    },
+    "fill",
+    30,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_PRECONDITIONER_FIRST,
+    0
+};
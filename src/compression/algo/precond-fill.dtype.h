@@ -0,0 +1,31 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+// Extracts the fill value and the special values of the context into a run list or a bitmap,
+// whichever is smaller, and replaces them by the preceding regular value.
+// The following stages see smooth data without fill values, decompression restores them bit by bit.
+// A fill value the datatype cannot represent is rejected with SCIL_FILL_VAL_ERR. If the header would
+// be larger than half of the data, the data passes unchanged and the following stages keep the
+// special values of the context.
+
+#ifndef SCIL_PRECOND_FILL_H_
+#define SCIL_PRECOND_FILL_H_
+#include <scil-algorithm-impl.h>
+
+extern scilU_algorithm_t algo_precond_fill;
+
+// returns 1 if the header of the given size removed the special values from the data
+int scil_fill_precond_extracted(const byte* header, int header_size);
+
+#endif
@@ -13,87 +13,238 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
 
-//Supported datatypes: float double int8_t int16_t int32_t int64_t
-
 #include <string.h>
 #include <stdio.h>
 #include <assert.h>
 
 #include <algo/precond-fp-delta.h>
 #include <scil-error.h>
+#include <scil-swager.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*
+ * Header layout, written forwards and parsed backwards:
+ * bitpacked zigzag differences of the block minima, the first minimum, bits per difference (1 byte),
+ * log2 of the block size (1 byte).
+ */
+
+// the minimum and maximum are determined for chunks of this size, blocks are multiple chunks
+#define CHUNK_LOG 6
+#define CHUNK (1<<CHUNK_LOG)
+#define MAX_BLOCK_LOG 16
+// smaller inputs are processed by a single thread
+#define PARALLEL_MIN_COUNT (1<<16)
+
+static int bits_needed(uint64_t value){
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+//Supported datatypes: float double
+// Repeat for each data type
+// maps the bits of a floating point number to an unsigned integer of the same order
+static inline uint<DATATYPE_SIZE>_t key_<DATATYPE>(uint<DATATYPE_SIZE>_t x){
+  return x ^ ((uint<DATATYPE_SIZE>_t) ((int<DATATYPE_SIZE>_t) x >> (<DATATYPE_SIZE> - 1)) | ((uint<DATATYPE_SIZE>_t) 1 << (<DATATYPE_SIZE> - 1)));
+}
+
+static inline uint<DATATYPE_SIZE>_t unkey_<DATATYPE>(uint<DATATYPE_SIZE>_t x){
+  return x ^ ((uint<DATATYPE_SIZE>_t) ~((int<DATATYPE_SIZE>_t) x >> (<DATATYPE_SIZE> - 1)) | ((uint<DATATYPE_SIZE>_t) 1 << (<DATATYPE_SIZE> - 1)));
+}
+// End repeat
 
-#define BLOCK_SIZE 100
+//Supported datatypes: int8_t int16_t int32_t int64_t
+// Repeat for each data type
+static inline uint<DATATYPE_SIZE>_t key_<DATATYPE>(uint<DATATYPE_SIZE>_t x){
+  return x ^ ((uint<DATATYPE_SIZE>_t) 1 << (<DATATYPE_SIZE> - 1));
+}
 
+static inline uint<DATATYPE_SIZE>_t unkey_<DATATYPE>(uint<DATATYPE_SIZE>_t x){
+  return x ^ ((uint<DATATYPE_SIZE>_t) 1 << (<DATATYPE_SIZE> - 1));
+}
+// End repeat
+
+//Supported datatypes: float double int8_t int16_t int32_t int64_t
 // Repeat for each data type
 #pragma GCC diagnostic ignored "-Wunused-parameter"
-static int scil_delta_precond_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>* restrict data_out, byte*restrict header, int * header_size_out, <DATATYPE>*restrict data_in, const scil_dims_t* dims){
-  const size_t size = scil_dims_get_count(dims);
-  <DATATYPE>* din = (<DATATYPE>*) data_in;
-  <DATATYPE>* dout = (<DATATYPE>*) data_out;
-  const size_t repeats = size / BLOCK_SIZE;
-  byte *restrict header_pos = header;
-  size_t i = 0;
-  for(size_t rep = 1; rep <= repeats; rep++){
-    const size_t end = rep * BLOCK_SIZE;
-    // find the minimum value
-    <DATATYPE> minv = din[i];
-    for( size_t t = i; t + 1 < end; t++){
-      minv = din[t] < minv ? din[t] : minv;
+
+/*
+ * Chooses the block size that minimizes the bits of the residuals and the packed minima,
+ * min and max hold the range of every chunk and are overwritten.
+ */
+static int choose_block_log_<DATATYPE>(uint<DATATYPE_SIZE>_t* restrict min, uint<DATATYPE_SIZE>_t* restrict max, size_t chunks, size_t count){
+  int best_log = 0;
+  uint64_t best_cost = UINT64_MAX;
+  for(int log=0; log <= MAX_BLOCK_LOG - CHUNK_LOG; log++){
+    const size_t block = (size_t) CHUNK << log;
+    uint64_t cost = 0;
+    int delta_bits = 0;
+    for(size_t b=0; b < chunks; b++){
+      const size_t size = (b + 1) * block <= count ? block : count - b * block;
+      cost += size * bits_needed(max[b] - min[b]);
+      if(b > 0){
+        const int<DATATYPE_SIZE>_t delta = (int<DATATYPE_SIZE>_t) (min[b] - min[b-1]);
+        const int bits = bits_needed(((uint64_t) delta << 1) ^ (uint64_t) ((int64_t) delta >> 63));
+        delta_bits = bits > delta_bits ? bits : delta_bits;
+      }
+    }
+    cost += (chunks - 1) * delta_bits;
+    if(cost < best_cost){
+      best_cost = cost;
+      best_log = log;
     }
-    for( ; i < end; i++){
-      dout[i] = din[i] - minv;
+    if(chunks == 1){
+      break;
     }
-    memcpy(header_pos, & minv, sizeof(<DATATYPE>));
-    //printf("C: %f %d\n", (double) minv, i);
-    header_pos += sizeof(<DATATYPE>);
+    // merge pairs of blocks for the next level
+    const size_t merged = (chunks + 1) / 2;
+    for(size_t b=0; b < chunks / 2; b++){
+      min[b] = min[2*b] < min[2*b+1] ? min[2*b] : min[2*b+1];
+      max[b] = max[2*b] > max[2*b+1] ? max[2*b] : max[2*b+1];
+    }
+    if(chunks % 2){
+      min[merged - 1] = min[chunks - 1];
+      max[merged - 1] = max[chunks - 1];
+    }
+    chunks = merged;
   }
-  if (i < size){
-    <DATATYPE> minv = din[i];
-    for( size_t t = i; t + 1 < size; t++){
-      minv = din[t] < minv ? din[t] : minv;
+  return best_log + CHUNK_LOG;
+}
+
+static int scil_delta_precond_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>* restrict data_out, byte*restrict header, int * header_size_out, <DATATYPE>*restrict data_in, const scil_dims_t* dims){
+  const size_t count = scil_dims_get_count(dims);
+  const uint<DATATYPE_SIZE>_t* restrict in = (uint<DATATYPE_SIZE>_t*) data_in;
+  uint<DATATYPE_SIZE>_t* restrict out = (uint<DATATYPE_SIZE>_t*) data_out;
+  const int threads = count >= PARALLEL_MIN_COUNT && ctx != NULL && ctx->hints.thread_count > 1 ? ctx->hints.thread_count : 1;
+
+  const size_t chunks = (count + CHUNK - 1) / CHUNK;
+  uint<DATATYPE_SIZE>_t* chunk_min = malloc(3 * chunks * sizeof(uint<DATATYPE_SIZE>_t) + 1);
+  uint64_t* deltas = malloc(chunks * sizeof(uint64_t) + 1);
+  if(chunk_min == NULL || deltas == NULL){
+    free(chunk_min);
+    free(deltas);
+    return SCIL_MEMORY_ERR;
+  }
+  uint<DATATYPE_SIZE>_t* min = chunk_min + chunks;
+  uint<DATATYPE_SIZE>_t* max = min + chunks;
+
+  // convert to ordered keys and determine the range of each chunk
+  #pragma omp parallel for num_threads(threads) if(threads > 1) schedule(static)
+  for(size_t c=0; c < chunks; c++){
+    const size_t start = c * CHUNK;
+    const size_t end = start + CHUNK < count ? start + CHUNK : count;
+    uint<DATATYPE_SIZE>_t mn = key_<DATATYPE>(in[start]);
+    uint<DATATYPE_SIZE>_t mx = mn;
+    for(size_t i=start; i < end; i++){
+      const uint<DATATYPE_SIZE>_t k = key_<DATATYPE>(in[i]);
+      out[i] = k;
+      mn = k < mn ? k : mn;
+      mx = k > mx ? k : mx;
+    }
+    chunk_min[c] = mn;
+    min[c] = mn;
+    max[c] = mx;
+  }
+
+  const int block_log = count > 0 ? choose_block_log_<DATATYPE>(min, max, chunks, count) : CHUNK_LOG;
+  const int merge_log = block_log - CHUNK_LOG;
+  const size_t blocks = (chunks + ((size_t) 1 << merge_log) - 1) >> merge_log;
+
+  // the minimum of each block, stored in min
+  for(size_t b=0; b < blocks; b++){
+    const size_t last = (b + 1) << merge_log < chunks ? (b + 1) << merge_log : chunks;
+    uint<DATATYPE_SIZE>_t mn = chunk_min[b << merge_log];
+    for(size_t c=b << merge_log; c < last; c++){
+      mn = chunk_min[c] < mn ? chunk_min[c] : mn;
     }
-    //printf("C: %f %d %d\n", (double) minv, i, size);
-    for( ; i < size; i++){
-      dout[i] = din[i] - minv;
+    min[b] = mn;
+  }
+
+  #pragma omp parallel for num_threads(threads) if(threads > 1) schedule(static)
+  for(size_t c=0; c < chunks; c++){
+    const size_t start = c * CHUNK;
+    const size_t end = start + CHUNK < count ? start + CHUNK : count;
+    const uint<DATATYPE_SIZE>_t mn = min[c >> merge_log];
+    for(size_t i=start; i < end; i++){
+      out[i] -= mn;
     }
-    memcpy(header_pos, & minv, sizeof(<DATATYPE>));
-    header_pos += sizeof(<DATATYPE>);
   }
-  *header_size_out = header_pos - header;
-  //printf("CH: %d\n", *header_size_out);
+
+  int bits = 0;
+  for(size_t b=1; b < blocks; b++){
+    const int<DATATYPE_SIZE>_t delta = (int<DATATYPE_SIZE>_t) (min[b] - min[b-1]);
+    deltas[b-1] = ((uint64_t) delta << 1) ^ (uint64_t) ((int64_t) delta >> 63);
+    const int needed = bits_needed(deltas[b-1]);
+    bits = needed > bits ? needed : bits;
+  }
+  const size_t packed = blocks > 1 ? ((blocks - 1) * bits + 7) / 8 : 0;
+  // the packing may touch the byte after the packed data, which is overwritten by the first minimum
+  scil_swage(header, deltas, blocks > 1 ? blocks - 1 : 0, bits);
+  byte* pos = header + packed;
+  const uint<DATATYPE_SIZE>_t first = blocks > 0 ? min[0] : 0;
+  memcpy(pos, & first, sizeof(first));
+  pos += sizeof(first);
+  *pos = (byte) bits;
+  pos++;
+  *pos = (byte) block_log;
+  pos++;
+
+  free(chunk_min);
+  free(deltas);
+  *header_size_out = pos - header;
   return SCIL_NO_ERR;
 }
 
 static int scil_delta_precond_decompress_<DATATYPE>(<DATATYPE>*restrict data_out, scil_dims_t* dims, <DATATYPE>*restrict data_in, byte*restrict header, int * header_parsed_out){
-  const size_t size = scil_dims_get_count(dims);
-  <DATATYPE>* din = (<DATATYPE>*) data_in;
-  <DATATYPE>* dout = (<DATATYPE>*) data_out;
-  const size_t repeats = size / BLOCK_SIZE;
-  byte *restrict header_pos = header - (repeats + (size % BLOCK_SIZE == 0 ? 0 : 1)) * sizeof(<DATATYPE>) + 1;
-  //printf("DH: %d %d %d %d\n", (repeats + (size % BLOCK_SIZE == 0 ? 0 : 1)) * sizeof(<DATATYPE>), size % BLOCK_SIZE, size, BLOCK_SIZE);
-
-  size_t i = 0;
-  for(size_t rep = 1; rep <= repeats; rep++){
-    const size_t end = rep * BLOCK_SIZE;
-    <DATATYPE> minv;
-    memcpy(& minv, header_pos, sizeof(<DATATYPE>));
-    header_pos += sizeof(<DATATYPE>);
-    //printf("D: %f \n", (double) minv);
-    for( ; i < end; i++){
-      dout[i] = din[i] + minv;
+  const size_t count = scil_dims_get_count(dims);
+  const uint<DATATYPE_SIZE>_t* restrict in = (uint<DATATYPE_SIZE>_t*) data_in;
+  uint<DATATYPE_SIZE>_t* restrict out = (uint<DATATYPE_SIZE>_t*) data_out;
+
+  const int block_log = header[0];
+  const int bits = header[-1];
+  if(block_log < CHUNK_LOG || block_log > MAX_BLOCK_LOG || bits > <DATATYPE_SIZE> + 1){
+    return SCIL_BUFFER_ERR;
+  }
+  const size_t block = (size_t) 1 << block_log;
+  const size_t blocks = (count + block - 1) / block;
+  const size_t packed = blocks > 1 ? ((blocks - 1) * bits + 7) / 8 : 0;
+  const size_t header_size = packed + sizeof(uint<DATATYPE_SIZE>_t) + 2;
+  const byte* start = header - header_size + 1;
+
+  uint<DATATYPE_SIZE>_t* min = malloc(blocks * sizeof(uint<DATATYPE_SIZE>_t) + 1);
+  uint64_t* deltas = malloc(blocks * sizeof(uint64_t) + 1);
+  if(min == NULL || deltas == NULL){
+    free(min);
+    free(deltas);
+    return SCIL_MEMORY_ERR;
+  }
+  if(blocks > 0){
+    scil_unswage(deltas, start, blocks - 1, bits);
+    memcpy(& min[0], start + packed, sizeof(uint<DATATYPE_SIZE>_t));
+    for(size_t b=1; b < blocks; b++){
+      const uint64_t delta = (deltas[b-1] >> 1) ^ (0 - (deltas[b-1] & 1));
+      min[b] = min[b-1] + (uint<DATATYPE_SIZE>_t) delta;
     }
   }
-  if (i < size){
-    <DATATYPE> minv;
-    memcpy(& minv, header_pos, sizeof(<DATATYPE>));
-    header_pos += sizeof(<DATATYPE>);
-    //printf("D: %f \n", (double) minv);
-    for( ; i < size; i++){
-      dout[i] = din[i] + minv;
+
+#ifdef _OPENMP
+  const int threads = count >= PARALLEL_MIN_COUNT ? omp_get_max_threads() : 1;
+#else
+  const int threads = 1;
+#endif
+  #pragma omp parallel for num_threads(threads) if(threads > 1) schedule(static)
+  for(size_t b=0; b < blocks; b++){
+    const size_t end = (b + 1) * block < count ? (b + 1) * block : count;
+    const uint<DATATYPE_SIZE>_t mn = min[b];
+    for(size_t i=b * block; i < end; i++){
+      out[i] = unkey_<DATATYPE>(in[i] + mn);
     }
   }
 
-  *header_parsed_out = header_pos - header;
+  free(min);
+  free(deltas);
+  *header_parsed_out = header_size;
   return SCIL_NO_ERR;
 }
 
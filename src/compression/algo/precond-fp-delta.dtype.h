@@ -19,7 +19,10 @@
 #include <scil-algorithm-impl.h>
 
 /*
- * This example algorithm takes blocks of a given size and subtracts the minimum of each block from all data points within the block. The minimum is stored on the metadata.
+ * This algorithm takes blocks of a given size and subtracts the minimum of each block from all data points within the block.
+ * The values are compared as integers of the same order, which keeps the transformation lossless for floating point data.
+ * The block size is a power of two chosen to minimize the bits of the residuals plus the minima, which are stored as
+ * bitpacked differences in the metadata.
  */
 
 extern scilU_algorithm_t algo_precond_fp_delta;
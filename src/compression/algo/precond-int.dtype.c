@@ -0,0 +1,164 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/precond-int.h>
+#include <scil-error.h>
+#include <scil-lorenzo.h>
+#include <scil-prefix-sum.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// the loops of the encoders are vectorized by the compiler, the decoders use the SIMD prefix sum
+// delta-int is the Lorenzo predictor of the values as a single row
+
+static int get_threads(const scil_context_t* ctx){
+  return ctx != NULL ? ctx->hints.thread_count : 1;
+}
+
+static int get_decompression_threads(){
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+//Supported datatypes: int8_t int16_t int32_t int64_t
+// Repeat for each data type
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+static int scil_delta_int_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>* restrict data_out, byte*restrict header, int * header_size_out, <DATATYPE>*restrict data_in, const scil_dims_t* dims){
+  scil_dims_t row;
+  scil_dims_initialize_1d(& row, scil_dims_get_count(dims));
+  scil_lorenzo_encode_<DATATYPE>((u<DATATYPE>*) data_out, (u<DATATYPE>*) data_in, & row, get_threads(ctx));
+  *header_size_out = 0;
+  return SCIL_NO_ERR;
+}
+
+static int scil_delta_int_decompress_<DATATYPE>(<DATATYPE>*restrict data_out, scil_dims_t* dims, <DATATYPE>*restrict data_in, byte*restrict header, int * header_parsed_out){
+  scil_dims_t row;
+  scil_dims_initialize_1d(& row, scil_dims_get_count(dims));
+  scil_lorenzo_decode_<DATATYPE>((u<DATATYPE>*) data_out, (u<DATATYPE>*) data_in, & row);
+  *header_parsed_out = 0;
+  return SCIL_NO_ERR;
+}
+
+static int scil_delta2_int_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>* restrict data_out, byte*restrict header, int * header_size_out, <DATATYPE>*restrict data_in, const scil_dims_t* dims){
+  const size_t count = scil_dims_get_count(dims);
+  u<DATATYPE>* restrict out = (u<DATATYPE>*) data_out;
+  const u<DATATYPE>* restrict in = (const u<DATATYPE>*) data_in;
+  const int threads = get_threads(ctx);
+  // the inverse of two prefix sums
+  if(count > 0){
+    out[0] = in[0];
+  }
+  if(count > 1){
+    out[1] = (u<DATATYPE>) (in[1] - 2 * in[0]);
+  }
+  #pragma omp parallel for num_threads(threads) if(threads > 1)
+  for(size_t i=2; i < count; i++){
+    out[i] = (u<DATATYPE>) (in[i] - 2 * in[i-1] + in[i-2]);
+  }
+  *header_size_out = 0;
+  return SCIL_NO_ERR;
+}
+
+static int scil_delta2_int_decompress_<DATATYPE>(<DATATYPE>*restrict data_out, scil_dims_t* dims, <DATATYPE>*restrict data_in, byte*restrict header, int * header_parsed_out){
+  const size_t count = scil_dims_get_count(dims);
+  const int threads = get_decompression_threads();
+  scil_prefix_sum_<DATATYPE>((u<DATATYPE>*) data_out, (u<DATATYPE>*) data_in, count, threads);
+  scil_prefix_sum_<DATATYPE>((u<DATATYPE>*) data_out, (u<DATATYPE>*) data_out, count, threads);
+  *header_parsed_out = 0;
+  return SCIL_NO_ERR;
+}
+
+static int scil_zigzag_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>* restrict data_out, byte*restrict header, int * header_size_out, <DATATYPE>*restrict data_in, const scil_dims_t* dims){
+  const size_t count = scil_dims_get_count(dims);
+  u<DATATYPE>* restrict out = (u<DATATYPE>*) data_out;
+  const u<DATATYPE>* restrict in = (const u<DATATYPE>*) data_in;
+  const int threads = get_threads(ctx);
+  #pragma omp parallel for num_threads(threads) if(threads > 1)
+  for(size_t i=0; i < count; i++){
+    out[i] = (u<DATATYPE>) ((u<DATATYPE>) (in[i] << 1) ^ (u<DATATYPE>) ((<DATATYPE>) in[i] >> (<DATATYPE_SIZE> - 1)));
+  }
+  *header_size_out = 0;
+  return SCIL_NO_ERR;
+}
+
+static int scil_zigzag_decompress_<DATATYPE>(<DATATYPE>*restrict data_out, scil_dims_t* dims, <DATATYPE>*restrict data_in, byte*restrict header, int * header_parsed_out){
+  const size_t count = scil_dims_get_count(dims);
+  u<DATATYPE>* restrict out = (u<DATATYPE>*) data_out;
+  const u<DATATYPE>* restrict in = (const u<DATATYPE>*) data_in;
+  const int threads = get_decompression_threads();
+  #pragma omp parallel for num_threads(threads) if(threads > 1)
+  for(size_t i=0; i < count; i++){
+    out[i] = (u<DATATYPE>) ((in[i] >> 1) ^ (u<DATATYPE>) (0 - (in[i] & 1)));
+  }
+  *header_parsed_out = 0;
+  return SCIL_NO_ERR;
+}
+// End repeat
+
+scilU_algorithm_t algo_precond_delta_int = {
+    .c.PStype = {
+        scil_delta_int_compress_int8_t,
+        scil_delta_int_decompress_int8_t,
+        scil_delta_int_compress_int16_t,
+        scil_delta_int_decompress_int16_t,
+        scil_delta_int_compress_int32_t,
+        scil_delta_int_decompress_int32_t,
+        scil_delta_int_compress_int64_t,
+        scil_delta_int_decompress_int64_t
+    },
+    "delta-int",
+    33,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_PRECONDITIONER_SECOND,
+    0
+};
+
+scilU_algorithm_t algo_precond_delta2_int = {
+    .c.PStype = {
+        scil_delta2_int_compress_int8_t,
+        scil_delta2_int_decompress_int8_t,
+        scil_delta2_int_compress_int16_t,
+        scil_delta2_int_decompress_int16_t,
+        scil_delta2_int_compress_int32_t,
+        scil_delta2_int_decompress_int32_t,
+        scil_delta2_int_compress_int64_t,
+        scil_delta2_int_decompress_int64_t
+    },
+    "delta2-int",
+    34,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_PRECONDITIONER_SECOND,
+    0
+};
+
+scilU_algorithm_t algo_precond_zigzag = {
+    .c.PStype = {
+        scil_zigzag_compress_int8_t,
+        scil_zigzag_decompress_int8_t,
+        scil_zigzag_compress_int16_t,
+        scil_zigzag_decompress_int16_t,
+        scil_zigzag_compress_int32_t,
+        scil_zigzag_decompress_int32_t,
+        scil_zigzag_compress_int64_t,
+        scil_zigzag_decompress_int64_t
+    },
+    "zigzag",
+    35,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_PRECONDITIONER_SECOND,
+    0
+};
@@ -0,0 +1,30 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// Transformations of the integers produced by a converter, e.g., quantize.
+// delta-int and delta2-int turn smooth values into small residuals, zigzag maps the
+// residuals that wrapped around below zero to small unsigned values.
+
+#ifndef SCIL_PRECOND_INT_H_
+#define SCIL_PRECOND_INT_H_
+#include <scil-algorithm-impl.h>
+
+// the difference to the previous value
+extern scilU_algorithm_t algo_precond_delta_int;
+// the difference of consecutive differences, i.e., the error of a linear extrapolation
+extern scilU_algorithm_t algo_precond_delta2_int;
+extern scilU_algorithm_t algo_precond_zigzag;
+
+#endif
@@ -0,0 +1,79 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algo/precond-lorenzo.h>
+#include <scil-lorenzo.h>
+#include <scil-error.h>
+
+static int get_threads(const scil_context_t* ctx){
+  return ctx != NULL ? ctx->hints.thread_count : 1;
+}
+
+//Supported datatypes: float double
+// Repeat for each data type
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+int scil_lorenzo_precond_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>* restrict data_out, byte*restrict header, int * header_size_out, <DATATYPE>*restrict data_in, const scil_dims_t* dims){
+  scil_lorenzo_encode_<DATATYPE>((uint<DATATYPE_SIZE>_t*) data_out, data_in, dims, get_threads(ctx));
+  *header_size_out = 0;
+  return SCIL_NO_ERR;
+}
+
+int scil_lorenzo_precond_decompress_<DATATYPE>(<DATATYPE>*restrict data_out, scil_dims_t* dims, <DATATYPE>*restrict data_in, byte*restrict header, int * header_parsed_out){
+  *header_parsed_out = 0;
+  return scil_lorenzo_decode_<DATATYPE>(data_out, (uint<DATATYPE_SIZE>_t*) data_in, dims);
+}
+// End repeat
+
+//Supported datatypes: int8_t int16_t int32_t int64_t
+// Repeat for each data type
+int scil_lorenzo_precond_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>* restrict data_out, byte*restrict header, int * header_size_out, <DATATYPE>*restrict data_in, const scil_dims_t* dims){
+  scil_lorenzo_encode_<DATATYPE>((u<DATATYPE>*) data_out, (u<DATATYPE>*) data_in, dims, get_threads(ctx));
+  *header_size_out = 0;
+  return SCIL_NO_ERR;
+}
+
+int scil_lorenzo_precond_decompress_<DATATYPE>(<DATATYPE>*restrict data_out, scil_dims_t* dims, <DATATYPE>*restrict data_in, byte*restrict header, int * header_parsed_out){
+  scil_lorenzo_decode_<DATATYPE>((u<DATATYPE>*) data_out, (u<DATATYPE>*) data_in, dims);
+  *header_parsed_out = 0;
+  return SCIL_NO_ERR;
+}
+// End repeat
+
+scilU_algorithm_t algo_precond_lorenzo = {
+    .c.PFtype = {
+        CREATE_INITIALIZER(scil_lorenzo_precond)
+    },
+    "lorenzo",
+    23,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_PRECONDITIONER_FIRST,
+    0
+};
+
+scilU_algorithm_t algo_precond_lorenzo_int = {
+    .c.PStype = {
+        scil_lorenzo_precond_compress_int8_t,
+        scil_lorenzo_precond_decompress_int8_t,
+        scil_lorenzo_precond_compress_int16_t,
+        scil_lorenzo_precond_decompress_int16_t,
+        scil_lorenzo_precond_compress_int32_t,
+        scil_lorenzo_precond_decompress_int32_t,
+        scil_lorenzo_precond_compress_int64_t,
+        scil_lorenzo_precond_decompress_int64_t
+    },
+    "lorenzo-int",
+    24,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_PRECONDITIONER_SECOND,
+    0
+};
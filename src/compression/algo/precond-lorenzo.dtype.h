@@ -0,0 +1,27 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+// Lossless N-dimensional Lorenzo predictor, every value is predicted from its neighbours
+// with smaller indices in all dimensions of the dims.
+
+#ifndef SCIL_PRECOND_LORENZO_H_
+#define SCIL_PRECOND_LORENZO_H_
+#include <scil-algorithm-impl.h>
+
+// preconditioner for the original data
+extern scilU_algorithm_t algo_precond_lorenzo;
+// preconditioner for the integers produced by a converter, e.g., quantize
+extern scilU_algorithm_t algo_precond_lorenzo_int;
+
+#endif
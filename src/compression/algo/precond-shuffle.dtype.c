@@ -0,0 +1,70 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+//Supported datatypes: float double int8_t int16_t int32_t int64_t
+
+#include <algo/precond-shuffle.h>
+#include <scil-shuffle.h>
+#include <scil-error.h>
+
+// Repeat for each data type
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+int scil_shuffle_precond_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>* restrict data_out, byte*restrict header, int * header_size_out, <DATATYPE>*restrict data_in, const scil_dims_t* dims){
+  scil_byte_shuffle((byte*) data_out, (byte*) data_in, scil_dims_get_count(dims), sizeof(<DATATYPE>));
+  *header_size_out = 0;
+  return SCIL_NO_ERR;
+}
+
+int scil_shuffle_precond_decompress_<DATATYPE>(<DATATYPE>*restrict data_out, scil_dims_t* dims, <DATATYPE>*restrict data_in, byte*restrict header, int * header_parsed_out){
+  scil_byte_unshuffle((byte*) data_out, (byte*) data_in, scil_dims_get_count(dims), sizeof(<DATATYPE>));
+  *header_parsed_out = 0;
+  return SCIL_NO_ERR;
+}
+// End repeat
+
+// Repeat for each data type
+int scil_bitshuffle_precond_compress_<DATATYPE>(const scil_context_t* ctx, <DATATYPE>* restrict data_out, byte*restrict header, int * header_size_out, <DATATYPE>*restrict data_in, const scil_dims_t* dims){
+  scil_bit_shuffle((byte*) data_out, (byte*) data_in, scil_dims_get_count(dims), sizeof(<DATATYPE>));
+  *header_size_out = 0;
+  return SCIL_NO_ERR;
+}
+
+int scil_bitshuffle_precond_decompress_<DATATYPE>(<DATATYPE>*restrict data_out, scil_dims_t* dims, <DATATYPE>*restrict data_in, byte*restrict header, int * header_parsed_out){
+  scil_bit_unshuffle((byte*) data_out, (byte*) data_in, scil_dims_get_count(dims), sizeof(<DATATYPE>));
+  *header_parsed_out = 0;
+  return SCIL_NO_ERR;
+}
+// End repeat
+
+
+scilU_algorithm_t algo_precond_shuffle = {
+    .c.PFtype = {
+        CREATE_INITIALIZER(scil_shuffle_precond)
+    },
+    "shuffle",
+    21,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_PRECONDITIONER_FIRST,
+    0
+};
+
+scilU_algorithm_t algo_precond_bitshuffle = {
+    .c.PFtype = {
+        CREATE_INITIALIZER(scil_bitshuffle_precond)
+    },
+    "bitshuffle",
+    22,
+    SCIL_COMPRESSOR_TYPE_DATATYPES_PRECONDITIONER_FIRST,
+    0
+};
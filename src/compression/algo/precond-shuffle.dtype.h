@@ -0,0 +1,25 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+// Lossless preconditioners that transpose the bytes (shuffle) or bits (bitshuffle)
+// of the values, so that a subsequent byte compressor sees the similar high-order parts together.
+
+#ifndef SCIL_PRECOND_SHUFFLE_H_
+#define SCIL_PRECOND_SHUFFLE_H_
+#include <scil-algorithm-impl.h>
+
+extern scilU_algorithm_t algo_precond_shuffle;
+extern scilU_algorithm_t algo_precond_bitshuffle;
+
+#endif
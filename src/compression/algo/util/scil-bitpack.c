@@ -0,0 +1,266 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <scil-bitpack.h>
+
+#include <scil-error.h>
+#include <scil-util.h>
+
+#include <string.h>
+
+#define LANES SCIL_BITPACK_LANES
+#define PFOR_HEADER_SIZE 9
+
+static inline uint64_t low_mask(int bits){
+  return bits >= 64 ? ~(uint64_t) 0 : ((uint64_t) 1 << bits) - 1;
+}
+
+size_t scil_bitpack_size(size_t count, int bits){
+  const size_t groups = (count + LANES - 1) / LANES;
+  return (groups * bits + 63) / 64 * LANES * 8;
+}
+
+int scil_bitpack_block_offsets(size_t* restrict offsets, const byte* restrict headers, size_t header_size, size_t count, int max_bits, size_t in_size){
+  const size_t blocks = scil_bitpack_block_count(count);
+  if(blocks * header_size > in_size){
+    return SCIL_BUFFER_ERR;
+  }
+  offsets[0] = blocks * header_size;
+  for(size_t b=0; b < blocks; b++){
+    const int bits = headers[b * header_size + header_size - 1];
+    if(bits > max_bits){
+      return SCIL_BUFFER_ERR;
+    }
+    offsets[b + 1] = offsets[b] + scil_bitpack_size(scil_bitpack_block_values(count, b), bits);
+  }
+  return offsets[blocks] > in_size ? SCIL_BUFFER_ERR : SCIL_NO_ERR;
+}
+
+// a group of values, the last one is padded with zeros
+static inline void load_group(uint64_t* restrict v, const uint64_t* restrict values, size_t count, size_t g, uint64_t mask){
+  if(g * LANES + LANES <= count){
+    for(int l=0; l < LANES; l++){
+      v[l] = values[g * LANES + l] & mask;
+    }
+  }else{
+    for(int l=0; l < LANES; l++){
+      v[l] = g * LANES + l < count ? values[g * LANES + l] & mask : 0;
+    }
+  }
+}
+
+size_t scil_bitpack(byte* restrict dest, const uint64_t* restrict values, size_t count, int bits){
+  if(bits == 0){
+    return 0;
+  }
+  const size_t groups = (count + LANES - 1) / LANES;
+  const uint64_t mask = low_mask(bits);
+  uint64_t acc[LANES] = {0};
+  uint64_t v[LANES];
+  int fill = 0;
+  byte* out = dest;
+  for(size_t g=0; g < groups; g++){
+    load_group(v, values, count, g, mask);
+    for(int l=0; l < LANES; l++){
+      acc[l] |= v[l] << fill;
+    }
+    fill += bits;
+    if(fill >= 64){
+      memcpy(out, acc, sizeof(acc));
+      out += sizeof(acc);
+      fill -= 64;
+      // the bits of the values that did not fit
+      for(int l=0; l < LANES; l++){
+        acc[l] = fill > 0 ? v[l] >> (bits - fill) : 0;
+      }
+    }
+  }
+  if(fill > 0){
+    memcpy(out, acc, sizeof(acc));
+    out += sizeof(acc);
+  }
+  return out - dest;
+}
+
+size_t scil_bitunpack(uint64_t* restrict values, const byte* restrict src, size_t count, int bits){
+  const size_t groups = (count + LANES - 1) / LANES;
+  if(bits == 0 || count == 0){
+    memset(values, 0, count * sizeof(uint64_t));
+    return 0;
+  }
+  const uint64_t mask = low_mask(bits);
+  const byte* in = src;
+  uint64_t cur[LANES];
+  uint64_t v[LANES];
+  int fill = 0;
+  memcpy(cur, in, sizeof(cur));
+  for(size_t g=0; g < groups; g++){
+    if(fill + bits <= 64){
+      for(int l=0; l < LANES; l++){
+        v[l] = (cur[l] >> fill) & mask;
+      }
+      fill += bits;
+      if(fill == 64 && g + 1 < groups){
+        in += sizeof(cur);
+        memcpy(cur, in, sizeof(cur));
+        fill = 0;
+      }
+    }else{
+      uint64_t next[LANES];
+      in += sizeof(cur);
+      memcpy(next, in, sizeof(next));
+      for(int l=0; l < LANES; l++){
+        v[l] = ((cur[l] >> fill) | (next[l] << (64 - fill))) & mask;
+        cur[l] = next[l];
+      }
+      fill += bits - 64;
+    }
+    if(g * LANES + LANES <= count){
+      memcpy(values + g * LANES, v, sizeof(v));
+    }else{
+      memcpy(values + g * LANES, v, (count - g * LANES) * sizeof(uint64_t));
+    }
+  }
+  return scil_bitpack_size(count, bits);
+}
+
+uint64_t scil_pfor_reference(const uint64_t* restrict values, size_t count, int bits){
+  if(count == 0){
+    return 0;
+  }
+  // radix selection, each pass counts the next 8 bits of the values that share the selected prefix
+  size_t below = count * SCIL_PFOR_REFERENCE_PERMILLE / 1000;
+  uint64_t prefix = 0;
+  int high = bits;
+  while(1){
+    const int shift = high > 8 ? high - 8 : 0;
+    size_t histogram[256] = {0};
+    for(size_t i=0; i < count; i++){
+      if(high == 64 || values[i] >> high == prefix >> high){
+        histogram[(values[i] >> shift) & 255]++;
+      }
+    }
+    int b = 0;
+    for(; below >= histogram[b]; b++){
+      below -= histogram[b];
+    }
+    prefix |= (uint64_t) b << shift;
+    high = shift;
+    // once the percentile is the smallest value of its bin, the bin minimum is exact
+    if(below == 0 || shift == 0){
+      break;
+    }
+  }
+  uint64_t reference = ~(uint64_t) 0;
+  for(size_t i=0; i < count; i++){
+    if((high == 64 || values[i] >> high == prefix >> high) && values[i] < reference){
+      reference = values[i];
+    }
+  }
+  return reference;
+}
+
+size_t scil_pfor_bound(size_t count, int max_bits){
+  return PFOR_HEADER_SIZE + scil_bitpack_size(count, max_bits);
+}
+
+// the width that minimizes the packed values plus the exceptions, each exception costs its index and upper bits
+static int pfor_width(const uint64_t* restrict values, size_t count, int max_bits, size_t* exceptions){
+  size_t histogram[65] = {0};
+  for(size_t i=0; i < count; i++){
+    histogram[scil_bits_needed(values[i])]++;
+  }
+  const int index_bits = scil_bits_needed(count > 0 ? count - 1 : 0);
+  size_t larger = 0;
+  for(int b = max_bits + 1; b <= 64; b++){
+    larger += histogram[b];
+  }
+  int best = max_bits;
+  size_t best_size = 0;
+  // b = max_bits down to 0, larger holds the number of values with more than b bits
+  for(int b = max_bits; b >= 0; b--){
+    const size_t size = scil_bitpack_size(count, b) + scil_bitpack_size(larger, index_bits) + scil_bitpack_size(larger, max_bits - b);
+    if(b == max_bits || size < best_size){
+      best = b;
+      best_size = size;
+      *exceptions = larger;
+    }
+    larger += histogram[b];
+  }
+  return best;
+}
+
+size_t scil_pfor_compress(byte* restrict dest, const uint64_t* restrict values, size_t count, int max_bits){
+  size_t exceptions = 0;
+  const int bits = pfor_width(values, count, max_bits, & exceptions);
+  byte* out = dest;
+  *out++ = (byte) bits;
+  uint64_t e = exceptions;
+  scilU_pack8(out, e);
+  out += 8;
+  out += scil_bitpack(out, values, count, bits);
+  if(exceptions > 0){
+    uint64_t* index = (uint64_t*) scilU_safe_malloc(2 * exceptions * sizeof(uint64_t));
+    uint64_t* upper = index + exceptions;
+    size_t n = 0;
+    for(size_t i=0; i < count; i++){
+      if(values[i] >> bits != 0){
+        index[n] = i;
+        upper[n] = values[i] >> bits;
+        n++;
+      }
+    }
+    out += scil_bitpack(out, index, exceptions, scil_bits_needed(count - 1));
+    out += scil_bitpack(out, upper, exceptions, max_bits - bits);
+    free(index);
+  }
+  return out - dest;
+}
+
+int scil_pfor_decompress(uint64_t* restrict values, size_t count, int max_bits, const byte* restrict src, size_t src_size, size_t* parsed){
+  if(src_size < PFOR_HEADER_SIZE){
+    return SCIL_BUFFER_ERR;
+  }
+  const byte* in = src;
+  const int bits = *in++;
+  uint64_t exceptions;
+  scilU_unpack8(in, & exceptions);
+  in += 8;
+  const int index_bits = scil_bits_needed(count > 0 ? count - 1 : 0);
+  if(bits > max_bits || exceptions > count){
+    return SCIL_BUFFER_ERR;
+  }
+  const size_t size = PFOR_HEADER_SIZE + scil_bitpack_size(count, bits) + scil_bitpack_size(exceptions, index_bits) + scil_bitpack_size(exceptions, max_bits - bits);
+  if(size > src_size){
+    return SCIL_BUFFER_ERR;
+  }
+  in += scil_bitunpack(values, in, count, bits);
+  if(exceptions > 0){
+    uint64_t* index = (uint64_t*) scilU_safe_malloc(2 * exceptions * sizeof(uint64_t));
+    uint64_t* upper = index + exceptions;
+    in += scil_bitunpack(index, in, exceptions, index_bits);
+    in += scil_bitunpack(upper, in, exceptions, max_bits - bits);
+    for(size_t n=0; n < exceptions; n++){
+      if(index[n] >= count){
+        free(index);
+        return SCIL_BUFFER_ERR;
+      }
+      values[index[n]] |= upper[n] << bits;
+    }
+    free(index);
+  }
+  *parsed = size;
+  return SCIL_NO_ERR;
+}
@@ -0,0 +1,117 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_BITPACK_H
+#define SCIL_BITPACK_H
+
+/**
+ * \file
+ * \brief Bit packing of 64-bit integers and patched frame-of-reference (PFOR) coding.
+ *
+ * The packed values are interleaved across SCIL_BITPACK_LANES 64-bit words, value i is stored in lane i % SCIL_BITPACK_LANES.
+ * All lanes share the same bit offset, thus the packing and unpacking loops over the lanes are vectorized by the compiler.
+ * The last group of values is padded with zeros.
+ *
+ * PFOR packs the values with a width b that minimizes the total size, values that need more than b bits are exceptions.
+ * The stream consists of the width (1 byte), the number of exceptions (8 bytes), the packed lower b bits of all values,
+ * the packed indices of the exceptions and their packed upper bits.
+ */
+
+#include <scil-algorithm-impl.h>
+
+#define SCIL_BITPACK_LANES 4
+
+#define SCIL_PFOR_REFERENCE_PERMILLE 1
+
+// the number of values of the blocks of scil_bitpack_block_offsets()
+#define SCIL_BITPACK_BLOCK_SIZE 4096
+
+/**
+ * \brief The number of bytes needed to pack count values with the given number of bits
+ */
+size_t scil_bitpack_size(size_t count, int bits);
+
+/**
+ * \brief Pack the lower bits of each value
+ * \return The number of bytes written, i.e., scil_bitpack_size(count, bits)
+ */
+size_t scil_bitpack(byte* restrict dest, const uint64_t* restrict values, size_t count, int bits);
+
+/**
+ * \brief Unpack count values that were packed with the given number of bits
+ * \return The number of bytes read
+ */
+size_t scil_bitunpack(uint64_t* restrict values, const byte* restrict src, size_t count, int bits);
+
+/**
+ * \brief The number of blocks of SCIL_BITPACK_BLOCK_SIZE values needed for count values
+ */
+static inline size_t scil_bitpack_block_count(size_t count){
+  return (count + SCIL_BITPACK_BLOCK_SIZE - 1) / SCIL_BITPACK_BLOCK_SIZE;
+}
+
+/**
+ * \brief The number of values of block b, only the last block may be smaller
+ */
+static inline size_t scil_bitpack_block_values(size_t count, size_t b){
+  return count - b * SCIL_BITPACK_BLOCK_SIZE < SCIL_BITPACK_BLOCK_SIZE ? count - b * SCIL_BITPACK_BLOCK_SIZE : SCIL_BITPACK_BLOCK_SIZE;
+}
+
+/**
+ * \brief The offsets of independently packed blocks of SCIL_BITPACK_BLOCK_SIZE values
+ *
+ * The headers of all blocks precede the packed blocks, each header has header_size bytes and ends with
+ * the number of bits of the block. Thus, the offsets of all blocks are known before unpacking.
+ * \param offsets Receives the offset of each block relative to headers and the end of the last block, i.e., blocks + 1 entries
+ * \param in_size The number of bytes available from headers on
+ * \return SCIL_BUFFER_ERR if a block needs more than max_bits bits or ends beyond in_size
+ */
+int scil_bitpack_block_offsets(size_t* restrict offsets, const byte* restrict headers, size_t header_size, size_t count, int max_bits, size_t in_size);
+
+/**
+ * \brief The number of bits needed to store the value
+ */
+static inline int scil_bits_needed(uint64_t value){
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+/**
+ * \brief A frame of reference below all but the lowest SCIL_PFOR_REFERENCE_PERMILLE of the values
+ *
+ * Subtracting it modulo 2^bits turns rare low outliers into large values, i.e., into exceptions.
+ * \param bits The number of bits of the largest value
+ */
+uint64_t scil_pfor_reference(const uint64_t* restrict values, size_t count, int bits);
+
+/**
+ * \brief The maximum size of a PFOR stream for values of up to max_bits bits
+ */
+size_t scil_pfor_bound(size_t count, int max_bits);
+
+/**
+ * \brief Encode the values with PFOR, the width is chosen from the distribution of the bit lengths
+ * \param max_bits The number of bits of the largest value
+ * \return The number of bytes written
+ */
+size_t scil_pfor_compress(byte* restrict dest, const uint64_t* restrict values, size_t count, int max_bits);
+
+/**
+ * \brief Decode count values, the exceptions are patched into the unpacked values
+ * \param parsed Receives the number of bytes read
+ * \return scil error code
+ */
+int scil_pfor_decompress(uint64_t* restrict values, size_t count, int max_bits, const byte* restrict src, size_t src_size, size_t* parsed);
+
+#endif /* SCIL_BITPACK_H */
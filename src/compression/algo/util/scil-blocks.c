@@ -0,0 +1,145 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <scil-blocks.h>
+
+#include <string.h>
+
+static size_t header_size(size_t blocks){
+  return 9 + (blocks > 1 ? 4 * (blocks - 1) : 0);
+}
+
+int scil_blocks_compress(const scil_context_t* ctx, const scil_block_codec_t* codec, byte* restrict dest, size_t* restrict out_size, const byte* restrict source, const size_t source_size){
+  const size_t block_size = ((size_t) 1) << SCIL_BLOCKS_DEFAULT_LOG;
+  const size_t blocks = (source_size + block_size - 1) / block_size;
+  // the context is NULL when the randomness of data is estimated
+  const int threads = ctx != NULL ? ctx->hints.thread_count : 1;
+
+  uint64_t size = source_size;
+  uint8_t block_log = SCIL_BLOCKS_DEFAULT_LOG;
+  scilU_pack8(dest, size);
+  scilU_pack1((dest + 8), block_log);
+  byte * table = dest + 9;
+  byte * pos = dest + header_size(blocks);
+
+  if(threads <= 1 || blocks == 1){
+    for(size_t i=0; i < blocks; i++){
+      const size_t len = i == blocks - 1 ? source_size - i * block_size : block_size;
+      uint32_t csize = codec->compress(ctx, pos, codec->bound(len), source + i * block_size, len);
+      if(csize == 0){
+        return SCIL_UNKNOWN_ERR;
+      }
+      if(i < blocks - 1){
+        scilU_pack4((table + 4 * i), csize);
+      }
+      pos += csize;
+    }
+    *out_size = pos - dest;
+    return SCIL_NO_ERR;
+  }
+
+  // each block is compressed into the destination behind the bounds of the blocks before it and then moved into place,
+  // which needs no more space than the sequential case in the worst case
+  size_t * offsets = scilU_safe_malloc(sizeof(size_t) * blocks);
+  size_t * csizes = scilU_safe_malloc(sizeof(size_t) * blocks);
+  size_t offset = 0;
+  for(size_t i=0; i < blocks; i++){
+    const size_t len = i == blocks - 1 ? source_size - i * block_size : block_size;
+    offsets[i] = offset;
+    offset += codec->bound(len);
+  }
+
+  #pragma omp parallel for num_threads(threads) schedule(dynamic)
+  for(size_t i=0; i < blocks; i++){
+    const size_t len = i == blocks - 1 ? source_size - i * block_size : block_size;
+    csizes[i] = codec->compress(ctx, pos + offsets[i], codec->bound(len), source + i * block_size, len);
+  }
+
+  int ret = SCIL_NO_ERR;
+  offset = 0;
+  for(size_t i=0; i < blocks; i++){
+    // a size of 0 marks a failed block
+    if(csizes[i] == 0){
+      ret = SCIL_UNKNOWN_ERR;
+      break;
+    }
+    // a block never moves behind its own position, hence, it cannot overwrite the following blocks
+    memmove(pos + offset, pos + offsets[i], csizes[i]);
+    offset += csizes[i];
+    if(i < blocks - 1){
+      uint32_t csize = csizes[i];
+      scilU_pack4((table + 4 * i), csize);
+    }
+  }
+  *out_size = pos + offset - dest;
+  free(csizes);
+  free(offsets);
+  return ret;
+}
+
+int scil_blocks_decompress(const scil_block_codec_t* codec, byte* restrict dest, size_t buff_size, const byte* restrict src, const size_t in_size, size_t* uncomp_size_out){
+  uint64_t size;
+  uint8_t block_log;
+  if(in_size < 9){
+    return SCIL_BUFFER_ERR;
+  }
+  scilU_unpack8(src, & size);
+  scilU_unpack1((src + 8), & block_log);
+  if(size > buff_size || block_log > 40){
+    return SCIL_BUFFER_ERR;
+  }
+  const size_t block_size = ((size_t) 1) << block_log;
+  const size_t blocks = (size + block_size - 1) / block_size;
+  const size_t hsize = header_size(blocks);
+  if(hsize > in_size){
+    return SCIL_BUFFER_ERR;
+  }
+
+  size_t * offsets = scilU_safe_malloc(sizeof(size_t) * (blocks + 1));
+  size_t offset = hsize;
+  for(size_t i=0; i < blocks; i++){
+    offsets[i] = offset;
+    if(i < blocks - 1){
+      uint32_t csize;
+      scilU_unpack4((src + 9 + 4 * i), & csize);
+      offset += csize;
+    }else{
+      offset = in_size;
+    }
+  }
+  offsets[blocks] = in_size;
+  if(blocks > 0 && offsets[blocks - 1] > in_size){
+    free(offsets);
+    return SCIL_BUFFER_ERR;
+  }
+
+  int * status = scilU_safe_malloc(sizeof(int) * (blocks + 1));
+  #pragma omp parallel for if(blocks > 1) schedule(dynamic)
+  for(size_t i=0; i < blocks; i++){
+    const size_t len = i == blocks - 1 ? size - i * block_size : block_size;
+    status[i] = codec->decompress(dest + i * block_size, len, src + offsets[i], offsets[i + 1] - offsets[i]);
+  }
+  int ret = SCIL_NO_ERR;
+  for(size_t i=0; i < blocks; i++){
+    if(status[i] != SCIL_NO_ERR){
+      ret = status[i];
+    }
+  }
+  free(status);
+  free(offsets);
+
+  *uncomp_size_out = size;
+  return ret;
+}
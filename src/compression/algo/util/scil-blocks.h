@@ -0,0 +1,53 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_BLOCKS_H
+#define SCIL_BLOCKS_H
+
+/**
+ * \file
+ * \brief Splits the input of a byte compressor into independent blocks that are processed in parallel.
+ *
+ * Layout: uncompressed size (8 bytes), log2 of the block size (1 byte),
+ * the compressed size of all blocks but the last one (4 bytes each), the compressed blocks.
+ */
+
+#include <scil-algorithm-impl.h>
+
+// 1 MiB blocks
+#define SCIL_BLOCKS_DEFAULT_LOG 20
+
+typedef struct{
+  /** \brief Compress one block, returns the compressed size or 0 on error */
+  size_t (*compress)(const scil_context_t* ctx, byte* restrict dest, size_t dest_capacity, const byte* restrict src, size_t src_size);
+  /** \brief Decompress one block, which must yield exactly dest_size bytes */
+  int (*decompress)(byte* restrict dest, size_t dest_size, const byte* restrict src, size_t src_size);
+  /** \brief The maximum compressed size of a block */
+  size_t (*bound)(size_t src_size);
+} scil_block_codec_t;
+
+/**
+ * \brief Compress the blocks with ctx->hints.thread_count threads, ctx may be NULL
+ * \return scil error code
+ */
+int scil_blocks_compress(const scil_context_t* ctx, const scil_block_codec_t* codec, byte* restrict dest, size_t* restrict out_size, const byte* restrict source, const size_t source_size);
+
+/**
+ * \brief Decompress the blocks in parallel, the number of threads is determined by OpenMP
+ * \return scil error code
+ */
+int scil_blocks_decompress(const scil_block_codec_t* codec, byte* restrict dest, size_t buff_size, const byte* restrict src, const size_t in_size, size_t* uncomp_size_out);
+
+#endif /* SCIL_BLOCKS_H */
@@ -0,0 +1,81 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_ENTROPY_H
+#define SCIL_ENTROPY_H
+
+/**
+ * \file
+ * \brief The symbol model shared by the entropy coders for 64-bit integer words.
+ *
+ * A word is mapped with zigzag coding, values below SCIL_ENTROPY_DIRECT_SYMBOLS are symbols of their own.
+ * Larger values with b bits are coded by the symbol SCIL_ENTROPY_DIRECT_SYMBOLS + b - SCIL_ENTROPY_DIRECT_BITS - 1
+ * followed by the b - 1 bits below the leading one.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <scil.h>
+
+#define SCIL_ENTROPY_DIRECT_BITS 10
+#define SCIL_ENTROPY_DIRECT_SYMBOLS (1 << SCIL_ENTROPY_DIRECT_BITS)
+#define SCIL_ENTROPY_ALPHABET_SIZE (SCIL_ENTROPY_DIRECT_SYMBOLS + 64 - SCIL_ENTROPY_DIRECT_BITS)
+
+static inline uint64_t scil_entropy_zigzag(uint64_t w){
+  return (w << 1) ^ (uint64_t) ((int64_t) w >> 63);
+}
+
+static inline uint64_t scil_entropy_unzigzag(uint64_t z){
+  return (z >> 1) ^ (~(z & 1) + 1);
+}
+
+static inline uint16_t scil_entropy_symbol(uint64_t z){
+  return z < SCIL_ENTROPY_DIRECT_SYMBOLS ? (uint16_t) z : (uint16_t) (SCIL_ENTROPY_DIRECT_SYMBOLS + 63 - __builtin_clzll(z) - SCIL_ENTROPY_DIRECT_BITS);
+}
+
+// the number of raw bits after a symbol, the leading one is implicit
+static inline int scil_entropy_extra_bits(uint16_t symbol){
+  return symbol < SCIL_ENTROPY_DIRECT_SYMBOLS ? 0 : symbol - SCIL_ENTROPY_DIRECT_SYMBOLS + SCIL_ENTROPY_DIRECT_BITS;
+}
+
+static inline uint64_t scil_entropy_load_word(const byte* in){
+  uint64_t w;
+  memcpy(& w, in, 8);
+  return w;
+}
+
+static inline void scil_entropy_store_word(byte* out, uint64_t w){
+  memcpy(out, & w, 8);
+}
+
+/**
+ * \brief Maps the words to symbols and counts them
+ * \param counts Array of SCIL_ENTROPY_ALPHABET_SIZE counters, they must be zero
+ * \return The alphabet size, i.e., the largest symbol + 1
+ */
+static inline int scil_entropy_symbolize(uint16_t* restrict symbols, uint64_t* restrict counts, const byte* restrict source, const size_t words){
+  for(size_t i=0; i < words; i++){
+    symbols[i] = scil_entropy_symbol(scil_entropy_zigzag(scil_entropy_load_word(source + 8 * i)));
+    counts[symbols[i]]++;
+  }
+  int alphabet = SCIL_ENTROPY_ALPHABET_SIZE;
+  while(alphabet > 1 && counts[alphabet - 1] == 0){
+    alphabet--;
+  }
+  return alphabet;
+}
+
+#endif /* SCIL_ENTROPY_H */
@@ -0,0 +1,425 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <scil-lorenzo.h>
+#include <scil-prefix-sum.h>
+#include <scil-error.h>
+
+#include <string.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// smaller inputs are processed by a single thread
+#define PARALLEL_MIN_COUNT (1<<16)
+// number of columns processed by one work item of a row pass
+#define COLUMN_CHUNK 4096
+
+//Supported datatypes: int8_t int16_t int32_t int64_t
+// Repeat for each data type
+
+static void row_diff_<DATATYPE>(u<DATATYPE>* restrict out, const u<DATATYPE>* restrict in, size_t count){
+  out[0] = in[0];
+  for(size_t i=1; i < count; i++){
+    out[i] = in[i] - in[i-1];
+  }
+}
+
+
+// dst and a may be identical
+static inline void sub_<DATATYPE>(u<DATATYPE>* dst, const u<DATATYPE>* a, const u<DATATYPE>* b, size_t count){
+  for(size_t i=0; i < count; i++){
+    dst[i] = a[i] - b[i];
+  }
+}
+
+static inline void add_<DATATYPE>(u<DATATYPE>* dst, const u<DATATYPE>* a, const u<DATATYPE>* b, size_t count){
+  for(size_t i=0; i < count; i++){
+    dst[i] = a[i] + b[i];
+  }
+}
+
+/*
+ * A pass along a dimension with the given stride (number of elements of one row) and length,
+ * outer is the number of independent slabs of stride * length elements.
+ */
+static void encode_rows_<DATATYPE>(u<DATATYPE>* data, size_t stride, size_t length, size_t outer, int threads){
+  const size_t chunks = (stride + COLUMN_CHUNK - 1) / COLUMN_CHUNK;
+  const size_t units = outer * chunks;
+  #pragma omp parallel for num_threads(threads) if(threads > 1) schedule(static)
+  for(size_t unit=0; unit < units; unit++){
+    const size_t col = (unit % chunks) * COLUMN_CHUNK;
+    const size_t width = stride - col < COLUMN_CHUNK ? stride - col : COLUMN_CHUNK;
+    u<DATATYPE>* base = data + (unit / chunks) * stride * length + col;
+    for(size_t k=length - 1; k > 0; k--){
+      sub_<DATATYPE>(base + k * stride, base + k * stride, base + (k - 1) * stride, width);
+    }
+  }
+}
+
+static void decode_rows_<DATATYPE>(u<DATATYPE>* out, const u<DATATYPE>* in, size_t stride, size_t length, size_t outer, int threads){
+  const size_t chunks = (stride + COLUMN_CHUNK - 1) / COLUMN_CHUNK;
+  const size_t units = outer * chunks;
+  #pragma omp parallel for num_threads(threads) if(threads > 1) schedule(static)
+  for(size_t unit=0; unit < units; unit++){
+    const size_t col = (unit % chunks) * COLUMN_CHUNK;
+    const size_t width = stride - col < COLUMN_CHUNK ? stride - col : COLUMN_CHUNK;
+    const size_t offset = (unit / chunks) * stride * length + col;
+    u<DATATYPE>* o = out + offset;
+    const u<DATATYPE>* i = in + offset;
+    if(o != i){
+      for(size_t c=0; c < width; c++){
+        o[c] = i[c];
+      }
+    }
+    for(size_t k=1; k < length; k++){
+      add_<DATATYPE>(o + k * stride, i + k * stride, o + (k - 1) * stride, width);
+    }
+  }
+}
+
+void scil_lorenzo_encode_<DATATYPE>(u<DATATYPE>* restrict buf_out, const u<DATATYPE>* restrict buf_in, const scil_dims_t* dims, int threads){
+  const size_t count = scil_dims_get_count(dims);
+  if(count == 0){
+    return;
+  }
+  if(count < PARALLEL_MIN_COUNT){
+    threads = 1;
+  }
+  const size_t row = dims->length[0];
+  const size_t rows = count / row;
+  if(rows == 1){
+    // a single row is split among the threads
+    buf_out[0] = buf_in[0];
+    #pragma omp parallel for num_threads(threads) if(threads > 1) schedule(static)
+    for(size_t i=1; i < row; i++){
+      buf_out[i] = buf_in[i] - buf_in[i-1];
+    }
+    return;
+  }
+  #pragma omp parallel for num_threads(threads) if(threads > 1) schedule(static)
+  for(size_t r=0; r < rows; r++){
+    row_diff_<DATATYPE>(buf_out + r * row, buf_in + r * row, row);
+  }
+
+  size_t stride = row;
+  for(int d=1; d < dims->dims; d++){
+    const size_t length = dims->length[d];
+    encode_rows_<DATATYPE>(buf_out, stride, length, count / (stride * length), threads);
+    stride *= length;
+  }
+}
+
+void scil_lorenzo_decode_<DATATYPE>(u<DATATYPE>* restrict buf_out, const u<DATATYPE>* restrict buf_in, const scil_dims_t* dims){
+  const size_t count = scil_dims_get_count(dims);
+  if(count == 0){
+    return;
+  }
+#ifdef _OPENMP
+  const int threads = count < PARALLEL_MIN_COUNT ? 1 : omp_get_max_threads();
+#else
+  const int threads = 1;
+#endif
+  // the passes commute
+  const u<DATATYPE>* src = buf_in;
+  size_t stride = count;
+  for(int d=dims->dims - 1; d > 0; d--){
+    const size_t length = dims->length[d];
+    stride /= length;
+    decode_rows_<DATATYPE>(buf_out, src, stride, length, count / (stride * length), threads);
+    src = buf_out;
+  }
+
+  const size_t row = dims->length[0];
+  const size_t rows = count / row;
+  #pragma omp parallel for num_threads(threads) if(threads > 1 && rows > 1) schedule(static)
+  for(size_t r=0; r < rows; r++){
+    scil_prefix_sum_<DATATYPE>(buf_out + r * row, src + r * row, row, rows > 1 ? 1 : threads);
+  }
+}
+
+// End repeat
+
+/*
+ * Floating point values are predicted in their own arithmetic, the residual is the difference of
+ * the value and the prediction mapped to ordered integers. The prediction of a value depends on
+ * the already reconstructed neighbours, therefore the decoder processes tiles of a row segment
+ * in wavefronts: a tile only depends on tiles whose coordinate sum is smaller.
+ */
+
+// number of values of a row processed by one tile
+#define TILE 1024
+
+typedef struct{
+  int dims;
+  size_t length[SCIL_DIMS_MAX];
+  size_t stride[SCIL_DIMS_MAX];
+  size_t rows;
+  size_t chunks;
+} lorenzo_geometry_t;
+
+static void geometry_init(lorenzo_geometry_t* g, const scil_dims_t* dims){
+  g->dims = dims->dims;
+  size_t stride = 1;
+  for(int d=0; d < dims->dims; d++){
+    g->length[d] = dims->length[d];
+    g->stride[d] = stride;
+    stride *= dims->length[d];
+  }
+  g->rows = stride / g->length[0];
+  g->chunks = (g->length[0] + TILE - 1) / TILE;
+}
+
+// sum of the coordinates of the row, i.e., its distance from the origin
+static size_t row_wave(const lorenzo_geometry_t* g, size_t row){
+  size_t sum = 0;
+  for(int d=1; d < g->dims; d++){
+    sum += row % g->length[d];
+    row /= g->length[d];
+  }
+  return sum;
+}
+
+/*
+ * Determines the offsets of the rows preceding the row in all combinations of the higher
+ * dimensions, the sign of a term is negative for an odd number of dimensions.
+ */
+static int row_terms(const lorenzo_geometry_t* g, size_t row, size_t* offsets, int* negative){
+  int valid = 0;
+  size_t r = row;
+  for(int d=1; d < g->dims; d++){
+    if(r % g->length[d] > 0){
+      valid |= 1 << (d - 1);
+    }
+    r /= g->length[d];
+  }
+  int count = 0;
+  for(int t=1; t < (1 << (g->dims - 1)); t++){
+    if((t & valid) != t){
+      continue;
+    }
+    size_t offset = 0;
+    int bits = 0;
+    for(int d=1; d < g->dims; d++){
+      if(t & (1 << (d - 1))){
+        offset += g->stride[d];
+        bits++;
+      }
+    }
+    offsets[count] = offset;
+    negative[count] = bits % 2;
+    count++;
+  }
+  return count;
+}
+
+/*
+ * Orders the tiles by their wavefront, tiles with the same wave index are independent.
+ * Returns the tiles and the first position of every wave, waves_out receives the number of waves.
+ */
+static size_t* sort_tiles(const lorenzo_geometry_t* g, size_t** wave_start_out, size_t* waves_out){
+  size_t waves = g->chunks;
+  for(int d=1; d < g->dims; d++){
+    waves += g->length[d] - 1;
+  }
+  const size_t tiles = g->rows * g->chunks;
+  size_t* order = malloc(tiles * sizeof(size_t));
+  size_t* start = calloc(waves + 1, sizeof(size_t));
+  if(order == NULL || start == NULL){
+    free(order);
+    free(start);
+    return NULL;
+  }
+  for(size_t r=0; r < g->rows; r++){
+    const size_t w = row_wave(g, r);
+    for(size_t k=0; k < g->chunks; k++){
+      start[w + k + 1]++;
+    }
+  }
+  for(size_t w=0; w < waves; w++){
+    start[w + 1] += start[w];
+  }
+  size_t* pos = malloc(waves * sizeof(size_t));
+  if(pos == NULL){
+    free(order);
+    free(start);
+    return NULL;
+  }
+  memcpy(pos, start, waves * sizeof(size_t));
+  for(size_t r=0; r < g->rows; r++){
+    const size_t w = row_wave(g, r);
+    for(size_t k=0; k < g->chunks; k++){
+      order[pos[w + k]++] = r * g->chunks + k;
+    }
+  }
+  free(pos);
+  *wave_start_out = start;
+  *waves_out = waves;
+  return order;
+}
+
+//Supported datatypes: float double
+// Repeat for each data type
+
+#define SIGN_<DATATYPE_UPPER> (((uint<DATATYPE_SIZE>_t) 1) << (<DATATYPE_SIZE> - 1))
+
+// maps the bits of a floating point number to an integer of the same order
+static inline uint<DATATYPE_SIZE>_t order_<DATATYPE>(<DATATYPE> value){
+  uint<DATATYPE_SIZE>_t x;
+  memcpy(& x, & value, sizeof(x));
+  return x ^ ((uint<DATATYPE_SIZE>_t) ((int<DATATYPE_SIZE>_t) x >> (<DATATYPE_SIZE> - 1)) | SIGN_<DATATYPE_UPPER>);
+}
+
+static inline <DATATYPE> unorder_<DATATYPE>(uint<DATATYPE_SIZE>_t x){
+  x ^= (uint<DATATYPE_SIZE>_t) ~((int<DATATYPE_SIZE>_t) x >> (<DATATYPE_SIZE> - 1)) | SIGN_<DATATYPE_UPPER>;
+  <DATATYPE> value;
+  memcpy(& value, & x, sizeof(x));
+  return value;
+}
+
+/*
+ * Computes the contribution q of the preceding rows to the values [first, last) of the row
+ * starting at x, q[0] belongs to first - 1 if first > 0.
+ * The prediction of x[i] is then x[i-1] + q[i-1] - q[i].
+ */
+static void row_contribution_<DATATYPE>(<DATATYPE>* restrict q, const <DATATYPE>* x, size_t first, size_t last, const size_t* offsets, const int* negative, int terms){
+  const size_t begin = first > 0 ? first - 1 : 0;
+  const size_t n = last - begin;
+  for(size_t i=0; i < n; i++){
+    q[i] = 0;
+  }
+  for(int t=0; t < terms; t++){
+    const <DATATYPE>* prev = x + begin - offsets[t];
+    if(negative[t]){
+      for(size_t i=0; i < n; i++){
+        q[i] -= prev[i];
+      }
+    }else{
+      for(size_t i=0; i < n; i++){
+        q[i] += prev[i];
+      }
+    }
+  }
+}
+
+static void encode_tile_<DATATYPE>(const lorenzo_geometry_t* g, uint<DATATYPE_SIZE>_t* restrict out, const <DATATYPE>* restrict in, size_t tile){
+  const size_t row = tile / g->chunks;
+  const size_t first = (tile % g->chunks) * TILE;
+  const size_t last = first + TILE < g->length[0] ? first + TILE : g->length[0];
+  size_t offsets[1 << (SCIL_DIMS_MAX - 1)];
+  int negative[1 << (SCIL_DIMS_MAX - 1)];
+  <DATATYPE> q[TILE + 1];
+  const int terms = row_terms(g, row, offsets, negative);
+  const <DATATYPE>* x = in + row * g->length[0];
+  uint<DATATYPE_SIZE>_t* r = out + row * g->length[0];
+
+  row_contribution_<DATATYPE>(q, x, first, last, offsets, negative, terms);
+  // qi[j] belongs to position i + j
+  const <DATATYPE>* qi = q + 1;
+  size_t i = first;
+  if(first == 0){
+    r[0] = order_<DATATYPE>(x[0]) - order_<DATATYPE>((<DATATYPE>) 0 - q[0]);
+    i = 1;
+  }
+  for(; i < last; i++, qi++){
+    const <DATATYPE> p = (x[i-1] + qi[-1]) - qi[0];
+    r[i] = order_<DATATYPE>(x[i]) - order_<DATATYPE>(p);
+  }
+}
+
+static void decode_tile_<DATATYPE>(const lorenzo_geometry_t* g, <DATATYPE>* out, const uint<DATATYPE_SIZE>_t* in, size_t tile){
+  const size_t row = tile / g->chunks;
+  const size_t first = (tile % g->chunks) * TILE;
+  const size_t last = first + TILE < g->length[0] ? first + TILE : g->length[0];
+  size_t offsets[1 << (SCIL_DIMS_MAX - 1)];
+  int negative[1 << (SCIL_DIMS_MAX - 1)];
+  <DATATYPE> q[TILE + 1];
+  const int terms = row_terms(g, row, offsets, negative);
+  <DATATYPE>* x = out + row * g->length[0];
+  const uint<DATATYPE_SIZE>_t* r = in + row * g->length[0];
+
+  row_contribution_<DATATYPE>(q, x, first, last, offsets, negative, terms);
+  const <DATATYPE>* qi = q + 1;
+  size_t i = first;
+  if(first == 0){
+    x[0] = unorder_<DATATYPE>(r[0] + order_<DATATYPE>((<DATATYPE>) 0 - q[0]));
+    i = 1;
+  }
+  for(; i < last; i++, qi++){
+    const <DATATYPE> p = (x[i-1] + qi[-1]) - qi[0];
+    x[i] = unorder_<DATATYPE>(r[i] + order_<DATATYPE>(p));
+  }
+}
+
+void scil_lorenzo_encode_<DATATYPE>(uint<DATATYPE_SIZE>_t* restrict buf_out, const <DATATYPE>* restrict buf_in, const scil_dims_t* dims, int threads){
+  const size_t count = scil_dims_get_count(dims);
+  if(count == 0){
+    return;
+  }
+  if(count < PARALLEL_MIN_COUNT){
+    threads = 1;
+  }
+  lorenzo_geometry_t g;
+  geometry_init(& g, dims);
+  const size_t tiles = g.rows * g.chunks;
+  // the residuals only depend on the input, all tiles are independent
+  #pragma omp parallel for num_threads(threads) if(threads > 1) schedule(static)
+  for(size_t t=0; t < tiles; t++){
+    encode_tile_<DATATYPE>(& g, buf_out, buf_in, t);
+  }
+}
+
+int scil_lorenzo_decode_<DATATYPE>(<DATATYPE>* restrict buf_out, const uint<DATATYPE_SIZE>_t* restrict buf_in, const scil_dims_t* dims){
+  const size_t count = scil_dims_get_count(dims);
+  if(count == 0){
+    return SCIL_NO_ERR;
+  }
+  lorenzo_geometry_t g;
+  geometry_init(& g, dims);
+  const size_t tiles = g.rows * g.chunks;
+#ifdef _OPENMP
+  const int threads = count < PARALLEL_MIN_COUNT ? 1 : omp_get_max_threads();
+#else
+  const int threads = 1;
+#endif
+  if(threads <= 1){
+    // rows and tiles in memory order satisfy all dependencies
+    for(size_t t=0; t < tiles; t++){
+      decode_tile_<DATATYPE>(& g, buf_out, buf_in, t);
+    }
+    return SCIL_NO_ERR;
+  }
+
+  size_t* wave_start;
+  size_t waves;
+  size_t* order = sort_tiles(& g, & wave_start, & waves);
+  if(order == NULL){
+    return SCIL_MEMORY_ERR;
+  }
+  #pragma omp parallel num_threads(threads)
+  for(size_t w=0; w < waves; w++){
+    // the implicit barrier at the end of the loop separates the waves
+    #pragma omp for schedule(static)
+    for(size_t t=wave_start[w]; t < wave_start[w + 1]; t++){
+      decode_tile_<DATATYPE>(& g, buf_out, buf_in, order[t]);
+    }
+  }
+  free(order);
+  free(wave_start);
+  return SCIL_NO_ERR;
+}
+
+// End repeat
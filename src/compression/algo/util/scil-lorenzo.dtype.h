@@ -0,0 +1,72 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_LORENZO_H_
+#define SCIL_LORENZO_H_
+
+/**
+ * \file
+ * \brief N-dimensional Lorenzo predictor, a value is predicted from its neighbours with smaller
+ * indices in all dimensions.
+ *
+ * For integers the residual is the finite difference along every dimension computed with
+ * wrap-around arithmetic, the dimensions are processed one after another: a pass along
+ * dimension 0 works on independent rows, a pass along a higher dimension subtracts (adds)
+ * entire rows and is vectorized and parallelized over the columns.
+ *
+ * Floating point values are predicted in floating point arithmetic, the residual is the
+ * difference of the value and its prediction mapped to integers of the same order.
+ * The decoder reconstructs tiles of the rows in parallel wavefronts.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <scil-dims.h>
+
+//Supported datatypes: int8_t int16_t int32_t int64_t
+// Repeat for each data type
+
+/**
+ * \brief Computes the Lorenzo residual of buf_in
+ * \param threads Number of threads to use, 0 or 1 for serial
+ */
+void scil_lorenzo_encode_<DATATYPE>(u<DATATYPE>* restrict buf_out, const u<DATATYPE>* restrict buf_in, const scil_dims_t* dims, int threads);
+
+/**
+ * \brief Reverts scil_lorenzo_encode_<DATATYPE>(), the number of threads is determined by OpenMP
+ */
+void scil_lorenzo_decode_<DATATYPE>(u<DATATYPE>* restrict buf_out, const u<DATATYPE>* restrict buf_in, const scil_dims_t* dims);
+
+// End repeat
+
+//Supported datatypes: float double
+// Repeat for each data type
+
+/**
+ * \brief Computes the residual of buf_in as ordered integers
+ * \param threads Number of threads to use, 0 or 1 for serial
+ */
+void scil_lorenzo_encode_<DATATYPE>(uint<DATATYPE_SIZE>_t* restrict buf_out, const <DATATYPE>* restrict buf_in, const scil_dims_t* dims, int threads);
+
+/**
+ * \brief Reverts scil_lorenzo_encode_<DATATYPE>(), the number of threads is determined by OpenMP
+ * \return SCIL error code
+ */
+int scil_lorenzo_decode_<DATATYPE>(<DATATYPE>* restrict buf_out, const uint<DATATYPE_SIZE>_t* restrict buf_in, const scil_dims_t* dims);
+
+// End repeat
+
+#endif
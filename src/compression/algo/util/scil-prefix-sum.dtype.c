@@ -0,0 +1,135 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <scil-prefix-sum.h>
+
+#include <scil-util.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// smaller inputs are scanned by a single thread
+#define PARALLEL_MIN_COUNT (1<<18)
+
+//Supported datatypes: int8_t int16_t int32_t int64_t
+// Repeat for each data type
+
+#ifdef __SSE2__
+// the prefix sum of the lanes of x, computed with log2(lanes) shifted additions
+static inline __m128i vector_prefix_<DATATYPE>(__m128i x){
+  if(<DATATYPE_SIZE_BYTE> <= 1){
+    x = _mm_add_epi<DATATYPE_SIZE>(x, _mm_slli_si128(x, 1));
+  }
+  if(<DATATYPE_SIZE_BYTE> <= 2){
+    x = _mm_add_epi<DATATYPE_SIZE>(x, _mm_slli_si128(x, 2));
+  }
+  if(<DATATYPE_SIZE_BYTE> <= 4){
+    x = _mm_add_epi<DATATYPE_SIZE>(x, _mm_slli_si128(x, 4));
+  }
+  return _mm_add_epi<DATATYPE_SIZE>(x, _mm_slli_si128(x, 8));
+}
+
+// broadcasts the last lane of x
+static inline __m128i vector_last_<DATATYPE>(__m128i x){
+  switch(<DATATYPE_SIZE_BYTE>){
+    case 1:
+      x = _mm_unpackhi_epi8(x, x);
+      // fall through
+    case 2:
+      x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+      // fall through
+    case 4:
+      return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    default:
+      return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2));
+  }
+}
+
+static inline __m128i vector_set_<DATATYPE>(u<DATATYPE> value){
+  switch(<DATATYPE_SIZE_BYTE>){
+    case 1:
+      return _mm_set1_epi8((char) value);
+    case 2:
+      return _mm_set1_epi16((short) value);
+    case 4:
+      return _mm_set1_epi32((int) value);
+    default:
+      return _mm_set1_epi64x((long long) value);
+  }
+}
+#endif
+
+// scans count values starting with carry, returns the last sum
+static u<DATATYPE> prefix_sum_<DATATYPE>(u<DATATYPE>* out, const u<DATATYPE>* in, size_t count, u<DATATYPE> carry){
+  size_t i = 0;
+#ifdef __SSE2__
+  const size_t lanes = 16 / sizeof(u<DATATYPE>);
+  if(count >= lanes){
+    __m128i c = vector_set_<DATATYPE>(carry);
+    for(; i + lanes <= count; i += lanes){
+      __m128i x = _mm_loadu_si128((const __m128i*)(in + i));
+      x = _mm_add_epi<DATATYPE_SIZE>(vector_prefix_<DATATYPE>(x), c);
+      _mm_storeu_si128((__m128i*)(out + i), x);
+      c = vector_last_<DATATYPE>(x);
+    }
+    carry = out[i - 1];
+  }
+#endif
+  for(; i < count; i++){
+    carry += in[i];
+    out[i] = carry;
+  }
+  return carry;
+}
+
+static u<DATATYPE> sum_<DATATYPE>(const u<DATATYPE>* in, size_t count){
+  u<DATATYPE> sum = 0;
+  for(size_t i=0; i < count; i++){
+    sum += in[i];
+  }
+  return sum;
+}
+
+void scil_prefix_sum_<DATATYPE>(u<DATATYPE>* buf_out, const u<DATATYPE>* buf_in, size_t count, int threads){
+  if(threads <= 1 || count < PARALLEL_MIN_COUNT){
+    prefix_sum_<DATATYPE>(buf_out, buf_in, count, 0);
+    return;
+  }
+  const size_t block = (count + threads - 1) / threads;
+  u<DATATYPE>* offsets = (u<DATATYPE>*) scilU_safe_malloc(threads * sizeof(u<DATATYPE>));
+
+  #pragma omp parallel for num_threads(threads) schedule(static)
+  for(int b=0; b < threads; b++){
+    const size_t start = b * block < count ? b * block : count;
+    const size_t end = start + block < count ? start + block : count;
+    offsets[b] = sum_<DATATYPE>(buf_in + start, end - start);
+  }
+  u<DATATYPE> offset = 0;
+  for(int b=0; b < threads; b++){
+    const u<DATATYPE> sum = offsets[b];
+    offsets[b] = offset;
+    offset += sum;
+  }
+  #pragma omp parallel for num_threads(threads) schedule(static)
+  for(int b=0; b < threads; b++){
+    const size_t start = b * block < count ? b * block : count;
+    const size_t end = start + block < count ? start + block : count;
+    prefix_sum_<DATATYPE>(buf_out + start, buf_in + start, end - start, offsets[b]);
+  }
+  free(offsets);
+}
+
+// End repeat
@@ -0,0 +1,42 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_PREFIX_SUM_H_
+#define SCIL_PREFIX_SUM_H_
+
+/**
+ * \file
+ * \brief Inclusive prefix sums with wrap-around arithmetic.
+ *
+ * The scan is computed in SSE2 registers, larger inputs are split into one block per thread:
+ * the first pass sums the blocks, the second pass scans each block starting with the sum of
+ * the preceding blocks.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+
+//Supported datatypes: int8_t int16_t int32_t int64_t
+// Repeat for each data type
+
+/**
+ * \brief Computes buf_out[i] = buf_in[0] + ... + buf_in[i], buf_out and buf_in may be identical
+ * \param threads Number of threads to use, 0 or 1 for serial
+ */
+void scil_prefix_sum_<DATATYPE>(u<DATATYPE>* buf_out, const u<DATATYPE>* buf_in, size_t count, int threads);
+
+// End repeat
+
+#endif
@@ -0,0 +1,267 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <scil-shuffle.h>
+
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static void byte_shuffle_scalar(byte* restrict out, const byte* restrict in, const size_t start, const size_t count, const int type_size){
+  for(int b=0; b < type_size; b++){
+    byte* plane = out + b * count;
+    for(size_t i=start; i < count; i++){
+      plane[i] = in[i * type_size + b];
+    }
+  }
+}
+
+static void byte_unshuffle_scalar(byte* restrict out, const byte* restrict in, const size_t start, const size_t count, const int type_size){
+  for(int b=0; b < type_size; b++){
+    const byte* plane = in + b * count;
+    for(size_t i=start; i < count; i++){
+      out[i * type_size + b] = plane[i];
+    }
+  }
+}
+
+#ifdef __SSE2__
+/*
+ * Interleaves the bytes of vector i and i + n/2, this rotates the bits of the byte position
+ * within the n vectors left by one. Transposing 16 elements of n bytes requires a rotation by
+ * 4 bits, the inverse a rotation by log2(n) bits.
+ */
+static inline void interleave_round(__m128i* v, const int n){
+  __m128i t[8];
+  for(int i=0; i < n / 2; i++){
+    t[2*i] = _mm_unpacklo_epi8(v[i], v[i + n / 2]);
+    t[2*i + 1] = _mm_unpackhi_epi8(v[i], v[i + n / 2]);
+  }
+  for(int i=0; i < n; i++){
+    v[i] = t[i];
+  }
+}
+
+static size_t byte_shuffle_sse2(byte* restrict out, const byte* restrict in, const size_t count, const int type_size){
+  const size_t vec_count = count - count % 16;
+  __m128i v[8];
+  for(size_t j=0; j < vec_count; j += 16){
+    for(int k=0; k < type_size; k++){
+      v[k] = _mm_loadu_si128((const __m128i*)(in + j * type_size + 16 * k));
+    }
+    for(int r=0; r < 4; r++){
+      interleave_round(v, type_size);
+    }
+    for(int k=0; k < type_size; k++){
+      _mm_storeu_si128((__m128i*)(out + k * count + j), v[k]);
+    }
+  }
+  return vec_count;
+}
+
+static size_t byte_unshuffle_sse2(byte* restrict out, const byte* restrict in, const size_t count, const int type_size){
+  const size_t vec_count = count - count % 16;
+  const int rounds = type_size == 8 ? 3 : type_size / 2;
+  __m128i v[8];
+  for(size_t j=0; j < vec_count; j += 16){
+    for(int k=0; k < type_size; k++){
+      v[k] = _mm_loadu_si128((const __m128i*)(in + k * count + j));
+    }
+    for(int r=0; r < rounds; r++){
+      interleave_round(v, type_size);
+    }
+    for(int k=0; k < type_size; k++){
+      _mm_storeu_si128((__m128i*)(out + j * type_size + 16 * k), v[k]);
+    }
+  }
+  return vec_count;
+}
+#endif
+
+void scil_byte_shuffle(byte* restrict buf_out, const byte* restrict buf_in, const size_t count, const int type_size){
+  size_t start = 0;
+  if(type_size == 1){
+    memcpy(buf_out, buf_in, count);
+    return;
+  }
+#ifdef __SSE2__
+  if(type_size == 2 || type_size == 4 || type_size == 8){
+    start = byte_shuffle_sse2(buf_out, buf_in, count, type_size);
+  }
+#endif
+  byte_shuffle_scalar(buf_out, buf_in, start, count, type_size);
+}
+
+void scil_byte_unshuffle(byte* restrict buf_out, const byte* restrict buf_in, const size_t count, const int type_size){
+  size_t start = 0;
+  if(type_size == 1){
+    memcpy(buf_out, buf_in, count);
+    return;
+  }
+#ifdef __SSE2__
+  if(type_size == 2 || type_size == 4 || type_size == 8){
+    start = byte_unshuffle_sse2(buf_out, buf_in, count, type_size);
+  }
+#endif
+  byte_unshuffle_scalar(buf_out, buf_in, start, count, type_size);
+}
+
+// Transposes the 8x8 bit matrix stored in x, bit 8*r + c becomes bit 8*c + r
+static inline uint64_t transpose8(uint64_t x){
+  uint64_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+  x = x ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+  x = x ^ t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+  x = x ^ t ^ (t << 28);
+  return x;
+}
+
+// the bits of groups starting with start_group, 8 elements per group
+static void bit_shuffle_scalar(byte* restrict buf_out, const byte* restrict buf_in, const size_t start_group, const size_t count, const int type_size){
+  const size_t groups = count / 8;
+  for(size_t g=start_group; g < groups; g++){
+    const byte* in = buf_in + g * 8 * type_size;
+    for(int b=0; b < type_size; b++){
+      uint64_t x = 0;
+      for(int e=0; e < 8; e++){
+        x |= ((uint64_t) in[e * type_size + b]) << (8 * e);
+      }
+      x = transpose8(x);
+      byte* plane = buf_out + b * count;
+      for(int i=0; i < 8; i++){
+        plane[i * groups + g] = (byte) (x >> (8 * i));
+      }
+    }
+  }
+}
+
+static void bit_unshuffle_scalar(byte* restrict buf_out, const byte* restrict buf_in, const size_t start_group, const size_t count, const int type_size){
+  const size_t groups = count / 8;
+  for(size_t g=start_group; g < groups; g++){
+    byte* out = buf_out + g * 8 * type_size;
+    for(int b=0; b < type_size; b++){
+      const byte* plane = buf_in + b * count;
+      uint64_t x = 0;
+      for(int i=0; i < 8; i++){
+        x |= ((uint64_t) plane[i * groups + g]) << (8 * i);
+      }
+      x = transpose8(x);
+      for(int e=0; e < 8; e++){
+        out[e * type_size + b] = (byte) (x >> (8 * e));
+      }
+    }
+  }
+}
+
+#ifdef __SSE2__
+/*
+ * Two groups of 8 elements are processed at once: the byte shuffle collects byte b of 16 elements
+ * in one vector, then movemask extracts the top bit of all lanes, i.e., the bit plane of two groups,
+ * and doubling the lanes moves the next bit to the top.
+ * The inverse broadcasts the two bytes of a bit plane to the lanes and tests the bit of each lane.
+ */
+static size_t bit_shuffle_sse2(byte* restrict buf_out, const byte* restrict buf_in, const size_t count, const int type_size){
+  const size_t groups = count / 8;
+  const size_t vec_groups = groups - groups % 2;
+  __m128i v[8];
+  for(size_t g=0; g < vec_groups; g += 2){
+    const byte* in = buf_in + g * 8 * type_size;
+    for(int k=0; k < type_size; k++){
+      v[k] = _mm_loadu_si128((const __m128i*)(in + 16 * k));
+    }
+    if(type_size > 1){
+      for(int r=0; r < 4; r++){
+        interleave_round(v, type_size);
+      }
+    }
+    for(int b=0; b < type_size; b++){
+      byte* plane = buf_out + b * count;
+      __m128i x = v[b];
+      for(int i=7; i >= 0; i--){
+        const int mask = _mm_movemask_epi8(x);
+        plane[i * groups + g] = (byte) mask;
+        plane[i * groups + g + 1] = (byte) (mask >> 8);
+        x = _mm_add_epi8(x, x);
+      }
+    }
+  }
+  return vec_groups;
+}
+
+static size_t bit_unshuffle_sse2(byte* restrict buf_out, const byte* restrict buf_in, const size_t count, const int type_size){
+  const size_t groups = count / 8;
+  const size_t vec_groups = groups - groups % 2;
+  const int rounds = type_size == 8 ? 3 : type_size / 2;
+  const __m128i select = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+  __m128i v[8];
+  for(size_t g=0; g < vec_groups; g += 2){
+    for(int b=0; b < type_size; b++){
+      const byte* plane = buf_in + b * count;
+      __m128i x = _mm_setzero_si128();
+      for(int i=0; i < 8; i++){
+        const __m128i m = _mm_unpacklo_epi64(_mm_set1_epi8((char) plane[i * groups + g]), _mm_set1_epi8((char) plane[i * groups + g + 1]));
+        const __m128i bits = _mm_cmpeq_epi8(_mm_and_si128(m, select), select);
+        x = _mm_or_si128(x, _mm_and_si128(bits, _mm_set1_epi8((char) (1 << i))));
+      }
+      v[b] = x;
+    }
+    for(int r=0; r < rounds; r++){
+      interleave_round(v, type_size);
+    }
+    byte* out = buf_out + g * 8 * type_size;
+    for(int k=0; k < type_size; k++){
+      _mm_storeu_si128((__m128i*)(out + 16 * k), v[k]);
+    }
+  }
+  return vec_groups;
+}
+#endif
+
+void scil_bit_shuffle(byte* restrict buf_out, const byte* restrict buf_in, const size_t count, const int type_size){
+  size_t start = 0;
+#ifdef __SSE2__
+  if(type_size == 1 || type_size == 2 || type_size == 4 || type_size == 8){
+    start = bit_shuffle_sse2(buf_out, buf_in, count, type_size);
+  }
+#endif
+  bit_shuffle_scalar(buf_out, buf_in, start, count, type_size);
+  // the remaining elements are stored bytewise after the bit planes
+  for(int b=0; b < type_size; b++){
+    byte* plane = buf_out + b * count;
+    for(size_t i=count / 8 * 8; i < count; i++){
+      plane[i] = buf_in[i * type_size + b];
+    }
+  }
+}
+
+void scil_bit_unshuffle(byte* restrict buf_out, const byte* restrict buf_in, const size_t count, const int type_size){
+  size_t start = 0;
+#ifdef __SSE2__
+  if(type_size == 1 || type_size == 2 || type_size == 4 || type_size == 8){
+    start = bit_unshuffle_sse2(buf_out, buf_in, count, type_size);
+  }
+#endif
+  bit_unshuffle_scalar(buf_out, buf_in, start, count, type_size);
+  for(int b=0; b < type_size; b++){
+    const byte* plane = buf_in + b * count;
+    for(size_t i=count / 8 * 8; i < count; i++){
+      buf_out[i * type_size + b] = plane[i];
+    }
+  }
+}
@@ -0,0 +1,49 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_SHUFFLE_H
+#define SCIL_SHUFFLE_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <scil.h>
+
+/**
+ * \brief Transposes count elements of type_size bytes, i.e., byte k of all elements is stored in plane k
+ * \param buf_out Destination buffer of count * type_size bytes
+ * \param buf_in Source buffer, must not overlap with buf_out
+ */
+void scil_byte_shuffle(byte* restrict buf_out, const byte* restrict buf_in, const size_t count, const int type_size);
+
+/**
+ * \brief Reverts scil_byte_shuffle()
+ */
+void scil_byte_unshuffle(byte* restrict buf_out, const byte* restrict buf_in, const size_t count, const int type_size);
+
+/**
+ * \brief Transposes count elements of type_size bytes bitwise, i.e., bit k of all elements is stored in plane k.
+ * Each byte plane holds 8 bit planes for the first count - count % 8 elements, the remaining bytes are copied.
+ * \param buf_out Destination buffer of count * type_size bytes
+ * \param buf_in Source buffer, must not overlap with buf_out
+ */
+void scil_bit_shuffle(byte* restrict buf_out, const byte* restrict buf_in, const size_t count, const int type_size);
+
+/**
+ * \brief Reverts scil_bit_shuffle()
+ */
+void scil_bit_unshuffle(byte* restrict buf_out, const byte* restrict buf_in, const size_t count, const int type_size);
+
+#endif /* SCIL_SHUFFLE_H */
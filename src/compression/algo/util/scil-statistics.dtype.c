@@ -0,0 +1,60 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <scil-statistics.h>
+
+#include <float.h>
+
+void scil_invalidate_statistics(const scil_context_t* ctx){
+  ctx->statistics->source = NULL;
+}
+
+static int is_cached(const scil_statistics_cache_t* cache, const void* source, size_t count, double ignore_up_to, double ignore_from, double fill_value){
+  if (cache->source != source || cache->count != count){
+    return 0;
+  }
+  return scilU_double_equal(cache->ignore_up_to, ignore_up_to) && scilU_double_equal(cache->ignore_from, ignore_from) && scilU_double_equal(cache->fill_value, fill_value);
+}
+
+//Supported datatypes: int8_t int16_t int32_t int64_t float double
+// Repeat for each data type
+
+static void get_statistics_<DATATYPE>(const scil_context_t* ctx, const <DATATYPE>* restrict source, size_t count, scilU_statistics_<DATATYPE>_t* out, double ignore_up_to, double ignore_from, double fill_value){
+  scil_statistics_cache_t* cache = ctx->statistics;
+  if (! cache->enabled){
+    scilU_compute_statistics_<DATATYPE>(source, count, out, ignore_up_to, ignore_from, fill_value, ctx->hints.thread_count);
+    return;
+  }
+  scilU_statistics_<DATATYPE>_t* cached = (scilU_statistics_<DATATYPE>_t*) & cache->statistics;
+  if (! is_cached(cache, source, count, ignore_up_to, ignore_from, fill_value)){
+    scilU_compute_statistics_<DATATYPE>(source, count, cached, ignore_up_to, ignore_from, fill_value, ctx->hints.thread_count);
+    cache->source = source;
+    cache->count = count;
+    cache->ignore_up_to = ignore_up_to;
+    cache->ignore_from = ignore_from;
+    cache->fill_value = fill_value;
+  }
+  *out = *cached;
+}
+
+void scil_get_statistics_<DATATYPE>(const scil_context_t* ctx, const <DATATYPE>* restrict source, size_t count, scilU_statistics_<DATATYPE>_t* out){
+  get_statistics_<DATATYPE>(ctx, source, count, out, ctx->hints.lossless_data_range_up_to, ctx->hints.lossless_data_range_from, ctx->hints.fill_value);
+}
+
+void scil_get_statistics_all_<DATATYPE>(const scil_context_t* ctx, const <DATATYPE>* restrict source, size_t count, scilU_statistics_<DATATYPE>_t* out){
+  get_statistics_<DATATYPE>(ctx, source, count, out, -DBL_MAX, DBL_MAX, DBL_MAX);
+}
+
+// End repeat
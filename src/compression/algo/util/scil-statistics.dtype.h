@@ -0,0 +1,51 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_STATISTICS_H_
+#define SCIL_STATISTICS_H_
+
+/**
+ * \file
+ * \brief Statistics of the input of a compressor, cached in the context.
+ *
+ * Fill values and values outside of the lossless range of the hints are excluded.
+ * The statistics are computed with ctx->hints.thread_count threads.
+ * Within scil_compress() they are computed once per input, further algorithms and the chooser
+ * scanning the same input get the cached result.
+ */
+
+#include <scil-algorithm-impl.h>
+
+//Supported datatypes: int8_t int16_t int32_t int64_t float double
+// Repeat for each data type
+
+/**
+ * \brief Returns the statistics of source, computed with the exclusion given by the hints of ctx
+ */
+void scil_get_statistics_<DATATYPE>(const scil_context_t* ctx, const <DATATYPE>* restrict source, size_t count, scilU_statistics_<DATATYPE>_t* out);
+
+/**
+ * \brief Returns the statistics of source including all points
+ */
+void scil_get_statistics_all_<DATATYPE>(const scil_context_t* ctx, const <DATATYPE>* restrict source, size_t count, scilU_statistics_<DATATYPE>_t* out);
+
+// End repeat
+
+/**
+ * \brief Drops the cached statistics, must be called after a stage of scil_compress() wrote a buffer
+ */
+void scil_invalidate_statistics(const scil_context_t* ctx);
+
+#endif
@@ -0,0 +1,50 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <scil-zfp.h>
+
+int scil_zfp_field_dims(const scil_dims_t* dims){
+  switch(dims->dims){
+    case 1:
+    case 2:
+    case 3:
+    case 4:
+      return dims->dims;
+    default:
+      return 1;
+  }
+}
+
+zfp_field* scil_zfp_field(void* data, zfp_type type, const scil_dims_t* dims){
+  if(scil_zfp_field_dims(dims) != dims->dims){
+    return zfp_field_1d(data, type, (uint) scil_dims_get_count(dims));
+  }
+  switch(dims->dims){
+    case 2: return zfp_field_2d(data, type, (uint) dims->length[0], (uint) dims->length[1]);
+    case 3: return zfp_field_3d(data, type, (uint) dims->length[0], (uint) dims->length[1], (uint) dims->length[2]);
+    case 4: return zfp_field_4d(data, type, (uint) dims->length[0], (uint) dims->length[1], (uint) dims->length[2], (uint) dims->length[3]);
+    default: return zfp_field_1d(data, type, (uint) dims->length[0]);
+  }
+}
+
+void scil_zfp_set_execution(zfp_stream* zfp, const scil_context_t* ctx){
+  const int threads = ctx->hints.thread_count;
+  if(threads <= 1){
+    return;
+  }
+  if(zfp_stream_set_execution(zfp, zfp_exec_omp)){
+    zfp_stream_set_omp_threads(zfp, (uint) threads);
+  }
+}
@@ -0,0 +1,52 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SCIL_ZFP_H
+#define SCIL_ZFP_H
+
+/**
+ * \file
+ * \brief Setup shared by the algorithms based on zfp.
+ */
+
+#include <scil-algorithm-impl.h>
+
+#include <zfp.h>
+
+// the layout of the data must not depend on the zfp release, 4D fields were introduced with 0.5.4
+#if ! defined(ZFP_VERSION) || ZFP_VERSION < 0x054
+#error "zfp 0.5.4 or later is required"
+#endif
+
+/**
+ * \brief Describe the data to zfp, the dimensions are passed as they are
+ * up to 4D, other layouts are treated as 1D.
+ * \return The field, to be released by zfp_field_free()
+ */
+zfp_field* scil_zfp_field(void* data, zfp_type type, const scil_dims_t* dims);
+
+/**
+ * \brief The number of dimensions of the field created by scil_zfp_field()
+ */
+int scil_zfp_field_dims(const scil_dims_t* dims);
+
+/**
+ * \brief Use the OpenMP execution policy with ctx->hints.thread_count threads,
+ * the stream stays serial if only one thread is requested or zfp lacks OpenMP support.
+ * zfp only offers parallel compression, thus this must not be used for decompression.
+ */
+void scil_zfp_set_execution(zfp_stream* zfp, const scil_context_t* ctx);
+
+#endif /* SCIL_ZFP_H */
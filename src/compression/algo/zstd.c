@@ -15,37 +15,325 @@
 
 #include <algo/zstd.h>
 
+#include <pthread.h>
+#include <stdio.h>
 #include <string.h>
 #include <zstd/zstd.h>
+#include <zstd/zdict.h>
 
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-int scil_zstd_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
+#define SCIL_ZSTD_MAX_DICTIONARIES 16
+
+// the uncompressed size is stored in front of the zstd frame
+#define SCIL_ZSTD_HEADER_SIZE 8
+
+typedef struct{
+  unsigned id;
+  void * buffer;
   size_t size;
-  // store the size of the data
-  *((size_t*) dest) = source_size;
-  // normal compression, not fast
-  //size = LZ4_compress_fast((const char *) (source), (char *) dest + 4, source_size, 2*source_size, 4);
-  size = ZSTD_compress (dest, 2*source_size, source, source_size, 1);
-  *out_size = size + 4;
+  ZSTD_DDict * ddict;
+} scil_zstd_dictionary_t;
+
+// dictionaries known to this process, the decompressor picks them by the ID stored in the frame
+// registered entries are never modified, the lock guards the list against concurrent registrations
+static scil_zstd_dictionary_t dictionaries[SCIL_ZSTD_MAX_DICTIONARIES];
+static int dictionary_count = 0;
+static pthread_mutex_t dictionary_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// decompression has no context, therefore, each thread reuses its own DCtx, which is freed when the thread exits
+static pthread_key_t dctx_key;
+static pthread_once_t dctx_once = PTHREAD_ONCE_INIT;
+
+static void free_dctx(void * dctx){
+  ZSTD_freeDCtx((ZSTD_DCtx*) dctx);
+}
+
+static void create_dctx_key(void){
+  pthread_key_create(& dctx_key, free_dctx);
+}
+
+static ZSTD_DCtx * get_dctx(void){
+  pthread_once(& dctx_once, create_dctx_key);
+  ZSTD_DCtx * dctx = (ZSTD_DCtx*) pthread_getspecific(dctx_key);
+  if(dctx == NULL){
+    dctx = ZSTD_createDCtx();
+    if(dctx != NULL){
+      pthread_setspecific(dctx_key, dctx);
+    }
+  }
+  return dctx;
+}
+
+typedef struct{
+  ZSTD_CCtx * cctx;
+  ZSTD_CDict * cdict;
+} scil_zstd_state_t;
+
+// the caller must hold dictionary_lock
+static scil_zstd_dictionary_t * find_dictionary(unsigned id){
+  for(int i=0; i < dictionary_count; i++){
+    if(dictionaries[i].id == id){
+      return & dictionaries[i];
+    }
+  }
+  return NULL;
+}
+
+static scil_zstd_dictionary_t * lookup_dictionary(unsigned id){
+  pthread_mutex_lock(& dictionary_lock);
+  scil_zstd_dictionary_t * d = find_dictionary(id);
+  pthread_mutex_unlock(& dictionary_lock);
+  return d;
+}
+
+int scil_zstd_register_dictionary(const void * dict, const size_t dict_size, unsigned * out_id){
+  unsigned id = ZDICT_getDictID(dict, dict_size);
+  if(id == 0){
+    debug("zstd: the dictionary is not in zstd format\n");
+    return SCIL_EINVAL;
+  }
+  if(out_id != NULL){
+    *out_id = id;
+  }
+  int ret = SCIL_NO_ERR;
+  pthread_mutex_lock(& dictionary_lock);
+  if(find_dictionary(id) != NULL){
+    // already registered
+  }else if(dictionary_count == SCIL_ZSTD_MAX_DICTIONARIES){
+    debug("zstd: too many dictionaries registered\n");
+    ret = SCIL_MEMORY_ERR;
+  }else{
+    scil_zstd_dictionary_t * d = & dictionaries[dictionary_count];
+    d->buffer = scilU_safe_malloc(dict_size);
+    memcpy(d->buffer, dict, dict_size);
+    d->size = dict_size;
+    d->id = id;
+    d->ddict = ZSTD_createDDict(d->buffer, dict_size);
+    if(d->ddict == NULL){
+      free(d->buffer);
+      ret = SCIL_MEMORY_ERR;
+    }else{
+      dictionary_count++;
+    }
+  }
+  pthread_mutex_unlock(& dictionary_lock);
+  return ret;
+}
+
+int scil_zstd_train_dictionary(void * dict_out, size_t * dict_size_in_out, const void * samples, const size_t * sample_sizes, unsigned sample_count){
+  size_t ret = ZDICT_trainFromBuffer(dict_out, *dict_size_in_out, samples, sample_sizes, sample_count);
+  if(ZDICT_isError(ret)){
+    debug("zstd: dictionary training failed: %s\n", ZDICT_getErrorName(ret));
+    return SCIL_EINVAL;
+  }
+  *dict_size_in_out = ret;
+  return SCIL_NO_ERR;
+}
+
+static int load_dictionary_file(const char * filename, scil_zstd_dictionary_t ** out_dict){
+  FILE * fd = fopen(filename, "rb");
+  if(fd == NULL){
+    debug("zstd: could not open the dictionary %s\n", filename);
+    return SCIL_EINVAL;
+  }
+  fseek(fd, 0, SEEK_END);
+  long size = ftell(fd);
+  fseek(fd, 0, SEEK_SET);
+  if(size <= 0){
+    fclose(fd);
+    return SCIL_EINVAL;
+  }
+  byte * buffer = scilU_safe_malloc(size);
+  size_t read = fread(buffer, 1, size, fd);
+  fclose(fd);
+
+  int ret = SCIL_EINVAL;
+  unsigned id;
+  if(read == (size_t) size){
+    ret = scil_zstd_register_dictionary(buffer, size, & id);
+  }
+  free(buffer);
+  if(ret == SCIL_NO_ERR){
+    *out_dict = lookup_dictionary(id);
+  }
+  return ret;
+}
+
+static void destroy_state(void * s){
+  scil_zstd_state_t * state = (scil_zstd_state_t*) s;
+  ZSTD_freeCCtx(state->cctx);
+  ZSTD_freeCDict(state->cdict);
+  free(state);
+}
+
+static int set_parameter(ZSTD_CCtx * cctx, ZSTD_cParameter param, int value){
+  size_t ret = ZSTD_CCtx_setParameter(cctx, param, value);
+  if(ZSTD_isError(ret)){
+    debug("zstd: invalid parameter %d=%d: %s\n", (int) param, value, ZSTD_getErrorName(ret));
+    return SCIL_EINVAL;
+  }
+  return SCIL_NO_ERR;
+}
+
+// The CCtx is configured once from the hints of the context, the parameters stick between frames
+static int create_state(const scil_context_t* ctx, int level, scil_zstd_state_t ** out_state){
+  const scil_user_hints_t * hints = & ctx->hints;
+  scil_zstd_state_t * state = scilU_safe_malloc(sizeof(scil_zstd_state_t));
+  memset(state, 0, sizeof(scil_zstd_state_t));
+  state->cctx = ZSTD_createCCtx();
+  if(state->cctx == NULL){
+    free(state);
+    return SCIL_MEMORY_ERR;
+  }
+
+  int ret = set_parameter(state->cctx, ZSTD_c_compressionLevel, level);
+  if(ret == SCIL_NO_ERR && hints->byte_compression_strategy != 0){
+    ret = set_parameter(state->cctx, ZSTD_c_strategy, hints->byte_compression_strategy);
+  }
+  if(ret == SCIL_NO_ERR && hints->byte_compression_window_log != 0){
+    ret = set_parameter(state->cctx, ZSTD_c_windowLog, hints->byte_compression_window_log);
+  }
+  if(ret == SCIL_NO_ERR && hints->thread_count > 1){
+    // requires libzstd built with ZSTD_MULTITHREAD, otherwise we compress single threaded
+    if(set_parameter(state->cctx, ZSTD_c_nbWorkers, hints->thread_count) != SCIL_NO_ERR){
+      debug("zstd: multi-threading is not supported by the library\n");
+    }
+  }
+  if(ret == SCIL_NO_ERR && hints->byte_compression_dictionary != NULL){
+    scil_zstd_dictionary_t * dict;
+    ret = load_dictionary_file(hints->byte_compression_dictionary, & dict);
+    if(ret == SCIL_NO_ERR){
+      state->cdict = ZSTD_createCDict(dict->buffer, dict->size, level);
+      if(state->cdict == NULL){
+        ret = SCIL_MEMORY_ERR;
+      }else{
+        ZSTD_CCtx_refCDict(state->cctx, state->cdict);
+      }
+    }
+  }
+  if(ret != SCIL_NO_ERR){
+    destroy_state(state);
+    return ret;
+  }
+  *out_state = state;
+  return SCIL_NO_ERR;
+}
 
-  if (size == 0){
-      return -1;
+static int zstd_compress(const scil_context_t* ctx, const scilU_algorithm_t * algo, int default_level, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
+  // the workspace is updated although the context is const, a context is never used by two threads at once
+  scil_workspace_slot_t * slot = & ctx->workspace[algo->compressor_id];
+  if(slot->state == NULL){
+    int level = default_level;
+    if(algo == & algo_zstd && ctx->hints.byte_compression_level != 0){
+      level = ctx->hints.byte_compression_level;
+    }
+    scil_zstd_state_t * state;
+    int ret = create_state(ctx, level, & state);
+    if(ret != SCIL_NO_ERR){
+      return ret;
     }
+    slot->state = state;
+    slot->destroy = destroy_state;
+  }
+  scil_zstd_state_t * state = (scil_zstd_state_t*) slot->state;
 
-  return 0;
+  uint64_t size = source_size;
+  scilU_pack8(dest, size);
+  size_t ret = ZSTD_compress2(state->cctx, dest + SCIL_ZSTD_HEADER_SIZE, ZSTD_compressBound(source_size), source, source_size);
+  if(ZSTD_isError(ret)){
+    debug("Error in zstd compression: %s\n", ZSTD_getErrorName(ret));
+    return SCIL_UNKNOWN_ERR;
+  }
+  *out_size = ret + SCIL_ZSTD_HEADER_SIZE;
+  return SCIL_NO_ERR;
+}
+
+int scil_zstd_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
+  return zstd_compress(ctx, & algo_zstd, 1, dest, out_size, source, source_size);
+}
+
+int scil_zstd11_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
+  return zstd_compress(ctx, & algo_zstd11, 11, dest, out_size, source, source_size);
+}
+
+int scil_zstd22_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size){
+  return zstd_compress(ctx, & algo_zstd22, 22, dest, out_size, source, source_size);
 }
 
-#pragma GCC diagnostic ignored "-Wunused-parameter"
 int scil_zstd_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out){
-  size_t size;
-  // retrieve the size of the uncompressed data
-  size = *((size_t *) src);
+  uint64_t size;
+  if(in_size < SCIL_ZSTD_HEADER_SIZE){
+    return SCIL_BUFFER_ERR;
+  }
+  scilU_unpack8(src, & size);
+  if(size > buff_size){
+    debug("zstd: buffer of %lld bytes too small for %lld bytes\n", (long long) buff_size, (long long) size);
+    return SCIL_BUFFER_ERR;
+  }
+
+  ZSTD_DCtx * dctx = get_dctx();
+  if(dctx == NULL){
+    return SCIL_MEMORY_ERR;
+  }
+
+  const byte * frame = src + SCIL_ZSTD_HEADER_SIZE;
+  const size_t frame_size = in_size - SCIL_ZSTD_HEADER_SIZE;
+  size_t ret;
+  unsigned id = ZSTD_getDictID_fromFrame(frame, frame_size);
+  if(id != 0){
+    scil_zstd_dictionary_t * dict = lookup_dictionary(id);
+    if(dict == NULL){
+      debug("zstd: the dictionary %u is not registered\n", id);
+      return SCIL_EINVAL;
+    }
+    ret = ZSTD_decompress_usingDDict(dctx, dest, size, frame, frame_size, dict->ddict);
+  }else{
+    ret = ZSTD_decompressDCtx(dctx, dest, size, frame, frame_size);
+  }
+  if(ZSTD_isError(ret) || ret != size){
+    debug("Error in zstd decompression: %s\n", ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "size mismatch");
+    return SCIL_UNKNOWN_ERR;
+  }
   *uncomp_size_out = size;
-  //size = LZ4_decompress_fast((const char *) src + 4, (char *)  dest, size); // LZ4_decompress_safe (source, dest, source_size, exp_size);
-  size = ZSTD_decompress(dest, buff_size, src, in_size);
-  return 0;
+  return SCIL_NO_ERR;
+}
+
+// the raw frame written before the chain format flag, its uncompressed size is taken from the frame,
+// as the size stored in front of it was overwritten and the stream may carry trailing bytes
+static int zstd_v1_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out){
+  size_t frame_size = ZSTD_findFrameCompressedSize(src, in_size);
+  if(ZSTD_isError(frame_size)){
+    debug("zstd: no frame found: %s\n", ZSTD_getErrorName(frame_size));
+    return SCIL_BUFFER_ERR;
+  }
+  // decode exactly the frame content, the decoder would use any capacity behind it as scratch
+  unsigned long long size = ZSTD_getFrameContentSize(src, frame_size);
+  if(size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR || size > buff_size){
+    return SCIL_BUFFER_ERR;
+  }
+  ZSTD_DCtx * dctx = get_dctx();
+  if(dctx == NULL){
+    return SCIL_MEMORY_ERR;
+  }
+  size_t ret = ZSTD_decompressDCtx(dctx, dest, size, src, frame_size);
+  if(ZSTD_isError(ret)){
+    debug("Error in zstd decompression: %s\n", ZSTD_getErrorName(ret));
+    return SCIL_UNKNOWN_ERR;
+  }
+  *uncomp_size_out = ret;
+  return SCIL_NO_ERR;
 }
 
+// decodes the IDs 16 to 18, the variants differ only by the compression level
+scilU_algorithm_t algo_zstd_v1 = {
+    .c.Btype = {
+        NULL,
+        zstd_v1_decompress
+    },
+    "zstd-v1",
+    16,
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES
+};
+
 scilU_algorithm_t algo_zstd = {
     .c.Btype = {
         scil_zstd_compress,
@@ -53,5 +341,28 @@ scilU_algorithm_t algo_zstd = {
     },
     "zstd",
     16,
-    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES,
+    .legacy = & algo_zstd_v1
+};
+
+scilU_algorithm_t algo_zstd11 = {
+    .c.Btype = {
+        scil_zstd11_compress,
+        scil_zstd_decompress
+    },
+    "zstd-11",
+    17,
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES,
+    .legacy = & algo_zstd_v1
+};
+
+scilU_algorithm_t algo_zstd22 = {
+    .c.Btype = {
+        scil_zstd22_compress,
+        scil_zstd_decompress
+    },
+    "zstd-22",
+    18,
+    SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES,
+    .legacy = & algo_zstd_v1
 };
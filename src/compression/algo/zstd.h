@@ -19,10 +19,10 @@
 #include <scil-algorithm-impl.h>
 
 /**
- * \brief ZSTD compression function
- * \param ctx Compression context used for this compression
+ * \brief ZSTD compression function, the level is taken from the byte_compression_level hint (default 1)
+ * \param ctx Compression context used for this compression, it caches the ZSTD_CCtx
  * \param dest Pre allocated buffer which will hold the compressed data
- * \param dest_size Byte size the compressed buffer will have
+ * \param out_size Byte size the compressed buffer will have
  * \param source Uncompressed data which should be processed
  * \param source_size Byte size of uncompressed buffer
  * \return Success state of the compression
@@ -30,16 +30,47 @@
 int scil_zstd_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size);
 
 /**
- * \brief ZSTD decompression function
- * \param ctx Compression context used for this compression
- * \param dest Pre allocated buffer which will hold the compressed data
- * \param dest_size Byte size the compressed buffer will have
- * \param source Uncompressed data which should be processed
- * \param source_size Byte size of uncompressed buffer
- * \return Success state of the compression
+ * \brief ZSTD compression function with the fixed level 11
+ */
+int scil_zstd11_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size);
+
+/**
+ * \brief ZSTD compression function with the fixed level 22
+ */
+int scil_zstd22_compress(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size);
+
+/**
+ * \brief ZSTD decompression function for all zstd variants
+ * \param dest Pre allocated buffer which will hold the decompressed data
+ * \param buff_size Byte size of the buffer dest
+ * \param src Compressed data which should be processed
+ * \param in_size Byte size of compressed buffer
+ * \param uncomp_size_out The byte size of the decompressed data
+ * \return Success state of the decompression
  */
 int scil_zstd_decompress(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out);
 
+/**
+ * \brief Train a zstd dictionary from a number of samples, e.g., typical chunks of a variable
+ * \param dict_out Pre allocated buffer which will hold the dictionary
+ * \param dict_size_in_out In: capacity of dict_out, Out: the size of the dictionary
+ * \param samples The concatenated samples
+ * \param sample_sizes Byte size of each sample
+ * \return Success state of the training
+ */
+int scil_zstd_train_dictionary(void * dict_out, size_t * dict_size_in_out, const void * samples, const size_t * sample_sizes, unsigned sample_count);
+
+/**
+ * \brief Make a dictionary known to the decompressor, may be called concurrently with compression and decompression.
+ * Dictionaries referenced by the byte_compression_dictionary hint are registered automatically.
+ * \param out_id The ID of the dictionary as stored in the compressed frames, may be NULL
+ */
+int scil_zstd_register_dictionary(const void * dict, const size_t dict_size, unsigned * out_id);
+
+// not registered, decodes the streams of the zstd variants written without SCIL_CHAIN_FORMAT_FLAG
+extern scilU_algorithm_t algo_zstd_v1;
 extern scilU_algorithm_t algo_zstd;
+extern scilU_algorithm_t algo_zstd11;
+extern scilU_algorithm_t algo_zstd22;
 
 #endif
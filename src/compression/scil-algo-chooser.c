@@ -24,6 +24,7 @@
 #include <scil-debug.h>
 #include <scil-decision-tree.h>
 
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -33,6 +34,7 @@ scilU_decision_tree* decision_tree;
 
 typedef struct {
   scil_compression_chain_t chain;
+  int datatype; // -1 if the entry holds for all data types
   float randomness;
   float c_speed;
   float d_speed;
@@ -288,13 +290,19 @@ void scilC_algo_chooser_initialize() {
     config_file_entry_t *e = &config_list[config_list_size];
     char name[100];
     char pattern_name[100];
-    int tokens =
-        sscanf(buff, "%f; %s %s %f; %f; %f", &e->randomness, pattern_name, name, &e->c_speed, &e->d_speed, &e->ratio);
-    if (tokens != 6) {
-      warn("Parsing configuration line \"%s\" returned an error after token %d\n", buff, tokens);
-      continue;
+    // lines written by scil-benchmark contain the data type and the pattern
+    int tokens = sscanf(buff, "%f; %d; %99[^;]; %99[^;]; %f; %f; %f",
+                        &e->randomness, &e->datatype, pattern_name, name, &e->c_speed, &e->d_speed, &e->ratio);
+    if (tokens != 7) {
+      e->datatype = -1;
+      tokens =
+          sscanf(buff, "%f; %s %s %f; %f; %f", &e->randomness, pattern_name, name, &e->c_speed, &e->d_speed, &e->ratio);
+      if (tokens != 6) {
+        warn("Parsing configuration line \"%s\" returned an error after token %d\n", buff, tokens);
+        continue;
+      }
+      name[strlen(name) - 1] = 0;
     }
-    name[strlen(name) - 1] = 0;
     ret = scilU_chain_create(&e->chain, name);
     if (ret != SCIL_NO_ERR) {
       warn("Parsing configuration line \"%s\"; could not parse compressor chain \"%s\"\n", buff, name);
@@ -323,6 +331,24 @@ void scilC_algo_chooser_initialize() {
   parse_losless_list();
 }
 
+// the lossless entry measured on data of the closest randomness, the best ratio breaks ties
+static config_file_entry_t *find_lossless_entry(SCIL_Datatype_t datatype, float randomness) {
+  config_file_entry_t *best = NULL;
+  float best_distance = 0;
+  for (int i = 0; i < config_list_lossless_size; i++) {
+    config_file_entry_t *e = config_list_lossless[i];
+    if ((e->datatype != -1 && e->datatype != (int) datatype) || scilU_chain_is_applicable(&e->chain, datatype) != SCIL_NO_ERR) {
+      continue;
+    }
+    const float distance = fabsf(e->randomness - randomness);
+    if (best == NULL || distance < best_distance || (!(distance > best_distance) && e->ratio < best->ratio)) {
+      best = e;
+      best_distance = distance;
+    }
+  }
+  return best;
+}
+
 void scilC_algo_chooser_execute(const void *restrict source,
                                 const scil_dims_t *dims,
                                 scil_context_t *ctx) {
@@ -361,13 +387,21 @@ void scilC_algo_chooser_execute(const void *restrict source,
   }
 
   float r = scilU_get_data_randomness(source, in_size, buffer, out_size);
+  config_file_entry_t *lossless = NULL;
   if (ctx->lossless_compression_needed) {
-    // we can only select byte compressors compress because data must be accurate!
+    // the data must be accurate, thus only lossless chains measured by scil-benchmark qualify
+    lossless = find_lossless_entry(ctx->datatype, r);
   }
   // TODO: pick the best algorithm for the settings given in ctx...
 
   if (r > 95) {
     ret = scilU_chain_create(chain, "memcopy");
+  } else if (lossless != NULL) {
+    *chain = lossless->chain;
+    ret = SCIL_NO_ERR;
+  } else if (ctx->hints.comp_speed.unit == SCIL_PERFORMANCE_IGNORE && ctx->hints.decomp_speed.unit != SCIL_PERFORMANCE_IGNORE) {
+    // only the decompression speed matters, lz4hc decompresses as fast as lz4 with a better ratio
+    ret = scilU_chain_create(chain, "lz4hc");
   } else {
     ret = scilU_chain_create(chain, "lz4");
   }
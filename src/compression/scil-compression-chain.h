@@ -13,6 +13,11 @@
 // at most we support chaining of 10 preconditioners
 #define PRECONDITIONER_LIMIT 10
 
+// The first byte of a compressed stream holds the chain length and this flag,
+// streams without the flag are decoded by the legacy variants of the algorithms
+#define SCIL_CHAIN_FORMAT_FLAG 0x80
+#define SCIL_CHAIN_LENGTH_MASK 0x7f
+
 typedef struct scil_compression_chain {
   struct scil_compression_algorithm* pre_cond_first[PRECONDITIONER_LIMIT]; // preconditioners first stage
   struct scil_compression_algorithm* converter;
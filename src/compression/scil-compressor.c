@@ -10,16 +10,29 @@
 #include <algo/algo-zfp-precision.h>
 #include <algo/lz4fast.h>
 #include <algo/zstd.h>
-#include <algo/zstd-11.h>
-#include <algo/zstd-22.h>
 #include <algo/precond-dummy.h>
 #include <algo/algo-quantize.h>
 #include <algo/algo-swage.h>
-//#include <algo/algo-wavelets.h>
+#include <algo/algo-wavelets.h>
 #include <algo/algo-allquant.h>
 #include <algo/algo-sz.h>
 #include <algo/precond-delta.h>
 #include <algo/precond-fp-delta.h>
+#include <algo/precond-shuffle.h>
+#include <algo/precond-lorenzo.h>
+#include <algo/algo-huffman.h>
+#include <algo/algo-rans.h>
+#include <algo/algo-sz-native.h>
+#include <algo/algo-zfp-rate.h>
+#include <algo/algo-zfp-reversible.h>
+#include <algo/precond-fill.h>
+#include <algo/algo-pfor.h>
+#include <algo/algo-abstol-blocked.h>
+#include <algo/precond-int.h>
+#include <algo/algo-chimp.h>
+#include <algo/algo-for.h>
+#include <algo/algo-half.h>
+#include <algo/algo-multires.h>
 
 #include <scil-debug.h>
 
@@ -28,13 +41,6 @@
 #include <string.h>
 
 
-scilU_algorithm_t algo_wavelets = {// unimplemented at the moment
-    .name = "wavelets",
-    11,
-    SCIL_COMPRESSOR_TYPE_DATATYPES,
-    1
-};
-
 static scilU_algorithm_t* algo_array[] = {
 	& algo_memcopy,
 	& algo_abstol,
@@ -55,6 +61,29 @@ static scilU_algorithm_t* algo_array[] = {
   	& algo_zstd,
   	& algo_zstd11,
   	& algo_zstd22,
+	& algo_lz4hc, // 19
+	& algo_lz4hc12,
+	& algo_precond_shuffle, // 21
+	& algo_precond_bitshuffle,
+	& algo_precond_lorenzo, // 23
+	& algo_precond_lorenzo_int,
+	& algo_huffman, // 25
+	& algo_rans,
+	& algo_sz_native, // 27
+	& algo_zfp_rate,
+	& algo_zfp_reversible, // 29
+	& algo_precond_fill,
+	& algo_pfor, // 31
+	& algo_abstol_blocked,
+	& algo_precond_delta_int, // 33
+	& algo_precond_delta2_int,
+	& algo_precond_zigzag, // 35
+	& algo_chimp,
+	& algo_for, // 37
+	& algo_half,
+	& algo_bfloat16,
+	& algo_sigbits_progressive, // 40
+	& algo_multires,
 	NULL
 };
 
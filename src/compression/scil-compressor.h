@@ -41,6 +41,7 @@ typedef struct scil_compression_algorithm {
 
     struct{
       // Converter from different datatypes to int64_t i.e. quantize
+      // the values are narrowed to the smallest unsigned width that holds them before the second stage
       int (*compress_float)(const scil_context_t* ctx, int64_t* restrict compressed_buf_in_out, size_t* restrict out_size, float*restrict data_in, const scil_dims_t* dims);
       int (*decompress_float)(float*restrict data_out, scil_dims_t* dims, int64_t*restrict compressed_buf_in, const size_t in_size);
 
@@ -63,9 +64,19 @@ typedef struct scil_compression_algorithm {
     struct{
       // for a preconditioner second stage, we expect that the input buffer points only to the ND data, the output data contains
       // the header of the size as returned and then the preconditioned data.
-      int (*compress)(const scil_context_t* ctx, int64_t* restrict data_out, byte*restrict header, int * header_size_out, int64_t*restrict data_in, const scil_dims_t* dims);
+      // The function for the width of the converter output (1, 2, 4 or 8 bytes) is used, the values are unsigned.
+      int (*compress_int8)(const scil_context_t* ctx, int8_t* restrict data_out, byte*restrict header, int * header_size_out, int8_t*restrict data_in, const scil_dims_t* dims);
       // it is the responsiblity of the decompressor to strip the header that is part of compressed_buf_in
-      int (*decompress)(int64_t*restrict data_out, scil_dims_t* dims, int64_t*restrict compressed_buf_in, byte*restrict header_end, int * header_parsed_out);
+      int (*decompress_int8)(int8_t*restrict data_out, scil_dims_t* dims, int8_t*restrict compressed_buf_in, byte*restrict header_end, int * header_parsed_out);
+
+      int (*compress_int16)(const scil_context_t* ctx, int16_t* restrict data_out, byte*restrict header, int * header_size_out, int16_t*restrict data_in, const scil_dims_t* dims);
+      int (*decompress_int16)(int16_t*restrict data_out, scil_dims_t* dims, int16_t*restrict compressed_buf_in, byte*restrict header_end, int * header_parsed_out);
+
+      int (*compress_int32)(const scil_context_t* ctx, int32_t* restrict data_out, byte*restrict header, int * header_size_out, int32_t*restrict data_in, const scil_dims_t* dims);
+      int (*decompress_int32)(int32_t*restrict data_out, scil_dims_t* dims, int32_t*restrict compressed_buf_in, byte*restrict header_end, int * header_parsed_out);
+
+      int (*compress_int64)(const scil_context_t* ctx, int64_t* restrict data_out, byte*restrict header, int * header_size_out, int64_t*restrict data_in, const scil_dims_t* dims);
+      int (*decompress_int64)(int64_t*restrict data_out, scil_dims_t* dims, int64_t*restrict compressed_buf_in, byte*restrict header_end, int * header_parsed_out);
   } PStype; // preconditioner second stage
 
     struct{
@@ -104,6 +115,22 @@ typedef struct scil_compression_algorithm {
 
   enum compressor_type type;
   char is_lossy; // byte compressors are expected to be lossless anyway
+  char int64_words; // byte compressors that code their input as 64-bit words, a converter output is not narrowed for them
+
+  // optional for data compressors, decompresses only the bits needed for significant_bits > 0
+  struct{
+    int (*decompress_float)(float*restrict data_out, scil_dims_t* dims, byte*restrict compressed_buf_in, const size_t in_size, int significant_bits);
+    int (*decompress_double)(double*restrict data_out, scil_dims_t* dims, byte*restrict compressed_buf_in, const size_t in_size, int significant_bits);
+  } precision;
+
+  // optional for data compressors, decompresses every 2^reduction-th point in each dimension for reduction > 0
+  struct{
+    int (*decompress_float)(float*restrict data_out, scil_dims_t* dims, byte*restrict compressed_buf_in, const size_t in_size, int reduction);
+    int (*decompress_double)(double*restrict data_out, scil_dims_t* dims, byte*restrict compressed_buf_in, const size_t in_size, int reduction);
+  } preview;
+
+  // optional, decodes the streams written under the same ID before SCIL_CHAIN_FORMAT_FLAG was introduced
+  struct scil_compression_algorithm* legacy;
 } scilU_algorithm_t;
 
 void scil_initialize_compressors();
@@ -4,6 +4,35 @@
 #include <scil-context.h>
 #include <scil-compression-chain.h>
 
+/** \brief State an algorithm keeps alive between calls with the same context, e.g., an encoder context */
+typedef struct {
+  void *state;
+  /** \brief Invoked on scil_destroy_context() to release the state */
+  void (*destroy)(void *state);
+} scil_workspace_slot_t;
+
+/** \brief Statistics of the last input scanned, see scil_get_statistics_<T>() */
+typedef struct {
+  /** \brief Set by scil_compress(), algorithms invoked directly do not cache */
+  int enabled;
+  /** \brief The scanned input, NULL if nothing is cached */
+  const void *source;
+  size_t count;
+  /** \brief The exclusion the statistics were computed with */
+  double ignore_up_to;
+  double ignore_from;
+  double fill_value;
+  /** \brief Holds the scilU_statistics_<T>_t of the datatype */
+  union {
+    scilU_statistics_float_t flt32;
+    scilU_statistics_double_t flt64;
+    scilU_statistics_int8_t_t int8;
+    scilU_statistics_int16_t_t int16;
+    scilU_statistics_int32_t_t int32;
+    scilU_statistics_int64_t_t int64;
+  } statistics;
+} scil_statistics_cache_t;
+
 struct scil_context {
   int lossless_compression_needed;
   enum SCIL_Datatype datatype;
@@ -18,6 +47,14 @@ struct scil_context {
 
   /** \brief Dictionary for pipeline internal parameters */
   scilU_dict_t *pipeline_params;
+
+  /** \brief Lazily created algorithm state, indexed by the compressor ID.
+   * A context must not be used by multiple threads concurrently. */
+  scil_workspace_slot_t *workspace;
+
+  /** \brief Shared with the copies of the context made for the stages of a chain,
+   * scil_compress() invalidates it for every input. */
+  scil_statistics_cache_t *statistics;
 };
 
 #endif // SCIL_CONTEXT_H
@@ -66,6 +66,10 @@ int scil_context_create(scil_context_t **out_ctx,
   memset(ctx, 0, sizeof(scil_context_t));
 
   ctx->pipeline_params = scilU_dict_create(30);
+  ctx->workspace = (scil_workspace_slot_t *) scilU_safe_malloc(sizeof(scil_workspace_slot_t) * scilU_get_available_compressor_count());
+  memset(ctx->workspace, 0, sizeof(scil_workspace_slot_t) * scilU_get_available_compressor_count());
+  ctx->statistics = (scil_statistics_cache_t *) scilU_safe_malloc(sizeof(scil_statistics_cache_t));
+  memset(ctx->statistics, 0, sizeof(scil_statistics_cache_t));
 
   ctx->datatype = datatype;
   ctx->special_values_count = special_values_count;
@@ -141,6 +145,8 @@ int scil_context_create(scil_context_t **out_ctx,
   if (ret == SCIL_NO_ERR) {
     *out_ctx = ctx;
   } else {
+    free(ctx->workspace);
+    free(ctx->statistics);
     free(ctx);
   }
 
@@ -148,7 +154,16 @@ int scil_context_create(scil_context_t **out_ctx,
 }
 
 int scil_destroy_context(scil_context_t *out_ctx) {
+  for (int i = 0; i < scilU_get_available_compressor_count(); i++) {
+    scil_workspace_slot_t *slot = &out_ctx->workspace[i];
+    if (slot->state != NULL) {
+      slot->destroy(slot->state);
+    }
+  }
+  free(out_ctx->workspace);
+  free(out_ctx->statistics);
   free(out_ctx->hints.force_compression_methods);
+  free(out_ctx->hints.byte_compression_dictionary);
   free(out_ctx);
   out_ctx = NULL;
 
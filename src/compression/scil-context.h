@@ -11,6 +11,8 @@ typedef struct scil_context scil_context_t;
 
 /**
  * \brief Creation of a compression context
+ * A context caches the state of the algorithms between the calls of scil_compress(),
+ * therefore, it must not be used by multiple threads concurrently. Create one context per thread instead.
  * \param datatype The datatype of the data (float, double, etc...)
  * \param out_ctx reference to the created context
  * \param hints information on the tolerable error margin
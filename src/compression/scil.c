@@ -20,6 +20,8 @@
 
 #include <scil-compressor.h>
 #include <scil-compression-chain.h>
+#include <algo/precond-fill.h>
+#include <scil-statistics.h>
 
 #include <ctype.h>
 #include <float.h>
@@ -91,6 +93,74 @@ static inline void* pick_buffer(int is_src,
     }
 }
 
+// the smallest width in bytes of the unsigned values of a converter
+static int get_value_width(const uint64_t* values, const size_t count)
+{
+    uint64_t all = 0;
+    for (size_t i = 0; i < count; i++) {
+        all |= values[i];
+    }
+    if (all >> 32) return 8;
+    if (all >> 16) return 4;
+    if (all >> 8) return 2;
+    return 1;
+}
+
+// in place, the values keep their order
+static void narrow_values(void* buff, const size_t count, const int width)
+{
+    const uint64_t* in = (const uint64_t*)buff;
+    switch (width) {
+        case 1:
+            for (size_t i = 0; i < count; i++) ((uint8_t*)buff)[i] = (uint8_t)in[i];
+            break;
+        case 2:
+            for (size_t i = 0; i < count; i++) ((uint16_t*)buff)[i] = (uint16_t)in[i];
+            break;
+        case 4:
+            for (size_t i = 0; i < count; i++) ((uint32_t*)buff)[i] = (uint32_t)in[i];
+            break;
+    }
+}
+
+static void widen_values(void* restrict buff, const void* restrict in, const size_t count, const int width)
+{
+    uint64_t* out = (uint64_t*)buff;
+    switch (width) {
+        case 1:
+            for (size_t i = 0; i < count; i++) out[i] = ((const uint8_t*)in)[i];
+            break;
+        case 2:
+            for (size_t i = 0; i < count; i++) out[i] = ((const uint16_t*)in)[i];
+            break;
+        case 4:
+            for (size_t i = 0; i < count; i++) out[i] = ((const uint32_t*)in)[i];
+            break;
+    }
+}
+
+static int precond_second_compress(scilU_algorithm_t* algo, const scil_context_t* ctx, const int width, void* dst, byte* header, int* header_size_out, void* src, const scil_dims_t* dims)
+{
+    switch (width) {
+        case 1: return algo->c.PStype.compress_int8(ctx, dst, header, header_size_out, src, dims);
+        case 2: return algo->c.PStype.compress_int16(ctx, dst, header, header_size_out, src, dims);
+        case 4: return algo->c.PStype.compress_int32(ctx, dst, header, header_size_out, src, dims);
+        case 8: return algo->c.PStype.compress_int64(ctx, dst, header, header_size_out, src, dims);
+    }
+    return SCIL_BUFFER_ERR;
+}
+
+static int precond_second_decompress(scilU_algorithm_t* algo, const int width, void* dst, scil_dims_t* dims, void* src, byte* header, int* header_parsed_out)
+{
+    switch (width) {
+        case 1: return algo->c.PStype.decompress_int8(dst, dims, src, header, header_parsed_out);
+        case 2: return algo->c.PStype.decompress_int16(dst, dims, src, header, header_parsed_out);
+        case 4: return algo->c.PStype.decompress_int32(dst, dims, src, header, header_parsed_out);
+        case 8: return algo->c.PStype.decompress_int64(dst, dims, src, header, header_parsed_out);
+    }
+    return SCIL_BUFFER_ERR;
+}
+
 /*
 A compression chain compresses data in multiple phases, i.e., applying algo 1,
 then algo 2 ...
@@ -119,17 +189,19 @@ ALGO(n-1) data compressed using ALGO(n)
 
 If ALGO(n-1) is a datatype specific algorithm, then it usually cannot handle
 arbitrary bytes.
+The header of a converter and of each second preconditioner ends with the width
+of the integer values (1, 2, 4 or 8 bytes) before the compressor ID.
 Therefore, the compressor ID and headers of nested datatypes must be split from
 the data.
 
 A datatype compressor terminates the chain of preconditioners.
  */
-int scil_compress(byte* restrict dest,
-                  size_t in_dest_size,
-                  void* restrict source,
-                  scil_dims_t* dims,
-                  size_t* restrict out_size_p,
-                  scil_context_t* ctx) {
+static int compress_chain(byte* restrict dest,
+                          size_t in_dest_size,
+                          void* restrict source,
+                          scil_dims_t* dims,
+                          size_t* restrict out_size_p,
+                          scil_context_t* ctx) {
 
 	assert(ctx != NULL);
 	assert(dest != NULL);
@@ -206,12 +278,17 @@ int scil_compress(byte* restrict dest,
         scilC_algo_chooser_execute(source, resized_dims, ctx);
     }
 
+    // the stages after the fill preconditioner see the data without fill values
+    scil_context_t ctx_without_fill;
+    const scil_context_t* stage_ctx = ctx;
+
     size_t out_size = 0;
 
     // Add the length of the algo chain to the output
     int remaining_compressors   = chain->total_size;
     const int total_compressors = remaining_compressors;
-    dest[0]                     = total_compressors;
+    int value_width             = sizeof(int64_t); // of the integer values of the converter
+    dest[0]                     = total_compressors | SCIL_CHAIN_FORMAT_FLAG;
     dest++;
 
     // Process the compression pipeline
@@ -234,22 +311,22 @@ int scil_compress(byte* restrict dest,
 
             switch (ctx->datatype) {
                 case (SCIL_TYPE_FLOAT):
-                    ret = algo->c.PFtype.compress_float(ctx, (float*)dst, header, &header_size_out, src, resized_dims);
+                    ret = algo->c.PFtype.compress_float(stage_ctx, (float*)dst, header, &header_size_out, src, resized_dims);
                     break;
                 case (SCIL_TYPE_DOUBLE):
-                    ret = algo->c.PFtype.compress_double(ctx, (double*)dst, header, &header_size_out, src, resized_dims);
+                    ret = algo->c.PFtype.compress_double(stage_ctx, (double*)dst, header, &header_size_out, src, resized_dims);
                     break;
               	case (SCIL_TYPE_INT8) :
-              		ret = algo->c.PFtype.compress_int8(ctx, (int8_t*)dst, header, &header_size_out, src, resized_dims);
+              		ret = algo->c.PFtype.compress_int8(stage_ctx, (int8_t*)dst, header, &header_size_out, src, resized_dims);
               		break;
               	case(SCIL_TYPE_INT16) :
-              		ret = algo->c.PFtype.compress_int16(ctx, (int16_t*)dst, header, &header_size_out, src, resized_dims);
+              		ret = algo->c.PFtype.compress_int16(stage_ctx, (int16_t*)dst, header, &header_size_out, src, resized_dims);
               		break;
               	case(SCIL_TYPE_INT32) :
-              		ret = algo->c.PFtype.compress_int32(ctx, (int32_t*)dst, header, &header_size_out, src, resized_dims);
+              		ret = algo->c.PFtype.compress_int32(stage_ctx, (int32_t*)dst, header, &header_size_out, src, resized_dims);
               		break;
               	case(SCIL_TYPE_INT64) :
-              		ret = algo->c.PFtype.compress_int64(ctx, (int64_t*)dst, header, &header_size_out, src, resized_dims);
+              		ret = algo->c.PFtype.compress_int64(stage_ctx, (int64_t*)dst, header, &header_size_out, src, resized_dims);
               		break;
                 case(SCIL_TYPE_UNKNOWN) :
               	case(SCIL_TYPE_STRING) :
@@ -259,6 +336,14 @@ int scil_compress(byte* restrict dest,
             }
 
             if (ret != 0) return ret;
+            // the statistics of the stage's input do not hold for its output
+            scil_invalidate_statistics(ctx);
+            if (algo == &algo_precond_fill && scil_fill_precond_extracted(header, header_size_out)) {
+                ctx_without_fill = *ctx;
+                ctx_without_fill.hints.fill_value = DBL_MAX;
+                ctx_without_fill.special_values_count = 0;
+                stage_ctx = &ctx_without_fill;
+            }
             remaining_compressors--;
             out_size += header_size_out;
             header   += header_size_out;
@@ -285,22 +370,22 @@ int scil_compress(byte* restrict dest,
         scilU_algorithm_t* algo = chain->converter;
         switch (ctx->datatype) {
             case (SCIL_TYPE_FLOAT):
-                ret = algo->c.Ctype.compress_float(ctx, (int64_t*)dst, &out_size, src, resized_dims);
+                ret = algo->c.Ctype.compress_float(stage_ctx, (int64_t*)dst, &out_size, src, resized_dims);
                 break;
             case (SCIL_TYPE_DOUBLE):
-                ret = algo->c.Ctype.compress_double(ctx, (int64_t*)dst, &out_size, src, resized_dims);
+                ret = algo->c.Ctype.compress_double(stage_ctx, (int64_t*)dst, &out_size, src, resized_dims);
                 break;
           	case (SCIL_TYPE_INT8) :
-          		ret = algo->c.Ctype.compress_int8(ctx, (int64_t*)dst, &out_size, src, resized_dims);
+          		ret = algo->c.Ctype.compress_int8(stage_ctx, (int64_t*)dst, &out_size, src, resized_dims);
           		break;
           	case(SCIL_TYPE_INT16) :
-          		ret = algo->c.Ctype.compress_int16(ctx, (int64_t*)dst, &out_size, src, resized_dims);
+          		ret = algo->c.Ctype.compress_int16(stage_ctx, (int64_t*)dst, &out_size, src, resized_dims);
           		break;
           	case(SCIL_TYPE_INT32) :
-          		ret = algo->c.Ctype.compress_int32(ctx, (int64_t*)dst, &out_size, src, resized_dims);
+          		ret = algo->c.Ctype.compress_int32(stage_ctx, (int64_t*)dst, &out_size, src, resized_dims);
           		break;
           	case(SCIL_TYPE_INT64) :
-          		ret = algo->c.Ctype.compress_int64(ctx, (int64_t*)dst, &out_size, src, resized_dims);
+          		ret = algo->c.Ctype.compress_int64(stage_ctx, (int64_t*)dst, &out_size, src, resized_dims);
           		break;
             case(SCIL_TYPE_UNKNOWN) :
             case(SCIL_TYPE_BINARY) :
@@ -319,7 +404,20 @@ int scil_compress(byte* restrict dest,
             scilU_print_buffer(dst, out_size);
         }
 
+        // a data compressor or a compressor of 64-bit words expects int64 values
+        if (chain->data_compressor == NULL && (chain->byte_compressor == NULL || ! chain->byte_compressor->int64_words)) {
+            const size_t count = scil_dims_get_count(resized_dims);
+            value_width = get_value_width((uint64_t*)dst, count);
+            if (value_width < 8) {
+                narrow_values(dst, count, value_width);
+                memmove((byte*)dst + count * value_width, (byte*)dst + count * sizeof(int64_t), out_size - count * sizeof(int64_t));
+                out_size -= count * (sizeof(int64_t) - value_width);
+            }
+        }
+
         remaining_compressors--;
+        ((char*)dst)[out_size] = (char)value_width;
+        out_size++;
         ((char*)dst)[out_size] = algo->compressor_id;
         debugI("C compressor ID %d at pos %llu\n", algo->compressor_id, (long long unsigned)&((char*)dst)[out_size]);
 
@@ -329,31 +427,34 @@ int scil_compress(byte* restrict dest,
 
 	// apply the second pre-conditioners
     if (chain->precond_second_count > 0) {
-        out_size += datatypes_size;
-        // add the header at the end of the preconditioners
-        byte* header = datatypes_size + (byte*)pick_buffer(0, total_compressors, 1 + total_compressors - chain->precond_second_count, source, dest, buff_tmp, dest);
+        // the converter stores the values first, they are followed by its header, the headers
+        // of the first preconditioners and the compressor IDs, which are preserved by every stage
+        const size_t values_size = scil_dims_get_count(resized_dims) * value_width;
 
         for (int i = 0; i < chain->precond_second_count; i++) {
             int header_size_out;
             scilU_algorithm_t* algo = chain->pre_cond_second[i];
             void* src = pick_buffer(1, total_compressors, remaining_compressors, source, dest, buff_tmp, dest);
             void* dst = pick_buffer(0, total_compressors, remaining_compressors, source, dest, buff_tmp, dest);
+            byte* header = (byte*)dst + input_size;
 
-			      ret = algo->c.PStype.compress(ctx, (int64_t*)dst, header, &header_size_out, src, resized_dims);
+            ret = precond_second_compress(algo, stage_ctx, value_width, dst, header, &header_size_out, src, resized_dims);
 
             if (ret != 0) return ret;
+            memcpy((byte*)dst + values_size, (byte*)src + values_size, input_size - values_size);
             remaining_compressors--;
-            out_size += header_size_out;
-            header   += header_size_out;
+            out_size = input_size + header_size_out + 1;
+            header  += header_size_out;
+            *header = (byte)value_width;
+            header++;
 
             *header = algo->compressor_id;
             debugI("C compressor ID %d at pos %llu\n", *header, (long long unsigned)header)
-            header++;
             out_size++;
+            input_size = out_size;
 
             // scilU_print_buffer(dst, out_size);
         }
-        input_size = out_size;
     }
 
 	// Apply the data compressor
@@ -368,22 +469,22 @@ int scil_compress(byte* restrict dest,
         scilU_algorithm_t* algo = chain->data_compressor;
         switch (ctx->datatype) {
           case (SCIL_TYPE_FLOAT):
-                ret = algo->c.DNtype.compress_float(ctx, dst, &out_size, src, resized_dims);
+                ret = algo->c.DNtype.compress_float(stage_ctx, dst, &out_size, src, resized_dims);
                 break;
           case (SCIL_TYPE_DOUBLE):
-                ret = algo->c.DNtype.compress_double(ctx, dst, &out_size, src, resized_dims);
+                ret = algo->c.DNtype.compress_double(stage_ctx, dst, &out_size, src, resized_dims);
                 break;
     			case (SCIL_TYPE_INT8) :
-    				ret = algo->c.DNtype.compress_int8(ctx, dst, &out_size, src, resized_dims);
+    				ret = algo->c.DNtype.compress_int8(stage_ctx, dst, &out_size, src, resized_dims);
     				break;
     			case(SCIL_TYPE_INT16) :
-    				ret = algo->c.DNtype.compress_int16(ctx, dst, &out_size, src, resized_dims);
+    				ret = algo->c.DNtype.compress_int16(stage_ctx, dst, &out_size, src, resized_dims);
     				break;
     			case(SCIL_TYPE_INT32) :
-    				ret = algo->c.DNtype.compress_int32(ctx, dst, &out_size, src, resized_dims);
+    				ret = algo->c.DNtype.compress_int32(stage_ctx, dst, &out_size, src, resized_dims);
     				break;
     			case(SCIL_TYPE_INT64) :
-    				ret = algo->c.DNtype.compress_int64(ctx, dst, &out_size, src, resized_dims);
+    				ret = algo->c.DNtype.compress_int64(stage_ctx, dst, &out_size, src, resized_dims);
     				break;
           case(SCIL_TYPE_UNKNOWN) :
           case(SCIL_TYPE_BINARY) :
@@ -416,7 +517,7 @@ int scil_compress(byte* restrict dest,
 
         // scilU_print_buffer(src, input_size);
 
-        ret = chain->byte_compressor->c.Btype.compress(ctx, dest, &out_size, (byte*)src, input_size);
+        ret = chain->byte_compressor->c.Btype.compress(stage_ctx, dest, &out_size, (byte*)src, input_size);
         if (ret != 0) return ret;
         dest[out_size] = chain->byte_compressor->compressor_id;
         debugI("C compressor ID %d at pos %llu\n",
@@ -431,12 +532,40 @@ int scil_compress(byte* restrict dest,
     return SCIL_NO_ERR;
 }
 
-int scil_decompress(SCIL_Datatype_t datatype,
-                    void* restrict dest,
-                    scil_dims_t* dims,
-                    byte* restrict source,
-                    const size_t source_size,
-                    byte* restrict buff_tmp1) {
+int scil_compress(byte* restrict dest,
+                  size_t in_dest_size,
+                  void* restrict source,
+                  scil_dims_t* dims,
+                  size_t* restrict out_size_p,
+                  scil_context_t* ctx) {
+  // the statistics of an input are only cached while it is compressed, the caller may modify it afterwards
+  scil_invalidate_statistics(ctx);
+  ctx->statistics->enabled = 1;
+  const int ret = compress_chain(dest, in_dest_size, source, dims, out_size_p, ctx);
+  ctx->statistics->enabled = 0;
+  scil_invalidate_statistics(ctx);
+  return ret;
+}
+
+// streams without SCIL_CHAIN_FORMAT_FLAG are decoded by the legacy variant of an algorithm if it has one
+static scilU_algorithm_t* get_decompressor(int compressor_id, int legacy_format) {
+    scilU_algorithm_t* algo = scil_get_compressor(compressor_id);
+    if (legacy_format && algo->legacy != NULL) {
+        return algo->legacy;
+    }
+    return algo;
+}
+
+// scratch receives a buffer the caller frees once all stages are decoded
+static int decompress_stages(SCIL_Datatype_t datatype,
+                             void* restrict dest,
+                             scil_dims_t* dims,
+                             byte* restrict source,
+                             const size_t source_size,
+                             byte* restrict buff_tmp1,
+                             int significant_bits,
+                             int reduction,
+                             byte** scratch) {
 
     if (dims->dims == 0) {
         return SCIL_NO_ERR;
@@ -466,7 +595,8 @@ int scil_decompress(SCIL_Datatype_t datatype,
     }
 
     // Read compressor ID (algorithm id) from header
-    const int total_compressors = (uint8_t)source[0];
+    const int legacy_format     = ! (source[0] & SCIL_CHAIN_FORMAT_FLAG);
+    const int total_compressors = source[0] & SCIL_CHAIN_LENGTH_MASK;
     int remaining_compressors   = total_compressors;
 
     byte* restrict src_adj = source + 1;
@@ -484,8 +614,9 @@ int scil_decompress(SCIL_Datatype_t datatype,
     CHECK_COMPRESSOR_ID(compressor_id)
     // printf("xx %d %lld\n", compressor_id, source_size);
 
-    scilU_algorithm_t* algo = scil_get_compressor(compressor_id);
+    scilU_algorithm_t* algo = get_decompressor(compressor_id, legacy_format);
     byte* header                     = &src_adj[src_size - 1];
+    int value_width                  = sizeof(int64_t);
 
     if (algo->type == SCIL_COMPRESSOR_TYPE_INDIVIDUAL_BYTES) {
         void* src = pick_buffer(1, total_compressors, remaining_compressors, src_adj, dest, buff_tmp1, buff_tmp2);
@@ -509,7 +640,15 @@ int scil_decompress(SCIL_Datatype_t datatype,
                    compressor_id,
                    (long long unsigned)header);
             CHECK_COMPRESSOR_ID(compressor_id)
-            algo = scil_get_compressor(compressor_id);
+            algo = get_decompressor(compressor_id, legacy_format);
+        }
+    }
+
+    if (reduction > 0) {
+        const int has_preview = datatype == SCIL_TYPE_FLOAT ? algo->preview.decompress_float != NULL :
+                                datatype == SCIL_TYPE_DOUBLE ? algo->preview.decompress_double != NULL : 0;
+        if (algo->type != SCIL_COMPRESSOR_TYPE_DATATYPES || remaining_compressors != 1 || ! has_preview) {
+            return SCIL_EINVAL;
         }
     }
 
@@ -519,9 +658,25 @@ int scil_decompress(SCIL_Datatype_t datatype,
 
         switch (datatype) {
             case (SCIL_TYPE_FLOAT):
+                if (reduction > 0) {
+                    ret = algo->preview.decompress_float(dst, resized_dims, src, src_size, reduction);
+                    break;
+                }
+                if (significant_bits > 0 && algo->precision.decompress_float != NULL) {
+                    ret = algo->precision.decompress_float(dst, resized_dims, src, src_size, significant_bits);
+                    break;
+                }
                 ret = algo->c.DNtype.decompress_float(dst, resized_dims, src, src_size);
                 break;
             case (SCIL_TYPE_DOUBLE):
+                if (reduction > 0) {
+                    ret = algo->preview.decompress_double(dst, resized_dims, src, src_size, reduction);
+                    break;
+                }
+                if (significant_bits > 0 && algo->precision.decompress_double != NULL) {
+                    ret = algo->precision.decompress_double(dst, resized_dims, src, src_size, significant_bits);
+                    break;
+                }
                 ret = algo->c.DNtype.decompress_double(dst, resized_dims, src, src_size);
                 break;
 			case (SCIL_TYPE_INT8) :
@@ -550,7 +705,7 @@ int scil_decompress(SCIL_Datatype_t datatype,
             compressor_id = *((char*)header);
             header--;
             CHECK_COMPRESSOR_ID(compressor_id)
-            algo = scil_get_compressor(compressor_id);
+            algo = get_decompressor(compressor_id, legacy_format);
         }
     }
 
@@ -560,25 +715,55 @@ int scil_decompress(SCIL_Datatype_t datatype,
         void* dst = pick_buffer(0, total_compressors, remaining_compressors, src_adj, dest, buff_tmp1, buff_tmp2);
         int header_parsed;
 
-        ret = algo->c.PStype.decompress(dst, resized_dims, src, header, &header_parsed);
+        if (! legacy_format) {
+            value_width = *header;
+            header--;
+        }
+        ret = precond_second_decompress(algo, value_width, dst, resized_dims, src, header, &header_parsed);
 
         header -= header_parsed;
 
         if (ret != 0) return ret;
         remaining_compressors--;
 
+        // move the headers behind the values along, the source buffer is reused by the next stage
+        const size_t values_size = scil_dims_get_count(resized_dims) * value_width;
+        memcpy((byte*)dst + values_size, (byte*)src + values_size, header + 1 - ((byte*)src + values_size));
+        header = (byte*)dst + (header - (byte*)src);
+
         // scilU_print_buffer(dst, src_size);
         compressor_id = *((char*)header);
         debugI("D compressor ID %d at pos %llu\n", compressor_id, (long long unsigned)header);
         header--;
         CHECK_COMPRESSOR_ID(compressor_id)
-        algo = scil_get_compressor(compressor_id);
+        algo = get_decompressor(compressor_id, legacy_format);
     }
 
 	if (algo->type == SCIL_COMPRESSOR_TYPE_DATATYPES_CONVERTER) {
         void* src = pick_buffer(1, total_compressors, remaining_compressors, src_adj, dest, buff_tmp1, buff_tmp2);
         void* dst = pick_buffer(0, total_compressors, remaining_compressors, src_adj, dest, buff_tmp1, buff_tmp2);
 
+        // the converter expects int64 values followed by its header
+        if (! legacy_format) {
+            value_width = *header;
+            header--;
+        }
+        if (value_width != 1 && value_width != 2 && value_width != 4 && value_width != 8) {
+            return SCIL_BUFFER_ERR;
+        }
+        if (value_width < 8) {
+            // the source may be the caller's buffer, which has no room for the wide values,
+            // the headers behind the values move along, the following stages read them from the scratch buffer
+            const size_t count = scil_dims_get_count(resized_dims);
+            byte* headers = (byte*)src + count * value_width;
+            const size_t headers_size = header + 1 - headers;
+            *scratch = scilU_safe_malloc(count * sizeof(int64_t) + headers_size);
+            widen_values(*scratch, src, count, value_width);
+            memcpy(*scratch + count * sizeof(int64_t), headers, headers_size);
+            header = *scratch + count * sizeof(int64_t) + headers_size - 1;
+            src = *scratch;
+        }
+
         switch (datatype) {
           case (SCIL_TYPE_FLOAT):
             ret = algo->c.Ctype.decompress_float(dst, resized_dims, src, src_size);
@@ -612,7 +797,7 @@ int scil_decompress(SCIL_Datatype_t datatype,
             compressor_id = *((char*)header);
             header--;
             CHECK_COMPRESSOR_ID(compressor_id)
-            algo = scil_get_compressor(compressor_id);
+            algo = get_decompressor(compressor_id, legacy_format);
         }
     }
 
@@ -664,7 +849,7 @@ int scil_decompress(SCIL_Datatype_t datatype,
                    (long long unsigned)header);
             header--;
             CHECK_COMPRESSOR_ID(compressor_id)
-            algo = scil_get_compressor(compressor_id);
+            algo = get_decompressor(compressor_id, legacy_format);
         }
     }
     // TODO check if the header is completely devoured.
@@ -672,6 +857,58 @@ int scil_decompress(SCIL_Datatype_t datatype,
     return SCIL_NO_ERR;
 }
 
+// significant_bits > 0 limits the precision read by data compressors that support it,
+// reduction > 0 decodes a preview by the data compressor, which must be the last stage of the chain
+static int decompress_chain(SCIL_Datatype_t datatype,
+                            void* restrict dest,
+                            scil_dims_t* dims,
+                            byte* restrict source,
+                            const size_t source_size,
+                            byte* restrict buff_tmp1,
+                            int significant_bits,
+                            int reduction) {
+    byte* scratch = NULL;
+    int ret = decompress_stages(datatype, dest, dims, source, source_size, buff_tmp1, significant_bits, reduction, & scratch);
+    free(scratch);
+    return ret;
+}
+
+int scil_decompress(SCIL_Datatype_t datatype,
+                    void* restrict dest,
+                    scil_dims_t* dims,
+                    byte* restrict source,
+                    const size_t source_size,
+                    byte* restrict buff_tmp1) {
+    return decompress_chain(datatype, dest, dims, source, source_size, buff_tmp1, 0, 0);
+}
+
+int scil_decompress_precision(SCIL_Datatype_t datatype,
+                              void* restrict dest,
+                              scil_dims_t* dims,
+                              byte* restrict source,
+                              const size_t source_size,
+                              byte* restrict buff_tmp1,
+                              int significant_bits) {
+    if (significant_bits <= 0) {
+        return SCIL_EINVAL;
+    }
+    return decompress_chain(datatype, dest, dims, source, source_size, buff_tmp1, significant_bits, 0);
+}
+
+int scil_decompress_preview(SCIL_Datatype_t datatype,
+                            void* restrict dest,
+                            scil_dims_t* dims,
+                            byte* restrict source,
+                            const size_t source_size,
+                            byte* restrict buff_tmp1,
+                            int reduction) {
+    // the preview of more than 4 dimensions would differ from the folded dimensions of the chain
+    if (reduction < 0 || (reduction > 0 && dims->dims > 4)) {
+        return SCIL_EINVAL;
+    }
+    return decompress_chain(datatype, dest, dims, source, source_size, buff_tmp1, 0, reduction);
+}
+
 void scil_determine_accuracy(SCIL_Datatype_t datatype,
                              const void* restrict data_1,
                              const void* restrict data_2,
@@ -29,6 +29,7 @@ package "public interface" {
         subtract_data_<T>()
         find_minimum_maximum_<T>()
         find_minimum_maximum_with_excluded_points_<T>()
+        compute_statistics_<T>()
         determine_accuracy()
         validate_compresssion()
     }
@@ -362,7 +363,7 @@ void scil_compression_sprint_last_algorithm_chain(scil_context_t* ctx,
  * \param source Source buffer of the data to compress
  * \param dims struct containing information about dimension count and length of
  * buffer in each dimension
- * \param ctx Reference to the compression context
+ * \param ctx Reference to the compression context, it must not be used by other threads during the call
  * \pre datatype == 0 || datatype == 1
  * \pre dest != NULL
  * \pre dest_size != NULL
@@ -397,6 +398,40 @@ int scil_decompress(SCIL_Datatype_t datatype,
                     const size_t source_size,
                     byte* restrict tmp_buff);
 
+/**
+ * \brief Method to decompress a data buffer with at most the given significant bits
+ * Data compressed by sigbits-progressive is decoded from the bit planes needed for this precision only,
+ * its relative error is at most 2^-significant_bits plus the error of the precision it was compressed with.
+ * Other compression chains decompress all data, hence with their full precision.
+ * The complete compressed buffer must be given, the chain is stored behind the data,
+ * only the planes of the lower bits are skipped while decoding.
+ * \param significant_bits The significant bits needed including the implicit bit, > 0
+ * \return Success state of the decompression
+ */
+int scil_decompress_precision(SCIL_Datatype_t datatype,
+                              void* restrict dest,
+                              scil_dims_t* expected_dims,
+                              byte* restrict source,
+                              const size_t source_size,
+                              byte* restrict tmp_buff,
+                              int significant_bits);
+
+/**
+ * \brief Method to decompress a preview of a data buffer with a reduced resolution
+ * The data compressor of the chain, e.g., multires, decodes the coarse levels needed for this resolution only,
+ * it may be followed by byte compressors but not by preconditioners.
+ * \param expected_dims The dimensions of the full data, up to 4 for a reduction > 0
+ * \param reduction dest receives every 2^reduction-th point in each dimension, i.e., (length - 1) / 2^reduction + 1 points
+ * \return Success state of the decompression, SCIL_EINVAL if the chain cannot decode a preview
+ */
+int scil_decompress_preview(SCIL_Datatype_t datatype,
+                            void* restrict dest,
+                            scil_dims_t* expected_dims,
+                            byte* restrict source,
+                            const size_t source_size,
+                            byte* restrict tmp_buff,
+                            int reduction);
+
 void scil_determine_accuracy(SCIL_Datatype_t datatype,
                              const void* restrict data_1,
                              const void* restrict data_2,
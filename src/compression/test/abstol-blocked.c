@@ -0,0 +1,104 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// Blocked abstol must respect the tolerance, need fewer bits than abstol for a trend and not depend on the thread count.
+// Fill values must be restored exactly.
+#include "test-util.h"
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// not a multiple of the block size
+#define COUNT 300001
+#define FILL 9.96921e36
+
+static size_t test(const char * name, enum SCIL_Datatype type, int threads, double fill, void * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+  hints.absolute_tolerance = 0.001;
+  hints.thread_count = threads;
+  hints.fill_value = fill;
+
+  byte * check = malloc(scil_dims_get_size(dims, type));
+  size_t out_size = test_compress_decompress(& hints, type, 0, NULL, data, dims, buff, buff_size, tmp, check);
+  if(type == SCIL_TYPE_DOUBLE){
+    test_check_tolerance(type, data, check, COUNT, 0.001, fill);
+  }else{
+    for(int i=0; i < COUNT; i++){
+      // the reconstruction is rounded to float
+      const double value = (double) ((float*) data)[i];
+      assert(fabs((double) ((float*) check)[i] - value) <= 0.001 + fabs(value) * (double) FLT_EPSILON);
+    }
+  }
+  free(check);
+  printf("%s %d threads size: %lld\n", name, threads, (long long) out_size);
+  return out_size;
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * first = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  float * data_f = malloc(COUNT * sizeof(float));
+
+  // a large trend with small local variations, the last values are constant
+  for(int i=0; i < COUNT; i++){
+    data[i] = 100 * sin(i * 6.283 / COUNT) + 0.05 * sin(i * 0.3);
+    if(i > COUNT - 5000){
+      data[i] = 3.0;
+    }
+    data_f[i] = (float) data[i];
+  }
+
+  size_t global = test("abstol", SCIL_TYPE_DOUBLE, 1, DBL_MAX, data, & dims, buff, buff_size, tmp);
+  size_t blocked = test("abstol-blocked", SCIL_TYPE_DOUBLE, 1, DBL_MAX, data, & dims, buff, buff_size, tmp);
+  assert(blocked < global * 3 / 4);
+  memcpy(first, buff, blocked);
+
+  size_t parallel = test("abstol-blocked", SCIL_TYPE_DOUBLE, 4, DBL_MAX, data, & dims, buff, buff_size, tmp);
+  assert(parallel == blocked && memcmp(first, buff, blocked) == 0);
+
+  blocked = test("abstol-blocked", SCIL_TYPE_FLOAT, 4, DBL_MAX, data_f, & dims, buff, buff_size, tmp);
+  assert(blocked < global * 3 / 4);
+
+  // scattered fill values and a block of fill values
+  for(int i=0; i < COUNT; i += 101){
+    data[i] = FILL;
+  }
+  for(int i=8192; i < 3 * 4096; i++){
+    data[i] = FILL;
+  }
+  size_t serial = test("abstol-blocked", SCIL_TYPE_DOUBLE, 1, FILL, data, & dims, buff, buff_size, tmp);
+  parallel = test("abstol-blocked", SCIL_TYPE_DOUBLE, 4, FILL, data, & dims, buff, buff_size, tmp);
+  assert(serial == parallel);
+
+  free(data);
+  free(data_f);
+  free(first);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
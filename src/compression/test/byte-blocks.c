@@ -0,0 +1,105 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// Multi-threaded byte compressors must produce data that decompresses to the input,
+// the blocked layout spans several blocks for this size.
+#include "test-util.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#define COUNT (700*1000 + 13)
+#define LEGACY_COUNT 1000
+
+static size_t test(const char * name, int threads, double * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp, double * check){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.absolute_tolerance = SCIL_ACCURACY_DBL_FINEST;
+  hints.force_compression_methods = (char*) name;
+  hints.thread_count = threads;
+
+  size_t out_size = test_compress_decompress(& hints, SCIL_TYPE_DOUBLE, 0, NULL, data, dims, buff, buff_size, tmp, check);
+  assert(memcmp(check, data, COUNT * sizeof(double)) == 0);
+  printf("%s threads: %d size: %lld\n", name, threads, (long long) out_size);
+  return out_size;
+}
+
+// rewrites a single block stream to the single stream format written before the blocks,
+// prefix is the byte size of the uncompressed size stored in front of the stream
+static void test_legacy(const char * name, size_t prefix, double * data, byte * buff, size_t buff_size, byte * tmp, double * check){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.absolute_tolerance = SCIL_ACCURACY_DBL_FINEST;
+  hints.force_compression_methods = (char*) name;
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, LEGACY_COUNT);
+
+  size_t out_size = test_compress_decompress(& hints, SCIL_TYPE_DOUBLE, 0, NULL, data, & dims, buff, buff_size, tmp, check);
+  // the chain length, the block header of 9 bytes and the ID surround the block
+  const size_t block_size = out_size - 11;
+  const byte id = buff[out_size - 1];
+  int32_t size = LEGACY_COUNT * sizeof(double);
+  buff[0] = 1;
+  memcpy(buff + 1, & size, prefix);
+  memmove(buff + 1 + prefix, buff + 10, block_size);
+  buff[1 + prefix + block_size] = id;
+
+  memset(check, 0, LEGACY_COUNT * sizeof(double));
+  int ret = scil_decompress(SCIL_TYPE_DOUBLE, check, & dims, buff, block_size + prefix + 2, tmp);
+  assert(ret == SCIL_NO_ERR);
+  assert(memcmp(check, data, LEGACY_COUNT * sizeof(double)) == 0);
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  size_t buff_size = scil_get_compressed_data_size_limit(&dims, SCIL_TYPE_DOUBLE);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+
+  for(int i=0; i < COUNT; i++){
+    data[i] = (i % 1000) * 0.5 + (i / 1000);
+  }
+
+  const char * algos[] = {"lz4", "lz4hc", "lz4hc-12", "gzip", "zstd", NULL};
+  size_t lz4_size = 0;
+  for(int a=0; algos[a] != NULL; a++){
+    size_t serial = test(algos[a], 1, data, & dims, buff, buff_size, tmp, check);
+    if(a == 0){
+      lz4_size = serial;
+    }else if(strncmp(algos[a], "lz4hc", 5) == 0){
+      assert(serial < lz4_size);
+    }
+    size_t parallel = test(algos[a], 4, data, & dims, buff, buff_size, tmp, check);
+    if(strcmp(algos[a], "zstd") != 0){
+      // the blocks are independent of the number of threads
+      assert(serial == parallel);
+    }
+  }
+
+  // the single stream formats used before the blocks remain readable, streams without the chain format flag use them
+  test_legacy("lz4", 4, data, buff, buff_size, tmp, check);
+  test_legacy("gzip", 0, data, buff, buff_size, tmp, check);
+
+  free(data);
+  free(check);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
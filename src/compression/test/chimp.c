@@ -0,0 +1,95 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The XOR compressor must restore every bit of a time series, including special values, and shrink smooth series.
+#include "test-util.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COUNT 100000
+
+static size_t test(enum SCIL_Datatype type, void * data, size_t count, byte * buff, size_t buff_size, byte * tmp, void * check){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, count);
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = "chimp";
+
+  size_t out_size = test_compress_decompress(& hints, type, 0, NULL, data, & dims, buff, buff_size, tmp, check);
+  assert(memcmp(check, data, scil_dims_get_size(& dims, type)) == 0);
+  printf("%s %lld values size: %lld\n", type == SCIL_TYPE_DOUBLE ? "double" : "float", (long long) count, (long long) out_size);
+  return out_size;
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+  float * data_f = malloc(COUNT * sizeof(float));
+  float * check_f = malloc(COUNT * sizeof(float));
+
+  // hourly temperatures of a station with a resolution of 0.1 degrees, decimals fill the mantissa
+  for(int i=0; i < COUNT; i++){
+    data[i] = round(10 * (12 + 8 * sin(i * 6.283 / 24) + 5 * sin(i * 6.283 / 8760))) / 10;
+  }
+  size_t size = test(SCIL_TYPE_DOUBLE, data, COUNT, buff, buff_size, tmp, check);
+  assert(size < COUNT * sizeof(double) * 3 / 4);
+
+  // a sensor with a resolution of 1/16 degrees that often repeats its value
+  for(int i=0; i < COUNT; i++){
+    data[i] = round(16 * (12 + 8 * sin((i / 4) * 6.283 / 24) + 5 * sin(i * 6.283 / 8760))) / 16;
+    data_f[i] = (float) data[i];
+  }
+  data[10] = NAN;
+  data[11] = INFINITY;
+  data[12] = -0.0;
+  data_f[10] = NAN;
+  data_f[13] = -INFINITY;
+
+  size = test(SCIL_TYPE_DOUBLE, data, COUNT, buff, buff_size, tmp, check);
+  assert(size < COUNT * sizeof(double) / 4);
+  size = test(SCIL_TYPE_FLOAT, data_f, COUNT, buff, buff_size, tmp, check_f);
+  assert(size < COUNT * sizeof(float) / 2);
+
+  // short series
+  for(size_t count=1; count < 20; count++){
+    test(SCIL_TYPE_DOUBLE, data, count, buff, buff_size, tmp, check);
+    test(SCIL_TYPE_FLOAT, data_f, count, buff, buff_size, tmp, check_f);
+  }
+
+  // noise is stored
+  for(int i=0; i < COUNT; i++){
+    data[i] = (double) rand() / RAND_MAX;
+  }
+  size = test(SCIL_TYPE_DOUBLE, data, COUNT, buff, buff_size, tmp, check);
+  assert(size <= COUNT * sizeof(double) + 1);
+
+  free(data);
+  free(check);
+  free(data_f);
+  free(check_f);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
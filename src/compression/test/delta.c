@@ -0,0 +1,124 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The vectorized and blocked prefix sums must match the serial scan for all widths,
+// the delta preconditioner relies on them for decompression. The delta preconditioners
+// must be lossless for all datatypes including special floating point values.
+#include <scil.h>
+#include <scil-error.h>
+#include <scil-util.h>
+#include <scil-prefix-sum.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#define COUNT (1000*1000 + 7)
+
+#define CHECK_SCAN(bits) \
+  { \
+    uint##bits##_t* in = (uint##bits##_t*) data; \
+    uint##bits##_t* out = (uint##bits##_t*) result; \
+    scil_prefix_sum_int##bits##_t(out, in, count, threads); \
+    uint##bits##_t sum = 0; \
+    for(size_t i=0; i < count; i++){ \
+      sum += in[i]; \
+      assert(out[i] == sum); \
+    } \
+    memcpy(out, in, count * sizeof(sum)); \
+    scil_prefix_sum_int##bits##_t(out, out, count, threads); \
+    sum = 0; \
+    for(size_t i=0; i < count; i++){ \
+      sum += in[i]; \
+      assert(out[i] == sum); \
+    } \
+  }
+
+static void test_scan(byte * data, byte * result, size_t count, int threads){
+  CHECK_SCAN(8)
+  CHECK_SCAN(16)
+  CHECK_SCAN(32)
+  CHECK_SCAN(64)
+}
+
+static size_t test_chain(const char * name, enum SCIL_Datatype type, int threads, void * data, byte * buff, size_t buff_size, byte * tmp, void * check){
+  scil_user_hints_t hints;
+  scil_context_t* ctx;
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+  hints.thread_count = threads;
+
+  int ret = scil_context_create(&ctx, type, 0, NULL, &hints);
+  assert(ret == SCIL_NO_ERR);
+  size_t out_size;
+  ret = scil_compress(buff, buff_size, data, & dims, & out_size, ctx);
+  assert(ret == SCIL_NO_ERR);
+  scil_destroy_context(ctx);
+
+  const size_t size = COUNT * DATATYPE_LENGTH(type);
+  memset(check, 0, size);
+  ret = scil_decompress(type, check, & dims, buff, out_size, tmp);
+  assert(ret == SCIL_NO_ERR);
+  assert(memcmp(check, data, size) == 0);
+  printf("%s type: %d threads: %d size: %lld\n", name, type, threads, (long long) out_size);
+  return out_size;
+}
+
+int main(){
+  byte * data = malloc(COUNT * 8);
+  byte * result = malloc(COUNT * 8);
+
+  for(int i=0; i < COUNT * 8; i++){
+    data[i] = (byte) (i * 13 + i / 7);
+  }
+  const size_t counts[] = {0, 1, 15, 16, 17, 33, 1000, COUNT};
+  for(int c=0; c < 8; c++){
+    test_scan(data, result, counts[c], 1);
+    test_scan(data, result, counts[c], 3);
+  }
+
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  size_t buff_size = scil_get_compressed_data_size_limit(&dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  for(int t=SCIL_TYPE_FLOAT; t <= SCIL_TYPE_INT64; t++){
+    test_chain("delta,lz4", (enum SCIL_Datatype) t, 1, data, buff, buff_size, tmp, result);
+    size_t serial = test_chain("fpdelta,lz4", (enum SCIL_Datatype) t, 1, data, buff, buff_size, tmp, result);
+    size_t parallel = test_chain("fpdelta,lz4", (enum SCIL_Datatype) t, 4, data, buff, buff_size, tmp, result);
+    assert(serial == parallel);
+  }
+
+  // smooth data with a trend, the minima are small differences
+  double * dbl = (double*) data;
+  for(int i=0; i < COUNT; i++){
+    dbl[i] = i * 0.25 + (i % 100) * 0.001;
+  }
+  dbl[5] = -0.0;
+  dbl[6] = 1.0 / 0.0;
+  dbl[7] = -1.0 / 0.0;
+  size_t plain = test_chain("lz4", SCIL_TYPE_DOUBLE, 1, data, buff, buff_size, tmp, result);
+  size_t blocks = test_chain("fpdelta,lz4", SCIL_TYPE_DOUBLE, 1, data, buff, buff_size, tmp, result);
+  assert(blocks < plain);
+
+  free(data);
+  free(result);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
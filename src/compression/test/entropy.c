@@ -0,0 +1,173 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The entropy coders must restore any byte stream and compress the integers of quantize.
+#include "test-util.h"
+#include <algo/algo-huffman.h>
+#include <algo/algo-rans.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define X 300
+#define Y 200
+#define COUNT (X * Y)
+
+typedef int (*byte_compress_t)(const scil_context_t* ctx, byte* restrict dest, size_t * restrict out_size, const byte*restrict source, const size_t source_size);
+typedef int (*byte_decompress_t)(byte*restrict dest, size_t buff_size, const byte*restrict src, const size_t in_size, size_t * uncomp_size_out);
+
+static size_t test_bytes(byte_compress_t compress, byte_decompress_t decompress, const byte * data, size_t size, byte * buff, byte * check){
+  size_t out_size;
+  int ret = compress(NULL, buff, & out_size, data, size);
+  assert(ret == SCIL_NO_ERR);
+  size_t uncomp_size;
+  memset(check, 0, size);
+  ret = decompress(check, size, buff, out_size, & uncomp_size);
+  assert(ret == SCIL_NO_ERR);
+  assert(uncomp_size == size);
+  assert(memcmp(check, data, size) == 0);
+  return out_size;
+}
+
+static size_t test(const char * name, int threads, double * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp, double * check){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+  hints.thread_count = threads;
+  hints.absolute_tolerance = 0.01;
+
+  size_t out_size = test_compress_decompress(& hints, SCIL_TYPE_DOUBLE, 0, NULL, data, dims, buff, buff_size, tmp, check);
+  test_check_tolerance(SCIL_TYPE_DOUBLE, data, check, COUNT, 0.01, DBL_MAX);
+  printf("%s threads: %d size: %lld\n", name, threads, (long long) out_size);
+  return out_size;
+}
+
+static int compare_int64(const void * a, const void * b){
+  const int64_t x = *(const int64_t*) a;
+  const int64_t y = *(const int64_t*) b;
+  return (x > y) - (x < y);
+}
+
+// the order-0 entropy of the values in bytes
+static double entropy_size(const int64_t * values, size_t count){
+  int64_t * sorted = malloc(count * sizeof(int64_t));
+  memcpy(sorted, values, count * sizeof(int64_t));
+  qsort(sorted, count, sizeof(int64_t), compare_int64);
+  double bits = 0;
+  size_t run = 1;
+  for(size_t i=1; i <= count; i++){
+    if(i < count && sorted[i] == sorted[i - 1]){
+      run++;
+      continue;
+    }
+    bits -= run * log2(run / (double) count);
+    run = 1;
+  }
+  free(sorted);
+  return bits / 8;
+}
+
+static void test_coder(byte_compress_t compress, byte_decompress_t decompress){
+  const size_t size = COUNT * sizeof(int64_t) + 5;
+  byte * data = malloc(size);
+  byte * buff = malloc(2 * size + 100);
+  byte * check = malloc(size);
+  int64_t * values = (int64_t*) data;
+
+  // small inputs and a remainder after the last word
+  for(size_t s=0; s < 20; s++){
+    for(size_t i=0; i < s; i++){
+      data[i] = (byte) (i * 7);
+    }
+    test_bytes(compress, decompress, data, s, buff, check);
+  }
+
+  // a single symbol
+  memset(data, 0, size);
+  size_t out_size = test_bytes(compress, decompress, data, size, buff, check);
+  assert(out_size < size / 60);
+
+  // a geometric distribution needs codes longer than the limit, extreme values use the raw bits
+  uint64_t seed = 42;
+  for(int i=0; i < COUNT; i++){
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    values[i] = (seed >> 40) == 0 ? 1 : __builtin_ctzll(seed >> 40);
+    if(i % 2){
+      values[i] = -values[i];
+    }
+  }
+  values[10] = INT64_MIN;
+  values[11] = INT64_MAX;
+  values[12] = 1LL << 40;
+  values[13] = 1023;
+  values[14] = -1024;
+  out_size = test_bytes(compress, decompress, data, size, buff, check);
+  assert(out_size < size / 16);
+  // the codes stay close to the order-0 entropy of the symbols
+  assert(out_size < entropy_size(values, COUNT) * 1.1 + 1024);
+
+  // random data is stored with a small overhead
+  for(size_t i=0; i < size; i++){
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    data[i] = (byte) (seed >> 56);
+  }
+  out_size = test_bytes(compress, decompress, data, size, buff, check);
+  assert(out_size <= size + 32);
+
+  free(data);
+  free(buff);
+  free(check);
+}
+
+int main(){
+  test_coder(scil_huffman_compress, scil_huffman_decompress);
+  test_coder(scil_rans_compress, scil_rans_decompress);
+
+  scil_dims_t dims;
+  scil_dims_initialize_2d(& dims, X, Y);
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+
+  for(int y=0; y < Y; y++){
+    for(int x=0; x < X; x++){
+      data[x + y * X] = 100.0 * sin(x * 0.05) * cos(y * 0.07) + x * y * 0.01;
+    }
+  }
+
+  const char * algos[] = {"quantize,huffman", "quantize,lorenzo-int,huffman", "quantize,rans", "quantize,lorenzo-int,rans", NULL};
+  for(int a=0; algos[a] != NULL; a++){
+    size_t serial = test(algos[a], 1, data, & dims, buff, buff_size, tmp, check);
+    size_t parallel = test(algos[a], 4, data, & dims, buff, buff_size, tmp, check);
+    assert(serial == parallel);
+    assert(serial < COUNT * sizeof(double) / 3);
+  }
+  size_t huffman = test("quantize,lorenzo-int,huffman", 1, data, & dims, buff, buff_size, tmp, check);
+  // the frequencies of ANS are finer than the code lengths
+  size_t rans = test("quantize,lorenzo-int,rans", 1, data, & dims, buff, buff_size, tmp, check);
+  assert(rans < huffman);
+
+  free(data);
+  free(check);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,148 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The fill preconditioner must restore fill and special values exactly and keep them
+// away from the following lossy stages, which then see smooth data.
+#include "test-util.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define X 300
+#define Y 200
+#define COUNT (X * Y)
+#define FILL 9.96921e36
+
+static size_t test(const char * name, enum SCIL_Datatype type, double abstol, int special_count, scil_value_t * special, void * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp, void * check){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+  if(type == SCIL_TYPE_DOUBLE){
+    hints.absolute_tolerance = abstol;
+    hints.fill_value = FILL;
+  }
+
+  size_t out_size = test_compress_decompress(& hints, type, special_count, special, data, dims, buff, buff_size, tmp, check);
+  if(type == SCIL_TYPE_DOUBLE){
+    test_check_tolerance(type, data, check, COUNT, abstol, FILL);
+  }else{
+    assert(memcmp(data, check, COUNT * sizeof(int32_t)) == 0);
+  }
+  printf("%s type: %d size: %lld\n", name, type, (long long) out_size);
+  return out_size;
+}
+
+// compression that must be rejected by the preconditioner
+static int compress_status(enum SCIL_Datatype type, double fill_value, int special_count, scil_value_t * special, void * data, scil_dims_t * dims, byte * buff, size_t buff_size){
+  scil_user_hints_t hints;
+  scil_context_t* ctx;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = "fill,lz4";
+  hints.fill_value = fill_value;
+
+  int ret = scil_context_create(&ctx, type, special_count, special, &hints);
+  assert(ret == SCIL_NO_ERR);
+  size_t out_size;
+  ret = scil_compress(buff, buff_size, data, dims, & out_size, ctx);
+  scil_destroy_context(ctx);
+  return ret;
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_2d(& dims, X, Y);
+
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+  int32_t * idata = malloc(COUNT * sizeof(int32_t));
+
+  // an ocean field with land along a coastline
+  for(int y=0; y < Y; y++){
+    for(int x=0; x < X; x++){
+      int i = x + X * y;
+      data[i] = 10.0 + 5.0 * sin(x * 0.03) * cos(y * 0.05);
+      if(x < 80 + 40 * sin(y * 0.1)){
+        data[i] = FILL;
+      }
+    }
+  }
+  test("fill,abstol", SCIL_TYPE_DOUBLE, 0.01, 0, NULL, data, & dims, buff, buff_size, tmp, check);
+  test("fill,quantize,rans", SCIL_TYPE_DOUBLE, 0.01, 0, NULL, data, & dims, buff, buff_size, tmp, check);
+  // the preconditioner spares the predictor the jumps at the coastline
+  size_t fill = test("fill,sz-native", SCIL_TYPE_DOUBLE, 0.01, 0, NULL, data, & dims, buff, buff_size, tmp, check);
+  size_t raw = test("sz-native", SCIL_TYPE_DOUBLE, 0.01, 0, NULL, data, & dims, buff, buff_size, tmp, check);
+  assert(fill < raw);
+
+  // scattered fill values are stored in a bitmap
+  for(int i=0; i < COUNT; i += 3){
+    data[i] = FILL;
+  }
+  test("fill,abstol", SCIL_TYPE_DOUBLE, 0.01, 0, NULL, data, & dims, buff, buff_size, tmp, check);
+
+  // multiple special values of the context, the first value is special, too
+  scil_value_t special[2];
+  special[0].u.uint32 = (uint32_t) -1;
+  special[0].typ = SCIL_TYPE_INT32;
+  special[1].u.uint32 = 7777;
+  special[1].typ = SCIL_TYPE_INT32;
+  for(int i=0; i < COUNT; i++){
+    idata[i] = i / 10;
+    if(i % 1000 < 30 || i % 7 == 0){
+      idata[i] = i % 2 ? -1 : 7777;
+    }
+  }
+  test("fill,lz4", SCIL_TYPE_INT32, 0, 2, special, idata, & dims, buff, buff_size, tmp, check);
+  for(int i=0; i < COUNT; i++){
+    idata[i] = (i % 5000) < 2500 ? 7777 : i;
+  }
+  test("fill,lz4", SCIL_TYPE_INT32, 0, 2, special, idata, & dims, buff, buff_size, tmp, check);
+  // without special values
+  test("fill,lz4", SCIL_TYPE_INT32, 0, 0, NULL, idata, & dims, buff, buff_size, tmp, check);
+
+  // fill values that the integers cannot represent
+  assert(compress_status(SCIL_TYPE_INT32, 2.5, 0, NULL, idata, & dims, buff, buff_size) == SCIL_FILL_VAL_ERR);
+  assert(compress_status(SCIL_TYPE_INT32, 3e9, 0, NULL, idata, & dims, buff, buff_size) == SCIL_FILL_VAL_ERR);
+  assert(compress_status(SCIL_TYPE_INT32, 7777, 0, NULL, idata, & dims, buff, buff_size) == SCIL_NO_ERR);
+
+  // alternating special values of bytes need more space than the data offers for the header,
+  // the data then passes the preconditioner unchanged
+  int8_t * bdata = (int8_t*) idata;
+  special[0].u.uint8 = 1;
+  special[0].typ = SCIL_TYPE_INT8;
+  special[1].u.uint8 = 2;
+  special[1].typ = SCIL_TYPE_INT8;
+  for(int i=0; i < COUNT; i++){
+    bdata[i] = (int8_t) (i % 2 ? 100 : 1 + (i / 2) % 2);
+  }
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = "fill,lz4";
+  test_compress_decompress(& hints, SCIL_TYPE_INT8, 2, special, bdata, & dims, buff, buff_size, tmp, check);
+  assert(memcmp(bdata, check, COUNT) == 0);
+  assert(compress_status(SCIL_TYPE_INT8, 300, 0, NULL, bdata, & dims, buff, buff_size) == SCIL_FILL_VAL_ERR);
+
+  free(data);
+  free(idata);
+  free(check);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
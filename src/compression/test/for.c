@@ -0,0 +1,105 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// Frame of reference coding must restore all integer types exactly and pack narrow blocks tighter than lz4.
+#include "test-util.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COUNT 100000
+
+static size_t test(char * method, enum SCIL_Datatype type, void * data, size_t count, byte * buff, size_t buff_size, byte * tmp, void * check){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, count);
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = method;
+
+  size_t out_size = test_compress_decompress(& hints, type, 0, NULL, data, & dims, buff, buff_size, tmp, check);
+  assert(memcmp(check, data, scil_dims_get_size(& dims, type)) == 0);
+  printf("%s type %d %lld values size: %lld\n", method, (int) type, (long long) count, (long long) out_size);
+  return out_size;
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_INT64);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  int64_t * data = malloc(COUNT * sizeof(int64_t));
+  int64_t * check = malloc(COUNT * sizeof(int64_t));
+  int32_t * data32 = malloc(COUNT * sizeof(int32_t));
+  int16_t * data16 = malloc(COUNT * sizeof(int16_t));
+  int8_t * data8 = malloc(COUNT * sizeof(int8_t));
+
+  // cell indices of an unstructured grid: large offsets, few bits within a block
+  for(int i=0; i < COUNT; i++){
+    data[i] = 5000000000ll + 3 * i + rand() % 200;
+    data32[i] = -1000000 + i / 2 + rand() % 1000;
+    data16[i] = (int16_t) (-20000 + rand() % 4000);
+    data8[i] = (int8_t) (-100 + rand() % 50);
+  }
+  size_t size = test("for", SCIL_TYPE_INT64, data, COUNT, buff, buff_size, tmp, check);
+  assert(size < COUNT * 2);
+  assert(size < test("lz4", SCIL_TYPE_INT64, data, COUNT, buff, buff_size, tmp, check));
+  size = test("for", SCIL_TYPE_INT32, data32, COUNT, buff, buff_size, tmp, check);
+  assert(size < COUNT * 2);
+  assert(size < test("lz4", SCIL_TYPE_INT32, data32, COUNT, buff, buff_size, tmp, check));
+  size = test("for", SCIL_TYPE_INT16, data16, COUNT, buff, buff_size, tmp, check);
+  assert(size < COUNT * 2);
+  assert(size < test("lz4", SCIL_TYPE_INT16, data16, COUNT, buff, buff_size, tmp, check));
+  size = test("for", SCIL_TYPE_INT8, data8, COUNT, buff, buff_size, tmp, check);
+  assert(size < COUNT);
+
+  // a land-sea mask is constant in most blocks
+  for(int i=0; i < COUNT; i++){
+    data32[i] = (i / 10000) % 2;
+  }
+  data32[12345] = 7;
+  size = test("for", SCIL_TYPE_INT32, data32, COUNT, buff, buff_size, tmp, check);
+  assert(size < COUNT / 10);
+
+  // extremes span the full width
+  for(int i=0; i < COUNT; i++){
+    data[i] = rand() % 2 ? INT64_MAX - rand() : INT64_MIN + rand();
+    data8[i] = (int8_t) rand();
+  }
+  size = test("for", SCIL_TYPE_INT64, data, COUNT, buff, buff_size, tmp, check);
+  // the block headers and the chain header are the only overhead
+  assert(size <= COUNT * sizeof(int64_t) + 9 * (COUNT / 4096 + 1) + 16);
+  test("for", SCIL_TYPE_INT8, data8, COUNT, buff, buff_size, tmp, check);
+
+  // short and partial blocks
+  for(size_t count=1; count < 20; count++){
+    test("for", SCIL_TYPE_INT64, data, count, buff, buff_size, tmp, check);
+    test("for", SCIL_TYPE_INT16, data16, count, buff, buff_size, tmp, check);
+  }
+  test("for", SCIL_TYPE_INT16, data16, 4097, buff, buff_size, tmp, check);
+
+  free(data);
+  free(check);
+  free(data32);
+  free(data16);
+  free(data8);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
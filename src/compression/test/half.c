@@ -0,0 +1,137 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The half and bfloat16 converters must round to nearest even, keep special values and reject data they cannot represent.
+#include <scil.h>
+#include <scil-error.h>
+#include <scil-util.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COUNT 100000
+
+static int equal(double a, double b){
+  return a <= b && a >= b && signbit(a) == signbit(b);
+}
+
+static int compress(char * method, int significant_bits, enum SCIL_Datatype type, void * data, size_t count, byte * buff, size_t buff_size, byte * tmp, void * check, size_t * out_size){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, count);
+  scil_user_hints_t hints;
+  scil_context_t* ctx;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = method;
+  hints.significant_bits = significant_bits;
+  // values below the smallest subnormal of half only keep their absolute error
+  hints.relative_err_finest_abs_tolerance = 0x1p-24;
+
+  int ret = scil_context_create(&ctx, type, 0, NULL, &hints);
+  assert(ret == SCIL_NO_ERR);
+  ret = scil_compress(buff, buff_size, data, & dims, out_size, ctx);
+  scil_destroy_context(ctx);
+  if(ret != SCIL_NO_ERR){
+    return ret;
+  }
+  ret = scil_decompress(type, check, & dims, buff, *out_size, tmp);
+  assert(ret == SCIL_NO_ERR);
+  printf("%s %lld values size: %lld\n", method, (long long) count, (long long) *out_size);
+  return ret;
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+  float * data_f = malloc(COUNT * sizeof(float));
+  float * check_f = malloc(COUNT * sizeof(float));
+  size_t size;
+
+  // ties round to even, subnormals and special values
+  const double values[] = {1.0, 1 + 0x1p-10, 1 + 0x1p-11, 1 + 3 * 0x1p-11, 65504, 65519, 0x1p-14, 0x1p-24, 0x1p-25, 3 * 0x1p-26, 0x1p-26, -2.5, -0.0, INFINITY, -INFINITY};
+  const double half[] =   {1.0, 1 + 0x1p-10, 1.0,         1 + 0x1p-9,      65504, 65504, 0x1p-14, 0x1p-24, 0.0,     0x1p-24,     0.0,     -2.5, -0.0, INFINITY, -INFINITY};
+  const int known = sizeof(values) / sizeof(double);
+  for(int i=0; i < known; i++){
+    data[i] = values[i];
+    data_f[i] = (float) values[i];
+  }
+  data[known] = NAN;
+  data_f[known] = NAN;
+  assert(compress("half", 1, SCIL_TYPE_DOUBLE, data, known + 1, buff, buff_size, tmp, check, & size) == SCIL_NO_ERR);
+  assert(compress("half", 1, SCIL_TYPE_FLOAT, data_f, known + 1, buff, buff_size, tmp, check_f, & size) == SCIL_NO_ERR);
+  for(int i=0; i < known; i++){
+    assert(equal(check[i], half[i]));
+    assert(equal(check_f[i], half[i]));
+  }
+  assert(isnan(check[known]) && isnan(check_f[known]));
+  // the 16 values above are converted by F16C if available, single values by the scalar code
+  for(int i=0; i <= known; i++){
+    float single;
+    assert(compress("half", 1, SCIL_TYPE_FLOAT, data_f + i, 1, buff, buff_size, tmp, & single, & size) == SCIL_NO_ERR);
+    assert(equal(single, check_f[i]) || (isnan(single) && isnan(check_f[i])));
+  }
+
+  // bfloat16 keeps the range of float
+  const double values_b[] = {1 + 0x1p-8, 1 + 3 * 0x1p-8, 0x1p100, 0x1p-133, 0x1p-134, -0.0, -INFINITY};
+  const double bfloat[] =   {1.0,        1 + 0x1p-6,     0x1p100, 0x1p-133, 0.0,      -0.0, -INFINITY};
+  const int known_b = sizeof(values_b) / sizeof(double);
+  assert(compress("bfloat16", 1, SCIL_TYPE_DOUBLE, (void*) values_b, known_b, buff, buff_size, tmp, check, & size) == SCIL_NO_ERR);
+  for(int i=0; i < known_b; i++){
+    assert(equal(check[i], bfloat[i]));
+  }
+
+  // smooth fields keep the significant bits requested and take two bytes per value
+  for(int i=0; i < COUNT; i++){
+    data[i] = 280 + 20 * sin(i / 1000.0) + (double) rand() / RAND_MAX;
+    data_f[i] = (float) data[i];
+  }
+  assert(compress("half", 11, SCIL_TYPE_DOUBLE, data, COUNT, buff, buff_size, tmp, check, & size) == SCIL_NO_ERR);
+  assert(size < COUNT * 2 + 16);
+  for(int i=0; i < COUNT; i++){
+    assert(fabs(check[i] - data[i]) <= fabs(data[i]) * 0x1p-11);
+  }
+  assert(compress("bfloat16", 8, SCIL_TYPE_FLOAT, data_f, COUNT, buff, buff_size, tmp, check_f, & size) == SCIL_NO_ERR);
+  assert(size < COUNT * 2 + 16);
+  for(int i=0; i < COUNT; i++){
+    assert(fabs(check_f[i] - data_f[i]) <= fabs(data_f[i]) * 0x1p-8);
+  }
+  assert(compress("half,zstd", 11, SCIL_TYPE_FLOAT, data_f, COUNT, buff, buff_size, tmp, check_f, & size) == SCIL_NO_ERR);
+  assert(size < COUNT * 2);
+
+  // too many bits, overflow and subnormals with too few bits are rejected
+  assert(compress("half", 12, SCIL_TYPE_FLOAT, data_f, COUNT, buff, buff_size, tmp, check_f, & size) == SCIL_PRECISION_ERR);
+  assert(compress("bfloat16", 9, SCIL_TYPE_FLOAT, data_f, COUNT, buff, buff_size, tmp, check_f, & size) == SCIL_PRECISION_ERR);
+  data[5] = 65520;
+  assert(compress("half", 11, SCIL_TYPE_DOUBLE, data, COUNT, buff, buff_size, tmp, check, & size) == SCIL_PRECISION_ERR);
+  data[5] = 0x1p-20;
+  assert(compress("half", 11, SCIL_TYPE_DOUBLE, data, COUNT, buff, buff_size, tmp, check, & size) == SCIL_PRECISION_ERR);
+  assert(compress("half", 5, SCIL_TYPE_DOUBLE, data, COUNT, buff, buff_size, tmp, check, & size) == SCIL_NO_ERR);
+
+  free(data);
+  free(check);
+  free(data_f);
+  free(check_f);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
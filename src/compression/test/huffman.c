@@ -25,6 +25,7 @@ int main() {
   // Chapter 16.3
   // Added another g with count 0, that we want to support
   // As such it shouldn't change other results
+  // The code lengths match the example, the codes are canonical
   huffman_entity test[TESTSIZE];
   test[0].data = "a";
   test[0].count = 45;
@@ -56,19 +57,19 @@ int main() {
     (test[0].bitvalue != 0) ||
     (test[0].bitcount != 1) ||
     (test[1].bitmask != 224) ||
-    (test[1].bitvalue != 160) ||
+    (test[1].bitvalue != 128) ||
     (test[1].bitcount != 3) ||
     (test[2].bitmask != 224) ||
-    (test[2].bitvalue != 128) ||
+    (test[2].bitvalue != 160) ||
     (test[2].bitcount != 3) ||
     (test[3].bitmask != 224) ||
-    (test[3].bitvalue != 224) ||
+    (test[3].bitvalue != 192) ||
     (test[3].bitcount != 3) ||
     (test[4].bitmask != 240) ||
-    (test[4].bitvalue != 208) ||
+    (test[4].bitvalue != 224) ||
     (test[4].bitcount != 4) ||
     (test[5].bitmask != 240) ||
-    (test[5].bitvalue != 192) ||
+    (test[5].bitvalue != 240) ||
     (test[5].bitcount != 4) ||
     (test[6].bitmask != 0) ||
     (test[6].bitvalue != 1) ||
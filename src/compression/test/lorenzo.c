@@ -0,0 +1,132 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The Lorenzo predictor must be lossless for all datatypes and dimensions and exploit the
+// multi-dimensional structure of smooth fields.
+#include "test-util.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define X 64
+#define Y 40
+#define Z 30
+#define COUNT (X * Y * Z)
+
+static size_t test(const char * name, enum SCIL_Datatype type, int threads, double abstol, void * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp, void * check){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+  hints.thread_count = threads;
+  hints.absolute_tolerance = abstol;
+
+  size_t out_size = test_compress_decompress(& hints, type, 0, NULL, data, dims, buff, buff_size, tmp, check);
+  if(abstol <= SCIL_ACCURACY_DBL_IGNORE){
+    assert(memcmp(check, data, COUNT * DATATYPE_LENGTH(type)) == 0);
+  }else{
+    test_check_tolerance(type, data, check, COUNT, abstol, DBL_MAX);
+  }
+  printf("%s type: %d dims: %d threads: %d size: %lld\n", name, type, dims->dims, threads, (long long) out_size);
+  return out_size;
+}
+
+static double field(int x, int y, int z){
+  return 100.0 * sin(x * 0.05) * cos(y * 0.07) + z * 0.5 + x * y * 0.01;
+}
+
+// a quantize stream written before the chain format flag, the minimum and the tolerance precede the values
+static void test_legacy_quantize(byte * buff, byte * tmp, double * check){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  const double minimum = -3.0;
+  const double abstol = 0.25;
+  buff[0] = 1;
+  memcpy(buff + 1, & minimum, sizeof(double));
+  memcpy(buff + 9, & abstol, sizeof(double));
+  for(int i=0; i < COUNT; i++){
+    uint64_t value = i % 13;
+    memcpy(buff + 17 + 8 * i, & value, sizeof(uint64_t));
+  }
+  buff[17 + 8 * COUNT] = 9;
+
+  int ret = scil_decompress(SCIL_TYPE_DOUBLE, check, & dims, buff, 18 + 8 * COUNT, tmp);
+  assert(ret == SCIL_NO_ERR);
+  for(int i=0; i < COUNT; i++){
+    const double expected = minimum + (i % 13) * 2 * abstol;
+    assert(check[i] <= expected && check[i] >= expected);
+  }
+}
+
+int main(){
+  scil_dims_t dims[4];
+  scil_dims_initialize_1d(& dims[0], COUNT);
+  scil_dims_initialize_2d(& dims[1], X * Y, Z);
+  scil_dims_initialize_3d(& dims[2], X, Y, Z);
+  scil_dims_initialize_4d(& dims[3], X, Y, Z / 3, 3);
+
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims[0], SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  byte * data = malloc(COUNT * sizeof(double));
+  byte * check = malloc(COUNT * sizeof(double));
+
+  for(int t=SCIL_TYPE_FLOAT; t <= SCIL_TYPE_INT64; t++){
+    for(int z=0; z < Z; z++){
+      for(int y=0; y < Y; y++){
+        for(int x=0; x < X; x++){
+          const int i = x + X * (y + Y * z);
+          const double v = field(x, y, z);
+          switch(t){
+            case SCIL_TYPE_FLOAT: ((float*) data)[i] = (float) v; break;
+            case SCIL_TYPE_DOUBLE: ((double*) data)[i] = v; break;
+            case SCIL_TYPE_INT8: ((int8_t*) data)[i] = (int8_t) v; break;
+            case SCIL_TYPE_INT16: ((int16_t*) data)[i] = (int16_t) (v * 100); break;
+            case SCIL_TYPE_INT32: ((int32_t*) data)[i] = (int32_t) (v * 10000); break;
+            case SCIL_TYPE_INT64: ((int64_t*) data)[i] = (int64_t) (v * 1000000); break;
+          }
+        }
+      }
+    }
+    for(int d=0; d < 4; d++){
+      size_t serial = test("lorenzo,zstd", (enum SCIL_Datatype) t, 1, SCIL_ACCURACY_DBL_IGNORE, data, & dims[d], buff, buff_size, tmp, check);
+      size_t parallel = test("lorenzo,zstd", (enum SCIL_Datatype) t, 4, SCIL_ACCURACY_DBL_IGNORE, data, & dims[d], buff, buff_size, tmp, check);
+      assert(serial == parallel);
+    }
+  }
+
+  // the data is still the last type, regenerate the doubles
+  for(int i=0; i < COUNT; i++){
+    ((double*) data)[i] = field(i % X, (i / X) % Y, i / (X * Y));
+  }
+  size_t delta = test("delta,zstd", SCIL_TYPE_DOUBLE, 1, SCIL_ACCURACY_DBL_IGNORE, data, & dims[2], buff, buff_size, tmp, check);
+  size_t lorenzo = test("lorenzo,zstd", SCIL_TYPE_DOUBLE, 1, SCIL_ACCURACY_DBL_IGNORE, data, & dims[2], buff, buff_size, tmp, check);
+  assert(lorenzo < delta);
+
+  // quantized values
+  size_t quantized = test("quantize,zstd", SCIL_TYPE_DOUBLE, 1, 0.01, data, & dims[2], buff, buff_size, tmp, check);
+  size_t predicted = test("quantize,lorenzo-int,zstd", SCIL_TYPE_DOUBLE, 4, 0.01, data, & dims[2], buff, buff_size, tmp, check);
+  assert(predicted < quantized);
+
+  test_legacy_quantize(buff, tmp, (double*) check);
+
+  free(data);
+  free(check);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,154 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// A preview decoded from the coarse levels of multires must equal the full decompression at its points.
+#include <scil.h>
+#include <scil-error.h>
+#include <scil-util.h>
+#include <algo/algo-multires.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TOLERANCE 0.01
+
+static int equal(double a, double b){
+  return a <= b && a >= b;
+}
+
+// checks every 2^reduction-th point of full against the preview
+static void check_preview(const double* preview, const double* full, const scil_dims_t* dims, int reduction){
+  scil_dims_t preview_dims;
+  scil_multires_preview_dims(& preview_dims, dims, reduction);
+  const size_t stride = (size_t) 1 << reduction;
+  size_t j = 0;
+  for(size_t z=0; z < preview_dims.length[2]; z++){
+    for(size_t y=0; y < preview_dims.length[1]; y++){
+      for(size_t x=0; x < preview_dims.length[0]; x++){
+        const size_t pos = x * stride + dims->length[0] * (y * stride + dims->length[1] * z * stride);
+        assert(equal(preview[j++], full[pos]));
+      }
+    }
+  }
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_3d(& dims, 65, 33, 17);
+  const size_t count = scil_dims_get_count(& dims);
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(count * sizeof(double));
+  double * full = malloc(count * sizeof(double));
+  double * preview = malloc(count * sizeof(double));
+
+  for(size_t i=0; i < count; i++){
+    data[i] = 10 * sin(i % 65 / 10.0) * cos(i / 65 % 33 / 7.0) + i / (65 * 33) + (double) (i % 7) / 100;
+  }
+
+  scil_user_hints_t hints;
+  scil_context_t* ctx;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = "multires";
+  hints.absolute_tolerance = TOLERANCE;
+  hints.thread_count = 4;
+  int ret = scil_context_create(&ctx, SCIL_TYPE_DOUBLE, 0, NULL, &hints);
+  assert(ret == SCIL_NO_ERR);
+  size_t out_size;
+  ret = scil_compress(buff, buff_size, data, & dims, & out_size, ctx);
+  assert(ret == SCIL_NO_ERR);
+  scil_destroy_context(ctx);
+  printf("size: %lld of %lld\n", (long long) out_size, (long long) (count * sizeof(double)));
+
+  ret = scil_decompress(SCIL_TYPE_DOUBLE, full, & dims, buff, out_size, tmp);
+  assert(ret == SCIL_NO_ERR);
+  for(size_t i=0; i < count; i++){
+    assert(fabs(full[i] - data[i]) <= TOLERANCE);
+  }
+
+  // 65 points in the longest dimension yield 6 levels, the coarser previews are decimated further
+  for(int reduction=1; reduction <= 8; reduction++){
+    ret = scil_decompress_preview(SCIL_TYPE_DOUBLE, preview, & dims, buff, out_size, tmp, reduction);
+    assert(ret == SCIL_NO_ERR);
+    check_preview(preview, full, & dims, reduction);
+  }
+  assert(scil_decompress_preview(SCIL_TYPE_DOUBLE, preview, & dims, buff, out_size, tmp, -1) == SCIL_EINVAL);
+
+  // a preview reads the header and its levels only, the end of each level follows the number of levels and the tolerance
+  const byte * algo_data = buff + 1;
+  const int levels = algo_data[0];
+  assert(levels == 6);
+  const size_t header = 9 + 8 * (levels + 1);
+  uint64_t end;
+  memcpy(& end, algo_data + 9 + 8 * (levels - 2), 8);
+  ret = scil_multires_decompress_preview_double(preview, & dims, buff + 1, header + end, 2);
+  assert(ret == SCIL_NO_ERR);
+  check_preview(preview, full, & dims, 2);
+  assert(scil_multires_decompress_preview_double(preview, & dims, buff + 1, header + end, 1) == SCIL_BUFFER_ERR);
+
+  // a byte compressor behind multires is decoded before the preview
+  hints.force_compression_methods = "multires,lz4";
+  scil_context_create(&ctx, SCIL_TYPE_DOUBLE, 0, NULL, &hints);
+  ret = scil_compress(buff, buff_size, data, & dims, & out_size, ctx);
+  assert(ret == SCIL_NO_ERR);
+  scil_destroy_context(ctx);
+  ret = scil_decompress_preview(SCIL_TYPE_DOUBLE, preview, & dims, buff, out_size, tmp, 2);
+  assert(ret == SCIL_NO_ERR);
+  check_preview(preview, full, & dims, 2);
+
+  // other chains are decompressed fully only
+  hints.force_compression_methods = "abstol";
+  scil_context_create(&ctx, SCIL_TYPE_DOUBLE, 0, NULL, &hints);
+  ret = scil_compress(buff, buff_size, data, & dims, & out_size, ctx);
+  assert(ret == SCIL_NO_ERR);
+  scil_destroy_context(ctx);
+  assert(scil_decompress_preview(SCIL_TYPE_DOUBLE, preview, & dims, buff, out_size, tmp, 1) == SCIL_EINVAL);
+
+  // float data through the algorithm alone
+  float * data_f = malloc(count * sizeof(float));
+  float * check_f = malloc(count * sizeof(float));
+  for(size_t i=0; i < count; i++){
+    data_f[i] = (float) data[i];
+  }
+  scil_context_create(&ctx, SCIL_TYPE_FLOAT, 0, NULL, &hints);
+  ret = scil_multires_compress_float(ctx, buff, & out_size, data_f, & dims);
+  assert(ret == SCIL_NO_ERR);
+  ret = scil_multires_decompress_float(check_f, & dims, buff, out_size);
+  assert(ret == SCIL_NO_ERR);
+  for(size_t i=0; i < count; i++){
+    assert(fabsf(check_f[i] - data_f[i]) <= (float) TOLERANCE);
+  }
+
+  // the quantized errors of values far beyond the tolerance cannot be represented
+  for(size_t i=0; i < count; i++){
+    data[i] = i % 2 ? 1e300 : -1e300;
+  }
+  assert(scil_multires_compress_double(ctx, buff, & out_size, data, & dims) == SCIL_PRECISION_ERR);
+  scil_destroy_context(ctx);
+
+  free(data_f);
+  free(check_f);
+  free(data);
+  free(full);
+  free(preview);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,106 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// Bit packing must restore all widths, rare spikes must not widen the values of abstol and the pfor stage.
+#include "test-util.h"
+#include <scil-bitpack.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define X 300
+#define Y 200
+#define COUNT (X * Y)
+
+static void test_bitpack(uint64_t * values, uint64_t * check, byte * buff){
+  for(int bits=0; bits <= 64; bits++){
+    const uint64_t mask = bits == 64 ? ~(uint64_t) 0 : ((uint64_t) 1 << bits) - 1;
+    for(size_t count=0; count < 1100; count += count < 20 ? 1 : 357){
+      for(size_t i=0; i < count; i++){
+        values[i] = (((uint64_t) rand() << 40) ^ ((uint64_t) rand() << 20) ^ (uint64_t) rand()) & mask;
+      }
+      size_t size = scil_bitpack(buff, values, count, bits);
+      assert(size == scil_bitpack_size(count, bits));
+      assert(scil_bitunpack(check, buff, count, bits) == size);
+      assert(memcmp(values, check, count * sizeof(uint64_t)) == 0);
+
+      // a few values are exceptions
+      for(size_t i=0; i < count; i += 97){
+        values[i] = mask;
+      }
+      size = scil_pfor_compress(buff, values, count, bits);
+      assert(size <= scil_pfor_bound(count, bits));
+      size_t parsed;
+      int ret = scil_pfor_decompress(check, count, bits, buff, size, & parsed);
+      assert(ret == SCIL_NO_ERR && parsed == size);
+      assert(memcmp(values, check, count * sizeof(uint64_t)) == 0);
+    }
+  }
+}
+
+static size_t test(const char * name, double abstol, double * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp, double * check){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+  hints.absolute_tolerance = abstol;
+
+  size_t out_size = test_compress_decompress(& hints, SCIL_TYPE_DOUBLE, 0, NULL, data, dims, buff, buff_size, tmp, check);
+  test_check_tolerance(SCIL_TYPE_DOUBLE, data, check, COUNT, abstol, DBL_MAX);
+  printf("%s size: %lld\n", name, (long long) out_size);
+  return out_size;
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_2d(& dims, X, Y);
+
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+
+  test_bitpack((uint64_t*) data, (uint64_t*) check, buff);
+
+  for(int i=0; i < COUNT; i++){
+    data[i] = 0.5 + 0.4 * sin(i * 0.001);
+  }
+  // about 10 bits per value
+  size_t smooth = test("abstol", 0.001, data, & dims, buff, buff_size, tmp, check);
+  assert(smooth < COUNT * 10 / 8 + 64);
+
+  // rare spikes in both directions
+  for(int i=0; i < COUNT; i += 2111){
+    data[i] = i % 2 ? 1e4 : -1e4;
+  }
+  size_t spiky = test("abstol", 0.001, data, & dims, buff, buff_size, tmp, check);
+  assert(spiky < smooth * 5 / 4);
+
+  size_t pfor = test("quantize,pfor", 0.001, data, & dims, buff, buff_size, tmp, check);
+  assert(pfor < smooth * 5 / 4);
+  // the residuals of the predictor are signed
+  size_t residuals = test("quantize,lorenzo-int,pfor", 0.001, data, & dims, buff, buff_size, tmp, check);
+  assert(residuals < pfor);
+
+  free(data);
+  free(check);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
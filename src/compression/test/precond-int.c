@@ -0,0 +1,75 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The delta, delta2 and zigzag stages must restore the quantized values of every width and shrink smooth fields.
+#include "test-util.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define COUNT 100003
+
+static size_t test(const char * name, double abstol, double * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp, double * check){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+  hints.absolute_tolerance = abstol;
+  hints.thread_count = 2;
+
+  size_t out_size = test_compress_decompress(& hints, SCIL_TYPE_DOUBLE, 0, NULL, data, dims, buff, buff_size, tmp, check);
+  test_check_tolerance(SCIL_TYPE_DOUBLE, data, check, COUNT, abstol, DBL_MAX);
+  printf("%s %g size: %lld\n", name, abstol, (long long) out_size);
+  return out_size;
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+
+  // smooth with a curvature, the differences change sign
+  for(int i=0; i < COUNT; i++){
+    data[i] = 100 * sin(i * 0.0002) + 1e-5 * i;
+  }
+
+  // the tolerances need 1, 2, 4 and 8 bytes per value
+  const double tolerances[] = {1, 0.05, 1e-5, 1e-9};
+  const char * algos[] = {"quantize,delta-int", "quantize,delta2-int", "quantize,zigzag", "quantize,delta-int,zigzag,zstd", "quantize,delta2-int,zigzag,lz4", "quantize,delta2-int,rans", NULL};
+  for(int t=0; t < 4; t++){
+    for(int a=0; algos[a] != NULL; a++){
+      test(algos[a], tolerances[t], data, & dims, buff, buff_size, tmp, check);
+    }
+  }
+
+  size_t plain = test("quantize,zstd", 1e-5, data, & dims, buff, buff_size, tmp, check);
+  size_t delta = test("quantize,delta-int,zigzag,zstd", 1e-5, data, & dims, buff, buff_size, tmp, check);
+  size_t delta2 = test("quantize,delta2-int,zigzag,zstd", 1e-5, data, & dims, buff, buff_size, tmp, check);
+  assert(delta < plain / 2);
+  assert(delta2 < delta);
+
+  free(data);
+  free(check);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
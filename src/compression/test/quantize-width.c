@@ -0,0 +1,85 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The quantized values are narrowed to 1, 2, 4 or 8 bytes, every stage after the converter must restore them.
+#include "test-util.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COUNT 100000
+
+static size_t test(const char * name, double abstol, double * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp, double * check){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+  hints.absolute_tolerance = abstol;
+
+  size_t out_size = test_compress_decompress(& hints, SCIL_TYPE_DOUBLE, 0, NULL, data, dims, buff, buff_size, tmp, check);
+  test_check_tolerance(SCIL_TYPE_DOUBLE, data, check, COUNT, abstol, DBL_MAX);
+  printf("%s %g size: %lld\n", name, abstol, (long long) out_size);
+  return out_size;
+}
+
+// the converter is the outermost stage of these chains, it must not widen the values in the caller's buffer
+static void test_exact_buffer(const char * name, double abstol, double * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp, double * check){
+  size_t out_size = test(name, abstol, data, dims, buff, buff_size, tmp, check);
+  byte * exact = malloc(out_size);
+  memcpy(exact, buff, out_size);
+  int ret = scil_decompress(SCIL_TYPE_DOUBLE, check, dims, exact, out_size, tmp);
+  assert(ret == SCIL_NO_ERR);
+  test_check_tolerance(SCIL_TYPE_DOUBLE, data, check, COUNT, abstol, DBL_MAX);
+  free(exact);
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_2d(& dims, 400, COUNT / 400);
+
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+
+  for(int i=0; i < COUNT; i++){
+    data[i] = 100 * sin(i * 0.001) + (double) rand() / RAND_MAX;
+  }
+
+  // the tolerances need 1, 2, 4 and 8 bytes per value
+  const double tolerances[] = {1, 0.05, 1e-5, 1e-9};
+  const char * algos[] = {"quantize", "quantize,zstd", "quantize,lorenzo-int", "quantize,lorenzo-int,lorenzo-int,lz4", "fill,quantize,lorenzo-int,zstd", "quantize,lorenzo-int,rans", NULL};
+  for(int t=0; t < 4; t++){
+    for(int a=0; algos[a] != NULL; a++){
+      test(algos[a], tolerances[t], data, & dims, buff, buff_size, tmp, check);
+    }
+    // the converter output alone holds the narrowed values
+    size_t size = test("quantize", tolerances[t], data, & dims, buff, buff_size, tmp, check);
+    assert(size < (size_t) COUNT * (t == 3 ? 8 : (1 << t)) + 64);
+
+    test_exact_buffer("quantize", tolerances[t], data, & dims, buff, buff_size, tmp, check);
+    test_exact_buffer("fill,quantize", tolerances[t], data, & dims, buff, buff_size, tmp, check);
+  }
+
+  free(data);
+  free(check);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,128 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The vectorized shuffles must match the plain transposition, also for counts
+// that are not a multiple of the vector width.
+#include <scil.h>
+#include <scil-error.h>
+#include <scil-util.h>
+#include <scil-shuffle.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#define COUNT 1037
+
+static int get_bit(const byte * buf, size_t bit){
+  return (buf[bit / 8] >> (bit % 8)) & 1;
+}
+
+static void test_kernels(const byte * data, byte * shuffled, byte * check, size_t count, int type_size){
+  scil_byte_shuffle(shuffled, data, count, type_size);
+  for(size_t i=0; i < count; i++){
+    for(int b=0; b < type_size; b++){
+      assert(shuffled[b * count + i] == data[i * type_size + b]);
+    }
+  }
+  scil_byte_unshuffle(check, shuffled, count, type_size);
+  assert(memcmp(check, data, count * type_size) == 0);
+
+  scil_bit_shuffle(shuffled, data, count, type_size);
+  const size_t groups = count / 8;
+  for(int b=0; b < type_size; b++){
+    const byte * plane = shuffled + b * count;
+    for(size_t i=0; i < groups * 8; i++){
+      for(int bit=0; bit < 8; bit++){
+        assert(get_bit(plane, bit * groups * 8 + i) == get_bit(data + i * type_size + b, bit));
+      }
+    }
+    for(size_t i=groups * 8; i < count; i++){
+      assert(plane[i] == data[i * type_size + b]);
+    }
+  }
+  scil_bit_unshuffle(check, shuffled, count, type_size);
+  assert(memcmp(check, data, count * type_size) == 0);
+}
+
+static void test_chain(const char * name, enum SCIL_Datatype type, void * data, byte * buff, size_t buff_size, byte * tmp, void * check){
+  scil_user_hints_t hints;
+  scil_context_t* ctx;
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+
+  int ret = scil_context_create(&ctx, type, 0, NULL, &hints);
+  assert(ret == SCIL_NO_ERR);
+  size_t out_size;
+  ret = scil_compress(buff, buff_size, data, & dims, & out_size, ctx);
+  assert(ret == SCIL_NO_ERR);
+  scil_destroy_context(ctx);
+
+  const size_t size = COUNT * DATATYPE_LENGTH(type);
+  memset(check, 0, size);
+  ret = scil_decompress(type, check, & dims, buff, out_size, tmp);
+  assert(ret == SCIL_NO_ERR);
+  assert(memcmp(check, data, size) == 0);
+  printf("%s type: %d size: %lld\n", name, type, (long long) out_size);
+}
+
+int main(){
+  byte * data = malloc(COUNT * 8);
+  byte * shuffled = malloc(COUNT * 8);
+  byte * check = malloc(COUNT * 8);
+
+  for(int i=0; i < COUNT * 8; i++){
+    data[i] = (byte) (i * 7 + i / 13);
+  }
+  const size_t counts[] = {0, 1, 7, 8, 15, 16, 17, 64, COUNT};
+  for(int c=0; c < 9; c++){
+    for(int type_size=1; type_size <= 8; type_size++){
+      test_kernels(data, shuffled, check, counts[c], type_size);
+    }
+  }
+
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  size_t buff_size = scil_get_compressed_data_size_limit(&dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+
+  const char * chains[] = {"shuffle,lz4", "bitshuffle,zstd", "shuffle,delta,gzip", NULL};
+  for(int t=SCIL_TYPE_FLOAT; t <= SCIL_TYPE_INT64; t++){
+    for(int i=0; i < COUNT; i++){
+      switch(t){
+        case SCIL_TYPE_FLOAT: ((float*) data)[i] = 100.0f + i * 0.001f; break;
+        case SCIL_TYPE_DOUBLE: ((double*) data)[i] = 100.0 + i * 0.001; break;
+        case SCIL_TYPE_INT8: ((int8_t*) data)[i] = (int8_t) (i / 3); break;
+        case SCIL_TYPE_INT16: ((int16_t*) data)[i] = (int16_t) (i * 5); break;
+        case SCIL_TYPE_INT32: ((int32_t*) data)[i] = i * 1000 + 7; break;
+        case SCIL_TYPE_INT64: ((int64_t*) data)[i] = (int64_t) i * 100000; break;
+      }
+    }
+    for(int c=0; chains[c] != NULL; c++){
+      test_chain(chains[c], (enum SCIL_Datatype) t, data, buff, buff_size, tmp, check);
+    }
+  }
+
+  free(data);
+  free(shuffled);
+  free(check);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,92 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// Clustered exponents with rare outliers are coded by their index in the exponent dictionary of sigbits.
+#include "test-util.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define COUNT 100000
+
+static size_t test(enum SCIL_Datatype type, void * data, double fill_value, byte * buff, size_t buff_size, byte * tmp, void * check){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = "sigbits";
+  hints.significant_bits = 11;
+  hints.fill_value = fill_value;
+
+  size_t out_size = test_compress_decompress(& hints, type, 0, NULL, data, & dims, buff, buff_size, tmp, check);
+  for(int i=0; i < COUNT; i++){
+    const double value = type == SCIL_TYPE_DOUBLE ? ((double*) data)[i] : (double) ((float*) data)[i];
+    const double restored = type == SCIL_TYPE_DOUBLE ? ((double*) check)[i] : (double) ((float*) check)[i];
+    if(value <= fill_value && value >= fill_value){
+      assert(restored <= fill_value && restored >= fill_value);
+    }else{
+      assert(fabs(restored - value) <= fabs(value) * 0x1p-11);
+    }
+  }
+  printf("%s size: %lld\n", type == SCIL_TYPE_DOUBLE ? "double" : "float", (long long) out_size);
+  return out_size;
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+  float * data_f = malloc(COUNT * sizeof(float));
+  float * check_f = malloc(COUNT * sizeof(float));
+
+  // two clusters of magnitudes and rare outliers span 140 exponents, only 6 of them occur
+  for(int i=0; i < COUNT; i++){
+    data[i] = (i % 2 ? 1000 : 1) * (1 + (double) rand() / RAND_MAX / 2);
+    if(i % 10000 == 7){
+      data[i] = 1e-20;
+    }else if(i % 10000 == 8){
+      data[i] = 1e20;
+    }
+    data_f[i] = (float) data[i];
+  }
+  // the sign is constant, 10 bits for the mantissa and 3 for the index of the exponent instead of 8
+  size_t size = test(SCIL_TYPE_DOUBLE, data, DBL_MAX, buff, buff_size, tmp, check);
+  assert(size < COUNT * 14 / 8 + 100);
+  size = test(SCIL_TYPE_FLOAT, data_f, DBL_MAX, buff, buff_size, tmp, check_f);
+  assert(size < COUNT * 14 / 8 + 100);
+
+  // the exponents reserved for the fill value and for zero are part of the dictionary
+  for(int i=0; i < COUNT; i += 100){
+    data[i] = -999;
+    data[i + 1] = 0;
+  }
+  size = test(SCIL_TYPE_DOUBLE, data, -999, buff, buff_size, tmp, check);
+  assert(size < COUNT * 14 / 8 + 100);
+
+  free(data);
+  free(check);
+  free(data_f);
+  free(check_f);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,114 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// Progressive sigbits data read with fewer significant bits must keep that precision.
+#include <scil.h>
+#include <scil-error.h>
+#include <scil-util.h>
+#include <algo/algo-sigbits.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COUNT 10000
+#define BITS 20
+
+static int equal(double a, double b){
+  return a <= b && a >= b && signbit(a) == signbit(b);
+}
+
+int main(){
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, COUNT);
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+  double * full = malloc(COUNT * sizeof(double));
+
+  for(int i=0; i < COUNT; i++){
+    data[i] = (i % 3 - 1) * 100 * sin(i / 100.0) * exp(i % 7);
+  }
+  data[10] = NAN;
+  data[11] = -INFINITY;
+  data[12] = 0.0;
+
+  scil_user_hints_t hints;
+  scil_context_t* ctx;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = "sigbits-progressive";
+  hints.significant_bits = BITS;
+  int ret = scil_context_create(&ctx, SCIL_TYPE_DOUBLE, 0, NULL, &hints);
+  assert(ret == SCIL_NO_ERR);
+  size_t out_size;
+  ret = scil_compress(buff, buff_size, data, & dims, & out_size, ctx);
+  assert(ret == SCIL_NO_ERR);
+  scil_destroy_context(ctx);
+  printf("size: %lld\n", (long long) out_size);
+
+  ret = scil_decompress(SCIL_TYPE_DOUBLE, full, & dims, buff, out_size, tmp);
+  assert(ret == SCIL_NO_ERR);
+  for(int bits=1; bits <= BITS + 1; bits++){
+    ret = scil_decompress_precision(SCIL_TYPE_DOUBLE, check, & dims, buff, out_size, tmp, bits);
+    assert(ret == SCIL_NO_ERR);
+    for(int i=0; i < COUNT; i++){
+      if(i == 10){
+        assert(isnan(check[i]));
+      }else if(i == 11 || i == 12 || bits >= BITS){
+        assert(equal(check[i], full[i]));
+      }else{
+        // the error of reading fewer bits adds to the error of the bits stored
+        assert(fabs(check[i] - data[i]) <= fabs(data[i]) * (ldexp(1, -bits) + ldexp(1, -BITS)));
+      }
+    }
+  }
+  assert(scil_decompress_precision(SCIL_TYPE_DOUBLE, check, & dims, buff, out_size, tmp, 0) == SCIL_EINVAL);
+
+  // a reader of 8 bits only needs the header and the planes of sign, exponent and 7 mantissa bits
+  float * data_f = malloc(COUNT * sizeof(float));
+  float * check_f = malloc(COUNT * sizeof(float));
+  for(int i=0; i < COUNT; i++){
+    data_f[i] = (float) (1 + i / (double) COUNT);
+  }
+  scil_context_create(&ctx, SCIL_TYPE_FLOAT, 0, NULL, &hints);
+  ret = scil_sigbits_progressive_compress_float(ctx, buff, & out_size, data_f, & dims);
+  assert(ret == SCIL_NO_ERR);
+  scil_destroy_context(ctx);
+  const size_t prefix = out_size - (BITS - 8) * ((COUNT + 63) / 64 * 8);
+  ret = scil_sigbits_progressive_decompress_precision_float(check_f, & dims, buff, prefix, 8);
+  assert(ret == SCIL_NO_ERR);
+  for(int i=0; i < COUNT; i++){
+    assert(fabsf(check_f[i] - data_f[i]) <= data_f[i] * (0x1p-8f + 0x1p-20f));
+  }
+  assert(scil_sigbits_progressive_decompress_precision_float(check_f, & dims, buff, prefix, 9) == SCIL_BUFFER_ERR);
+  assert(scil_sigbits_progressive_decompress_float(check_f, & dims, buff, out_size) == SCIL_NO_ERR);
+  for(int i=0; i < COUNT; i++){
+    assert(fabsf(check_f[i] - data_f[i]) <= data_f[i] * 0x1p-20f);
+  }
+
+  free(data);
+  free(check);
+  free(full);
+  free(data_f);
+  free(check_f);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,112 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The native SZ compressor must honor the absolute tolerance for all dimensions,
+// keep values it cannot predict and be independent of the number of threads.
+#include "test-util.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define X 80
+#define Y 64
+#define Z 64
+#define COUNT (X * Y * Z)
+
+static size_t test(const char * name, enum SCIL_Datatype type, int threads, double abstol, void * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp, void * check){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+  hints.thread_count = threads;
+  hints.absolute_tolerance = abstol;
+
+  size_t out_size = test_compress_decompress(& hints, type, 0, NULL, data, dims, buff, buff_size, tmp, check);
+  test_check_tolerance(type, data, check, COUNT, abstol, DBL_MAX);
+  printf("%s type: %d dims: %d threads: %d abstol: %g size: %lld\n", name, type, dims->dims, threads, abstol, (long long) out_size);
+  return out_size;
+}
+
+static double field(int x, int y, int z){
+  return 100.0 * sin(x * 0.05) * cos(y * 0.07) + z * 0.5 + x * y * 0.01;
+}
+
+int main(){
+  scil_dims_t dims[4];
+  scil_dims_initialize_1d(& dims[0], COUNT);
+  scil_dims_initialize_2d(& dims[1], X * Y, Z);
+  scil_dims_initialize_3d(& dims[2], X, Y, Z);
+  scil_dims_initialize_4d(& dims[3], X, Y, Z / 4, 4);
+
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims[0], SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+  float * fdata = malloc(COUNT * sizeof(float));
+
+  for(int z=0; z < Z; z++){
+    for(int y=0; y < Y; y++){
+      for(int x=0; x < X; x++){
+        int i = x + X * (y + Y * z);
+        data[i] = field(x, y, z);
+        fdata[i] = (float) data[i];
+      }
+    }
+  }
+  // values that cannot be predicted
+  data[17] = NAN;
+  data[COUNT / 2] = INFINITY;
+  data[COUNT / 2 + 1] = -INFINITY;
+  data[COUNT / 3] = 1e300;
+  fdata[5] = NAN;
+  fdata[COUNT - 1] = 3e38f;
+
+  const double tolerances[] = {0.01, 1e-6};
+  for(int t=0; t < 2; t++){
+    for(int d=0; d < 4; d++){
+      size_t serial = test("sz-native", SCIL_TYPE_DOUBLE, 1, tolerances[t], data, & dims[d], buff, buff_size, tmp, check);
+      size_t parallel = test("sz-native", SCIL_TYPE_DOUBLE, 4, tolerances[t], data, & dims[d], buff, buff_size, tmp, check);
+      assert(serial == parallel);
+      test("sz-native", SCIL_TYPE_FLOAT, 4, tolerances[t], fdata, & dims[d], buff, buff_size, tmp, check);
+    }
+  }
+
+  // noise is stored when the blocks do not fit into the size of the data
+  uint64_t seed = 4711;
+  for(int i=0; i < COUNT; i++){
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    data[i] = (double) (seed >> 11);
+  }
+  size_t stored = test("sz-native", SCIL_TYPE_DOUBLE, 4, 1e-6, data, & dims[2], buff, buff_size, tmp, check);
+  assert(stored > COUNT * sizeof(double));
+
+  // the prediction from reconstructed values exploits the 3D structure, quantize needs finite values
+  for(int i=0; i < COUNT; i++){
+    data[i] = field(i % X, (i / X) % Y, i / (X * Y));
+  }
+  size_t native = test("sz-native", SCIL_TYPE_DOUBLE, 4, 0.01, data, & dims[2], buff, buff_size, tmp, check);
+  size_t quantized = test("quantize,rans", SCIL_TYPE_DOUBLE, 4, 0.01, data, & dims[2], buff, buff_size, tmp, check);
+  assert(native < quantized / 2);
+
+  free(data);
+  free(fdata);
+  free(check);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,69 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The round trip through a forced compression chain shared by the tests.
+#ifndef SCIL_TEST_UTIL_H
+#define SCIL_TEST_UTIL_H
+
+#include <scil.h>
+#include <scil-error.h>
+#include <scil-util.h>
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+/**
+ * \brief Compress the data with the hints and decompress it into check, both must succeed
+ * \return The compressed size
+ */
+static inline size_t test_compress_decompress(const scil_user_hints_t* hints, enum SCIL_Datatype type, int special_count, scil_value_t* special, void* data, scil_dims_t* dims, byte* buff, size_t buff_size, byte* tmp, void* check){
+  scil_context_t* ctx;
+  int ret = scil_context_create(&ctx, type, special_count, special, hints);
+  assert(ret == SCIL_NO_ERR);
+  size_t out_size;
+  ret = scil_compress(buff, buff_size, data, dims, & out_size, ctx);
+  assert(ret == SCIL_NO_ERR);
+  scil_destroy_context(ctx);
+
+  memset(check, 0, scil_dims_get_size(dims, type));
+  ret = scil_decompress(type, check, dims, buff, out_size, tmp);
+  assert(ret == SCIL_NO_ERR);
+  return out_size;
+}
+
+/**
+ * \brief Check the restored floating point values against the absolute tolerance,
+ * NaN, infinite values and the fill value (unless DBL_MAX) must be restored as they are
+ */
+static inline void test_check_tolerance(enum SCIL_Datatype type, const void* data, const void* check, size_t count, double abstol, double fill_value){
+  assert(type == SCIL_TYPE_DOUBLE || type == SCIL_TYPE_FLOAT);
+  for(size_t i=0; i < count; i++){
+    const double v = type == SCIL_TYPE_DOUBLE ? ((const double*) data)[i] : (double) ((const float*) data)[i];
+    const double c = type == SCIL_TYPE_DOUBLE ? ((const double*) check)[i] : (double) ((const float*) check)[i];
+    if(isnan(v)){
+      assert(isnan(c));
+    }else if(isinf(v)){
+      assert(isinf(c) && (v > 0) == (c > 0));
+    }else if(fill_value < DBL_MAX && v <= fill_value && v >= fill_value){
+      assert(c <= fill_value && c >= fill_value);
+    }else{
+      assert(fabs(c - v) <= abstol);
+    }
+  }
+}
+
+#endif /* SCIL_TEST_UTIL_H */
@@ -1,10 +1,98 @@
 #include <stdio.h>
 
 #include <scil.h>
+#include <scil-error.h>
 #include <scil-util.h>
+#include <assert.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+// a smooth 3D field must keep the tolerance and compress
+static void test_3d(int threads){
+    scil_dims_t dims;
+    scil_dims_initialize_3d(&dims, 100, 37, 20);
+    const size_t count = scil_dims_get_count(&dims);
+    const double tolerance = 0.001;
+
+    size_t compressed_size = scil_get_compressed_data_size_limit(&dims, SCIL_TYPE_DOUBLE);
+    double* data = (double*)malloc(count * sizeof(double));
+    double* result = (double*)malloc(count * sizeof(double));
+    byte* buffer = (byte*)malloc(compressed_size);
+    byte* tmp = (byte*)malloc(compressed_size);
+    for(size_t i = 0; i < count; ++i){
+      data[i] = sin(i % 100 / 15.0) * cos(i / 100 % 37 / 9.0) + i / 3700 * 0.1;
+    }
+    data[1234] = 100;
+
+    scil_user_hints_t hints;
+    scil_user_hints_initialize(&hints);
+    hints.absolute_tolerance = tolerance;
+    hints.force_compression_methods = "wavelets";
+    hints.thread_count = threads;
+    scil_context_t* context;
+    scil_context_create(&context, SCIL_TYPE_DOUBLE, 0, NULL, &hints);
+
+    size_t out_size;
+    int ret = scil_compress(buffer, compressed_size, data, &dims, &out_size, context);
+    assert(ret == SCIL_NO_ERR);
+    printf("3D: %zu of %zu bytes\n", out_size, count * sizeof(double));
+    assert(out_size < count * sizeof(double) / 4);
+    // the chain stores the number of compressors before the filter, smooth data uses CDF 9/7
+    assert(buffer[1] == 0);
+    ret = scil_decompress(SCIL_TYPE_DOUBLE, result, &dims, buffer, out_size, tmp);
+    assert(ret == SCIL_NO_ERR);
+    for(size_t i = 0; i < count; ++i){
+      assert(fabs(result[i] - data[i]) <= tolerance);
+    }
+
+    scil_destroy_context(context);
+    free(data);
+    free(result);
+    free(buffer);
+    free(tmp);
+}
+
+// piecewise constant data is coded smaller with the CDF 5/3 filter
+static void test_steps(void){
+    scil_dims_t dims;
+    scil_dims_initialize_1d(&dims, 100000);
+    const size_t count = scil_dims_get_count(&dims);
+    const double tolerance = 0.01;
+
+    size_t compressed_size = scil_get_compressed_data_size_limit(&dims, SCIL_TYPE_DOUBLE);
+    double* data = (double*)malloc(count * sizeof(double));
+    double* result = (double*)malloc(count * sizeof(double));
+    byte* buffer = (byte*)malloc(compressed_size);
+    byte* tmp = (byte*)malloc(compressed_size);
+    for(size_t i = 0; i < count; ++i){
+      data[i] = (double) (i / 50 % 7);
+    }
+
+    scil_user_hints_t hints;
+    scil_user_hints_initialize(&hints);
+    hints.absolute_tolerance = tolerance;
+    hints.force_compression_methods = "wavelets";
+    scil_context_t* context;
+    scil_context_create(&context, SCIL_TYPE_DOUBLE, 0, NULL, &hints);
+
+    size_t out_size;
+    int ret = scil_compress(buffer, compressed_size, data, &dims, &out_size, context);
+    assert(ret == SCIL_NO_ERR);
+    printf("steps: %zu of %zu bytes\n", out_size, count * sizeof(double));
+    assert(buffer[1] == 1);
+    ret = scil_decompress(SCIL_TYPE_DOUBLE, result, &dims, buffer, out_size, tmp);
+    assert(ret == SCIL_NO_ERR);
+    for(size_t i = 0; i < count; ++i){
+      assert(fabs(result[i] - data[i]) <= tolerance);
+    }
+
+    scil_destroy_context(context);
+    free(data);
+    free(result);
+    free(buffer);
+    free(tmp);
+}
 
 int main(void){
 
@@ -50,11 +138,13 @@ int main(void){
     }
 
     size_t out_size;
-    scil_compress(buffer_out, compressed_size, buffer_in, &dims, &out_size, context);
+    int ret = scil_compress(buffer_out, compressed_size, buffer_in, &dims, &out_size, context);
+    assert(ret == SCIL_NO_ERR);
 
     printf("\n>DECOMPRESSION\n");
 
-    scil_decompress(SCIL_TYPE_FLOAT, buffer_end, &dims, buffer_out, out_size, buffer_tmp);
+    ret = scil_decompress(SCIL_TYPE_FLOAT, buffer_end, &dims, buffer_out, out_size, buffer_tmp);
+    assert(ret == SCIL_NO_ERR);
 
     printf("Output\n");
     for(i=0;i<count1;i++) {
@@ -68,6 +158,7 @@ int main(void){
     for(i=0;i<count1;i++)
       for(j=0;j<count2;j++) {
         mse+=((*(buffer_in+i*count2+j)) - (*(buffer_end+i*count2+j))) * ((*(buffer_in+i*count2+j)) - (*(buffer_end+i*count2+j)));
+        assert(fabsf(*(buffer_in+i*count2+j) - *(buffer_end+i*count2+j)) <= 0.005f);
       }
     mse/=count1*count2;
 
@@ -86,5 +177,9 @@ int main(void){
 
     //scil_destroy_context(context);
 
+    test_3d(1);
+    test_3d(4);
+    test_steps();
+
     return 0;
 }
@@ -0,0 +1,159 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The zfp algorithms must map up to 4D to the fields of zfp, honor the tolerance with any number of threads,
+// and the blocks of zfp-rate must be decodable from their offset.
+#include <scil.h>
+#include <scil-error.h>
+#include <scil-util.h>
+#include <algo/algo-zfp-rate.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define X 20
+#define Y 12
+#define Z 8
+#define W 4
+#define COUNT (X * Y * Z * W)
+
+// the exit code for skipped tests
+#define SKIP 77
+
+static int compress(const char * name, int threads, double abstol, double * data, scil_dims_t * dims, byte * buff, size_t buff_size, byte * tmp, double * check){
+  scil_user_hints_t hints;
+  scil_context_t* ctx;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = (char*) name;
+  hints.thread_count = threads;
+  hints.absolute_tolerance = abstol;
+
+  int ret = scil_context_create(&ctx, SCIL_TYPE_DOUBLE, 0, NULL, &hints);
+  assert(ret == SCIL_NO_ERR);
+  size_t out_size;
+  ret = scil_compress(buff, buff_size, data, dims, & out_size, ctx);
+  scil_destroy_context(ctx);
+  if(ret != SCIL_NO_ERR){
+    return ret;
+  }
+  ret = scil_decompress(SCIL_TYPE_DOUBLE, check, dims, buff, out_size, tmp);
+  if(ret != SCIL_NO_ERR){
+    return ret;
+  }
+  for(int i=0; i < COUNT; i++){
+    assert(fabs(check[i] - data[i]) <= abstol);
+  }
+  printf("%s dims: %d threads: %d size: %lld\n", name, dims->dims, threads, (long long) out_size);
+  return SCIL_NO_ERR;
+}
+
+static void test_rate(double * data, scil_dims_t * dims, byte * buff, double * check){
+  scil_user_hints_t hints;
+  scil_context_t* ctx;
+  scil_user_hints_initialize(& hints);
+  hints.fixed_rate = 16;
+  hints.thread_count = 4;
+  int ret = scil_context_create(&ctx, SCIL_TYPE_DOUBLE, 0, NULL, &hints);
+  assert(ret == SCIL_NO_ERR);
+
+  size_t out_size;
+  ret = scil_zfp_rate_compress_double(ctx, buff, & out_size, data, dims);
+  assert(ret == SCIL_NO_ERR);
+  scil_destroy_context(ctx);
+  ret = scil_zfp_rate_decompress_double(check, dims, buff, out_size);
+  assert(ret == SCIL_NO_ERR);
+
+  // the blocks of 4^d values are coded with 16 bits per value
+  size_t block_values = 1;
+  size_t blocks[4] = {1, 1, 1, 1};
+  for(int d=0; d < dims->dims; d++){
+    block_values *= 4;
+    blocks[d] = (dims->length[d] + 3) / 4;
+  }
+  const size_t block_count = blocks[0] * blocks[1] * blocks[2] * blocks[3];
+  assert(out_size >= 8 + block_count * block_values * 2);
+
+  // each block must match the values of the full decompression
+  double block[256];
+  for(size_t b=0; b < block_count; b++){
+    ret = scil_zfp_rate_decompress_block_double(block, dims, buff, out_size, b);
+    assert(ret == SCIL_NO_ERR);
+    size_t pos[4] = {b % blocks[0], (b / blocks[0]) % blocks[1], (b / (blocks[0] * blocks[1])) % blocks[2], b / (blocks[0] * blocks[1] * blocks[2])};
+    for(size_t v=0; v < block_values; v++){
+      size_t index = 0;
+      size_t stride = 1;
+      int inside = 1;
+      for(int d=0; d < dims->dims; d++){
+        const size_t coord = 4 * pos[d] + (v >> (2 * d)) % 4;
+        inside &= coord < dims->length[d];
+        index += coord * stride;
+        stride *= dims->length[d];
+      }
+      if(inside){
+        assert(block[v] <= check[index] && block[v] >= check[index]);
+      }
+    }
+  }
+  ret = scil_zfp_rate_decompress_block_double(block, dims, buff, out_size, block_count);
+  assert(ret == SCIL_EINVAL);
+}
+
+int main(){
+  scil_dims_t dims[4];
+  scil_dims_initialize_1d(& dims[0], COUNT);
+  scil_dims_initialize_2d(& dims[1], X * Y, Z * W);
+  scil_dims_initialize_3d(& dims[2], X, Y, Z * W);
+  scil_dims_initialize_4d(& dims[3], X, Y, Z, W);
+
+  size_t buff_size = scil_get_compressed_data_size_limit(& dims[0], SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(buff_size);
+  byte * tmp = malloc(buff_size);
+  double * data = malloc(COUNT * sizeof(double));
+  double * check = malloc(COUNT * sizeof(double));
+
+  for(int i=0; i < COUNT; i++){
+    const int x = i % X;
+    const int y = (i / X) % Y;
+    const int z = (i / (X * Y)) % Z;
+    const int w = i / (X * Y * Z);
+    data[i] = 100.0 * sin(x * 0.3) * cos(y * 0.2) + z * 0.5 + w * 3.0;
+  }
+
+  // the library is linked against zfp, a build without a working zfp cannot run this test
+  if(compress("zfp-reversible", 1, 0, data, & dims[0], buff, buff_size, tmp, check) != SCIL_NO_ERR){
+    printf("zfp is not functional, skipping\n");
+    return SKIP;
+  }
+
+  for(int d=0; d < 4; d++){
+    for(int threads=1; threads <= 4; threads += 3){
+      int ret = compress("zfp-reversible", threads, 0, data, & dims[d], buff, buff_size, tmp, check);
+      assert(ret == SCIL_NO_ERR);
+      ret = compress("zfp-abstol", threads, 0.01, data, & dims[d], buff, buff_size, tmp, check);
+      assert(ret == SCIL_NO_ERR);
+    }
+    test_rate(data, & dims[d], buff, check);
+  }
+
+  free(data);
+  free(check);
+  free(buff);
+  free(tmp);
+  printf("OK\n");
+  return 0;
+}
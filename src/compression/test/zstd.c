@@ -0,0 +1,155 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <scil.h>
+#include <scil-error.h>
+#include <scil-util.h>
+#include <algo/zstd.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CHUNK 256
+#define SAMPLES 200
+#define DICT_FILE "zstd-test.dict"
+
+static double chunks[SAMPLES][CHUNK];
+
+static size_t roundtrip(scil_user_hints_t * hints, double * data, int repeats){
+  scil_context_t* ctx;
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, CHUNK);
+  size_t size = scil_get_compressed_data_size_limit(&dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(size);
+  byte * tmp = malloc(size);
+  double * check = malloc(CHUNK * sizeof(double));
+
+  int ret = scil_context_create(&ctx, SCIL_TYPE_DOUBLE, 0, NULL, hints);
+  assert(ret == SCIL_NO_ERR);
+
+  size_t out_size = 0;
+  // the cached CCtx must produce the same result for every call
+  for(int i=0; i < repeats; i++){
+    ret = scil_compress(buff, size, data, & dims, & out_size, ctx);
+    assert(ret == SCIL_NO_ERR);
+
+    memset(check, 0, CHUNK * sizeof(double));
+    ret = scil_decompress(SCIL_TYPE_DOUBLE, check, & dims, buff, out_size, tmp);
+    assert(ret == SCIL_NO_ERR);
+    assert(memcmp(check, data, CHUNK * sizeof(double)) == 0);
+  }
+  scil_destroy_context(ctx);
+
+  free(buff);
+  free(tmp);
+  free(check);
+  return out_size;
+}
+
+// rewrites a stream to the layout written before the chain format flag:
+// the chain length, the raw frame followed by 4 bytes of garbage and the ID
+static void legacy_stream(int compressor_id, double * data){
+  scil_context_t* ctx;
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.force_compression_methods = "zstd";
+  scil_dims_t dims;
+  scil_dims_initialize_1d(& dims, CHUNK);
+  size_t size = scil_get_compressed_data_size_limit(&dims, SCIL_TYPE_DOUBLE);
+  byte * buff = malloc(size);
+  byte * tmp = malloc(size);
+  double * check = malloc(CHUNK * sizeof(double));
+
+  int ret = scil_context_create(&ctx, SCIL_TYPE_DOUBLE, 0, NULL, & hints);
+  assert(ret == SCIL_NO_ERR);
+  size_t out_size;
+  ret = scil_compress(buff, size, data, & dims, & out_size, ctx);
+  assert(ret == SCIL_NO_ERR);
+  scil_destroy_context(ctx);
+
+  // drop the stored size of 8 bytes behind the chain length
+  const size_t frame_size = out_size - 10;
+  buff[0] = 1;
+  memmove(buff + 1, buff + 9, frame_size);
+  memset(buff + 1 + frame_size, 0xff, 4);
+  buff[frame_size + 5] = (byte) compressor_id;
+
+  ret = scil_decompress(SCIL_TYPE_DOUBLE, check, & dims, buff, frame_size + 6, tmp);
+  assert(ret == SCIL_NO_ERR);
+  assert(memcmp(check, data, CHUNK * sizeof(double)) == 0);
+
+  free(buff);
+  free(tmp);
+  free(check);
+}
+
+int main(){
+  scil_user_hints_t hints;
+  scil_user_hints_initialize(& hints);
+  hints.absolute_tolerance = SCIL_ACCURACY_DBL_FINEST;
+
+  for(int s=0; s < SAMPLES; s++){
+    for(int i=0; i < CHUNK; i++){
+      chunks[s][i] = (double)(i % 17) * 0.25 + (i % 5 == 0 ? s : 0);
+    }
+  }
+
+  hints.force_compression_methods = "zstd";
+  size_t plain = roundtrip(& hints, chunks[0], 3);
+
+  hints.byte_compression_level = 19;
+  hints.byte_compression_strategy = 9;
+  hints.byte_compression_window_log = 16;
+  size_t tuned = roundtrip(& hints, chunks[0], 3);
+  printf("zstd: %lld tuned: %lld\n", (long long) plain, (long long) tuned);
+
+  hints.force_compression_methods = "zstd-11";
+  roundtrip(& hints, chunks[1], 1);
+  hints.force_compression_methods = "zstd-22";
+  roundtrip(& hints, chunks[1], 1);
+
+  for(int id=16; id <= 18; id++){
+    legacy_stream(id, chunks[2]);
+  }
+
+  // train a dictionary over the chunks
+  size_t sample_sizes[SAMPLES];
+  for(int s=0; s < SAMPLES; s++){
+    sample_sizes[s] = CHUNK * sizeof(double);
+  }
+  size_t dict_size = 4096;
+  byte dict[4096];
+  int ret = scil_zstd_train_dictionary(dict, & dict_size, chunks, sample_sizes, SAMPLES);
+  assert(ret == SCIL_NO_ERR);
+  FILE * fd = fopen(DICT_FILE, "wb");
+  assert(fd != NULL);
+  fwrite(dict, 1, dict_size, fd);
+  fclose(fd);
+
+  hints.force_compression_methods = "zstd";
+  hints.byte_compression_level = 3;
+  hints.byte_compression_strategy = 0;
+  hints.byte_compression_window_log = 0;
+  size_t without = roundtrip(& hints, chunks[42], 1);
+  hints.byte_compression_dictionary = DICT_FILE;
+  size_t with = roundtrip(& hints, chunks[42], 3);
+  printf("dictionary size: %lld without: %lld with: %lld\n", (long long) dict_size, (long long) without, (long long) with);
+  assert(with < without);
+
+  remove(DICT_FILE);
+  printf("OK\n");
+  return 0;
+}
@@ -1,77 +1,315 @@
 #include <assert.h>
 
 #include <scil-util.h>
-#include <scil-debug.h>
 
-//Supported datatypes: int8_t int16_t int32_t int64_t float double
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// smaller inputs are scanned by a single thread
+#define PARALLEL_MIN_COUNT (1<<18)
+
+/*
+ * The points are excluded by a mask instead of branches: a point is kept unless it is NaN,
+ * within FLT_EPSILON of the fill value or outside of the lossless range.
+ * Mean and deviation are accumulated as sums of the differences to a shift common to all threads,
+ * which avoids the cancellation of the plain sum of squares for data with a large offset.
+ */
+typedef struct{
+  int check_fill;
+  int check_range;
+  double fill_value;
+  double ignore_up_to;
+  double ignore_from;
+} exclusion_t;
+
+static exclusion_t create_exclusion(double ignore_up_to, double ignore_from, double fill_value){
+  exclusion_t ex;
+  ex.check_fill = fill_value != DBL_MAX;
+  ex.check_range = ignore_up_to != -DBL_MAX || ignore_from != DBL_MAX;
+  ex.fill_value = fill_value;
+  ex.ignore_up_to = ignore_up_to;
+  ex.ignore_from = ignore_from;
+  return ex;
+}
+
+static inline int is_kept(double value, const exclusion_t* ex){
+  int keep = ! isnan(value);
+  if (ex->check_fill){
+    keep &= ! (fabs(value - ex->fill_value) < (double) FLT_EPSILON);
+  }
+  if (ex->check_range){
+    keep &= ! (value > ex->ignore_from) & ! (value < ex->ignore_up_to);
+  }
+  return keep;
+}
+
+typedef struct{
+  double minimum;
+  double maximum;
+  double sum;
+  double sum_squares;
+  size_t count;
+} vector_partial_t;
+
+#ifdef __SSE2__
+typedef struct{
+  __m128d minimum;
+  __m128d maximum;
+  __m128d sum;
+  __m128d sum_squares;
+  __m128d count;
+} vector_state_t;
+
+static inline void vector_add(vector_state_t* s, __m128d value, const exclusion_t* ex, __m128d shift){
+  __m128d keep = _mm_cmpord_pd(value, value);
+  if (ex->check_fill){
+    const __m128d difference = _mm_andnot_pd(_mm_set1_pd(-0.0), _mm_sub_pd(value, _mm_set1_pd(ex->fill_value)));
+    keep = _mm_and_pd(keep, _mm_cmpnlt_pd(difference, _mm_set1_pd(FLT_EPSILON)));
+  }
+  if (ex->check_range){
+    keep = _mm_and_pd(keep, _mm_cmpngt_pd(value, _mm_set1_pd(ex->ignore_from)));
+    keep = _mm_and_pd(keep, _mm_cmpnlt_pd(value, _mm_set1_pd(ex->ignore_up_to)));
+  }
+  // excluded points become neutral elements
+  const __m128d low = _mm_or_pd(_mm_and_pd(keep, value), _mm_andnot_pd(keep, _mm_set1_pd(INFINITY)));
+  const __m128d high = _mm_or_pd(_mm_and_pd(keep, value), _mm_andnot_pd(keep, _mm_set1_pd(-INFINITY)));
+  s->minimum = _mm_min_pd(low, s->minimum);
+  s->maximum = _mm_max_pd(high, s->maximum);
+  const __m128d x = _mm_and_pd(keep, _mm_sub_pd(value, shift));
+  s->sum = _mm_add_pd(s->sum, x);
+  s->sum_squares = _mm_add_pd(s->sum_squares, _mm_mul_pd(x, x));
+  s->count = _mm_add_pd(s->count, _mm_and_pd(keep, _mm_set1_pd(1.0)));
+}
+
+static inline double vector_low(__m128d x){
+  return _mm_cvtsd_f64(x);
+}
+
+static inline double vector_high(__m128d x){
+  return _mm_cvtsd_f64(_mm_unpackhi_pd(x, x));
+}
+
+static inline void vector_init(vector_state_t* s){
+  s->minimum = _mm_set1_pd(INFINITY);
+  s->maximum = _mm_set1_pd(-INFINITY);
+  s->sum = _mm_setzero_pd();
+  s->sum_squares = _mm_setzero_pd();
+  s->count = _mm_setzero_pd();
+}
+
+static inline void vector_finish(const vector_state_t* s, vector_partial_t* out){
+  // the lanes of the minimum never hold NaN, thus the scalar comparisons are exact
+  out->minimum = fmin(vector_low(s->minimum), vector_high(s->minimum));
+  out->maximum = fmax(vector_low(s->maximum), vector_high(s->maximum));
+  out->sum = vector_low(s->sum) + vector_high(s->sum);
+  out->sum_squares = vector_low(s->sum_squares) + vector_high(s->sum_squares);
+  out->count = (size_t) (vector_low(s->count) + vector_high(s->count));
+}
+
+// four int32 values are converted to doubles exactly
+static inline void vector_add_epi32(vector_state_t* s, __m128i x, const exclusion_t* ex, __m128d shift){
+  vector_add(s, _mm_cvtepi32_pd(x), ex, shift);
+  vector_add(s, _mm_cvtepi32_pd(_mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2))), ex, shift);
+}
+
+// eight int16 values are sign extended to int32
+static inline void vector_add_epi16(vector_state_t* s, __m128i x, const exclusion_t* ex, __m128d shift){
+  vector_add_epi32(s, _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16), ex, shift);
+  vector_add_epi32(s, _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16), ex, shift);
+}
+#endif
+
+//Supported datatypes: float double
 // Repeat for each data type
 
-void scilU_find_minimum_maximum_with_excluded_points_<DATATYPE>(const <DATATYPE>* restrict buffer, size_t count, <DATATYPE>* minimum, <DATATYPE>* maximum, double ignore_up_to, double ignore_from, double fill_value){
+// processes a prefix of the buffer in SSE2 registers, returns the number of points processed
+static size_t vector_statistics_<DATATYPE>(const <DATATYPE>* restrict buffer, size_t count, const exclusion_t* ex, double shift, vector_partial_t* out){
+#ifdef __SSE2__
+  vector_state_t s;
+  vector_init(& s);
+  const __m128d shift_v = _mm_set1_pd(shift);
 
-    assert(buffer != NULL);
-    assert(minimum != NULL);
-    assert(maximum != NULL);
+  const size_t lanes = 16 / sizeof(<DATATYPE>);
+  size_t i = 0;
+  for(; i + lanes <= count; i += lanes){
+    if(<DATATYPE_SIZE_BYTE> == 4){
+      // both halves of four floats are widened, the comparisons are then the same as for the scalar code
+      const __m128 x = _mm_loadu_ps((const float*) (buffer + i));
+      vector_add(& s, _mm_cvtps_pd(x), ex, shift_v);
+      vector_add(& s, _mm_cvtps_pd(_mm_movehl_ps(x, x)), ex, shift_v);
+    }else{
+      vector_add(& s, _mm_loadu_pd((const double*) (buffer + i)), ex, shift_v);
+    }
+  }
+  vector_finish(& s, out);
+  return i;
+#else
+  return 0;
+#endif
+}
+
+// End repeat
+
+//Supported datatypes: int8_t int16_t int32_t
+// Repeat for each data type
 
-    <DATATYPE> min = INFINITY_<DATATYPE>;
-    <DATATYPE> max = NINFINITY_<DATATYPE>;
-    if (fill_value != DBL_MAX && ignore_up_to != -DBL_MAX && ignore_from != DBL_MAX){
-      for(size_t i = 0; i < count; ++i){
-        if (fabs(buffer[i] - fill_value) < FLT_EPSILON){
-          debugI("%s Ignored some fill value\n", __PRETTY_FUNCTION__);
-          continue;
-        }
-        if ((double) buffer[i] > ignore_from)  continue;
-        if ((double) buffer[i] < ignore_up_to) continue;
-        if (buffer[i] < min) { min = buffer[i]; }
-        if (buffer[i] > max) { max = buffer[i]; }
-      }
-    }else if (fill_value != DBL_MAX){
-      for(size_t i = 0; i < count; ++i){
-        if (fabs(buffer[i] - fill_value) < FLT_EPSILON){
-          debugI("%s Ignored some fill value\n", __PRETTY_FUNCTION__);
-          continue;
-        }
-        if (buffer[i] < min) { min = buffer[i]; }
-        if (buffer[i] > max) { max = buffer[i]; }
-      }
-    } else if (ignore_up_to == -DBL_MAX && ignore_from == DBL_MAX){
-      for(size_t i = 0; i < count; ++i){
-        if (buffer[i] < min) { min = buffer[i]; }
-        if (buffer[i] > max) { max = buffer[i]; }
-      }
+// the values are widened to doubles exactly, thus minimum and maximum convert back without loss
+static size_t vector_statistics_<DATATYPE>(const <DATATYPE>* restrict buffer, size_t count, const exclusion_t* ex, double shift, vector_partial_t* out){
+#ifdef __SSE2__
+  vector_state_t s;
+  vector_init(& s);
+  const __m128d shift_v = _mm_set1_pd(shift);
+
+  const size_t lanes = 16 / sizeof(<DATATYPE>);
+  size_t i = 0;
+  for(; i + lanes <= count; i += lanes){
+    const __m128i x = _mm_loadu_si128((const __m128i*) (buffer + i));
+    if(<DATATYPE_SIZE_BYTE> == 1){
+      vector_add_epi16(& s, _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8), ex, shift_v);
+      vector_add_epi16(& s, _mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8), ex, shift_v);
+    }else if(<DATATYPE_SIZE_BYTE> == 2){
+      vector_add_epi16(& s, x, ex, shift_v);
     }else{
-      for(size_t i = 0; i < count; ++i){
-        if ((double) buffer[i] > ignore_from)  continue;
-        if ((double) buffer[i] < ignore_up_to) continue;
-        if (buffer[i] < min) { min = buffer[i]; }
-        if (buffer[i] > max) { max = buffer[i]; }
-      }
+      vector_add_epi32(& s, x, ex, shift_v);
     }
+  }
+  vector_finish(& s, out);
+  return i;
+#else
+  return 0;
+#endif
+}
+
+// End repeat
 
-    *minimum = min;
-    *maximum = max;
+//Supported datatypes: int64_t
+// Repeat for each data type
+
+// int64_t values are not exact as doubles, thus they are compared without conversion in the scalar loop
+static size_t vector_statistics_<DATATYPE>(const <DATATYPE>* restrict buffer, size_t count, const exclusion_t* ex, double shift, vector_partial_t* out){
+  return 0;
 }
 
+// End repeat
 
-void scilU_find_minimum_maximum_<DATATYPE>(const <DATATYPE>* restrict buffer,
-                                          size_t count,
-                                          <DATATYPE>* minimum,
-                                          <DATATYPE>* maximum){
+//Supported datatypes: int8_t int16_t int32_t int64_t float double
+// Repeat for each data type
+
+typedef struct{
+  <DATATYPE> minimum;
+  <DATATYPE> maximum;
+  double sum;
+  double sum_squares;
+  size_t count;
+} partial_<DATATYPE>_t;
+
+static void partial_statistics_<DATATYPE>(const <DATATYPE>* restrict buffer, size_t count, const exclusion_t* ex, double shift, partial_<DATATYPE>_t* out){
+  <DATATYPE> min = INFINITY_<DATATYPE>;
+  <DATATYPE> max = NINFINITY_<DATATYPE>;
+  double sum = 0;
+  double sum_squares = 0;
+  size_t included = 0;
+
+  vector_partial_t v;
+  size_t i = vector_statistics_<DATATYPE>(buffer, count, ex, shift, & v);
+  if (i > 0 && v.count > 0){
+    min = (<DATATYPE>) v.minimum;
+    max = (<DATATYPE>) v.maximum;
+    sum = v.sum;
+    sum_squares = v.sum_squares;
+    included = v.count;
+  }
+
+  for(; i < count; ++i){
+    const <DATATYPE> value = buffer[i];
+    const int keep = is_kept((double) value, ex);
+    min = keep && value < min ? value : min;
+    max = keep && value > max ? value : max;
+    const double x = keep ? (double) value - shift : 0;
+    sum += x;
+    sum_squares += x * x;
+    included += keep;
+  }
+
+  out->minimum = min;
+  out->maximum = max;
+  out->sum = sum;
+  out->sum_squares = sum_squares;
+  out->count = included;
+}
+
+static void merge_statistics_<DATATYPE>(partial_<DATATYPE>_t* inout, const partial_<DATATYPE>_t* in){
+  if (in->minimum < inout->minimum) { inout->minimum = in->minimum; }
+  if (in->maximum > inout->maximum) { inout->maximum = in->maximum; }
+  inout->sum += in->sum;
+  inout->sum_squares += in->sum_squares;
+  inout->count += in->count;
+}
+
+static void compute_partial_<DATATYPE>(const <DATATYPE>* restrict buffer, size_t count, const exclusion_t* ex, double shift, int threads, partial_<DATATYPE>_t* out){
+  if(threads <= 1 || count < PARALLEL_MIN_COUNT){
+    partial_statistics_<DATATYPE>(buffer, count, ex, shift, out);
+    return;
+  }
+  const size_t block = (count + threads - 1) / threads;
+  partial_<DATATYPE>_t* partials = (partial_<DATATYPE>_t*) scilU_safe_malloc(threads * sizeof(partial_<DATATYPE>_t));
+  #pragma omp parallel for num_threads(threads)
+  for(int t=0; t < threads; t++){
+    const size_t start = t * block < count ? t * block : count;
+    const size_t end = start + block < count ? start + block : count;
+    partial_statistics_<DATATYPE>(buffer + start, end - start, ex, shift, & partials[t]);
+  }
+  *out = partials[0];
+  for(int t=1; t < threads; t++){
+    merge_statistics_<DATATYPE>(out, & partials[t]);
+  }
+  free(partials);
+}
+
+void scilU_compute_statistics_<DATATYPE>(const <DATATYPE>* restrict buffer, size_t count, scilU_statistics_<DATATYPE>_t* out, double ignore_up_to, double ignore_from, double fill_value, int threads){
+    assert(buffer != NULL);
+    assert(out != NULL);
+
+    const exclusion_t ex = create_exclusion(ignore_up_to, ignore_from, fill_value);
+    const double shift = count > 0 && isfinite((double) buffer[0]) ? (double) buffer[0] : 0;
+    partial_<DATATYPE>_t p;
+    compute_partial_<DATATYPE>(buffer, count, & ex, shift, threads, & p);
+
+    out->minimum = p.minimum;
+    out->maximum = p.maximum;
+    out->count = p.count;
+    if (p.count == 0){
+      out->mean = NAN;
+      out->stddev = NAN;
+      return;
+    }
+    const double n = (double) p.count;
+    const double mean_shifted = p.sum / n;
+    const double variance = p.sum_squares / n - mean_shifted * mean_shifted;
+    out->mean = shift + mean_shifted;
+    out->stddev = sqrt(variance > 0 ? variance : 0);
+}
+
+void scilU_find_minimum_maximum_with_excluded_points_<DATATYPE>(const <DATATYPE>* restrict buffer, size_t count, <DATATYPE>* minimum, <DATATYPE>* maximum, double ignore_up_to, double ignore_from, double fill_value){
 
     assert(buffer != NULL);
     assert(minimum != NULL);
     assert(maximum != NULL);
 
-    <DATATYPE> min = INFINITY_<DATATYPE>;
-    <DATATYPE> max = NINFINITY_<DATATYPE>;
+    scilU_statistics_<DATATYPE>_t s;
+    scilU_compute_statistics_<DATATYPE>(buffer, count, & s, ignore_up_to, ignore_from, fill_value, 1);
 
-    for(size_t i = 0; i < count; ++i){
-        if (buffer[i] < min) { min = buffer[i]; }
-        if (buffer[i] > max) { max = buffer[i]; }
-    }
+    *minimum = s.minimum;
+    *maximum = s.maximum;
+}
 
-    *minimum = min;
-    *maximum = max;
+
+void scilU_find_minimum_maximum_<DATATYPE>(const <DATATYPE>* restrict buffer,
+                                          size_t count,
+                                          <DATATYPE>* minimum,
+                                          <DATATYPE>* maximum){
+    scilU_find_minimum_maximum_with_excluded_points_<DATATYPE>(buffer, count, minimum, maximum, -DBL_MAX, DBL_MAX, DBL_MAX);
 }
 
 void scilU_subtract_data_<DATATYPE>(const <DATATYPE>* restrict in, <DATATYPE>* restrict inout, size_t count){
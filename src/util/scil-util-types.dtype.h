@@ -68,6 +68,34 @@ void scilU_find_minimum_maximum_with_excluded_points_<DATATYPE>(const <DATATYPE>
                                           <DATATYPE>* maximum,
                                           double ignore_up_to, double ignore_from, double fill_value);
 
+/**
+ * \brief Statistics of the points of a buffer that are not excluded
+ * NaN values are always excluded, minimum and maximum are INFINITY_<DATATYPE> and NINFINITY_<DATATYPE> if all points are.
+ */
+typedef struct{
+  <DATATYPE> minimum;
+  <DATATYPE> maximum;
+  double mean;
+  /** \brief The standard deviation of the population */
+  double stddev;
+  /** \brief The number of points included */
+  size_t count;
+} scilU_statistics_<DATATYPE>_t;
+
+/**
+ * \brief Computes the statistics in a single pass, points are excluded like by
+ *        scilU_find_minimum_maximum_with_excluded_points_<DATATYPE>()
+ * \param ignore_up_to Values below are excluded, -DBL_MAX to include all
+ * \param ignore_from Values above are excluded, DBL_MAX to include all
+ * \param fill_value Values within FLT_EPSILON of it are excluded, DBL_MAX to include all
+ * \param threads Number of threads to use, 0 or 1 for serial
+ */
+void scilU_compute_statistics_<DATATYPE>(const <DATATYPE>* restrict buffer,
+                                        size_t count,
+                                        scilU_statistics_<DATATYPE>_t* out,
+                                        double ignore_up_to, double ignore_from, double fill_value,
+                                        int threads);
+
 // End repeat
 
 #endif
@@ -0,0 +1,164 @@
+// This file is part of SCIL.
+//
+// SCIL is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SCIL is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with SCIL.  If not, see <http://www.gnu.org/licenses/>.
+
+// The statistics kernels must match a plain scan for every exclusion and thread count.
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <scil-util.h>
+
+#define COUNT 300007
+#define FILL -999.0
+
+typedef struct{
+  double up_to;
+  double from;
+  double fill;
+} exclusion_t;
+
+static const exclusion_t exclusions[] = {
+  {-DBL_MAX, DBL_MAX, DBL_MAX},
+  {-DBL_MAX, DBL_MAX, FILL},
+  {-50.0, 80.0, DBL_MAX},
+  {-50.0, 80.0, FILL},
+};
+
+static int excluded(double v, const exclusion_t* e){
+  if (isnan(v)) return 1;
+  if (e->fill < DBL_MAX && fabs(v - e->fill) < (double) FLT_EPSILON) return 1;
+  if ((e->up_to > -DBL_MAX || e->from < DBL_MAX) && (v > e->from || v < e->up_to)) return 1;
+  return 0;
+}
+
+static void reference(const double* data, size_t count, const exclusion_t* e, double* min, double* max, double* mean, double* stddev, size_t* included){
+  *min = INFINITY;
+  *max = -INFINITY;
+  double sum = 0;
+  *included = 0;
+  for(size_t i=0; i < count; i++){
+    if (excluded(data[i], e)) continue;
+    if (data[i] < *min) *min = data[i];
+    if (data[i] > *max) *max = data[i];
+    sum += data[i];
+    (*included)++;
+  }
+  *mean = sum / (double) *included;
+  double sq = 0;
+  for(size_t i=0; i < count; i++){
+    if (excluded(data[i], e)) continue;
+    sq += (data[i] - *mean) * (data[i] - *mean);
+  }
+  *stddev = sqrt(sq / (double) *included);
+}
+
+static void check(double min, double max, double mean, double stddev, size_t included, const double* data, size_t count, const exclusion_t* e){
+  double r_min, r_max, r_mean, r_stddev;
+  size_t r_included;
+  reference(data, count, e, & r_min, & r_max, & r_mean, & r_stddev, & r_included);
+  assert(min <= r_min && min >= r_min);
+  assert(max <= r_max && max >= r_max);
+  assert(included == r_included);
+  if (included == 0){
+    assert(isnan(mean) && isnan(stddev));
+    return;
+  }
+  assert(fabs(mean - r_mean) <= 1e-9 * (fabs(r_mean) + 1));
+  assert(fabs(stddev - r_stddev) <= 1e-9 * (r_stddev + 1));
+}
+
+int main(){
+  double * data = malloc(COUNT * sizeof(double));
+  float * data_f = malloc(COUNT * sizeof(float));
+  int32_t * data_i = malloc(COUNT * sizeof(int32_t));
+  int16_t * data_s = malloc(COUNT * sizeof(int16_t));
+  int8_t * data_b = malloc(COUNT * sizeof(int8_t));
+  double * widened = malloc(COUNT * sizeof(double));
+
+  for(int i=0; i < COUNT; i++){
+    // a large offset challenges the accumulation of the deviation
+    data[i] = 1e6 + 100 * sin(i / 100.0) + (i % 17);
+  }
+  for(int i=0; i < COUNT; i += 1013){
+    data[i] = FILL;
+  }
+  data[5] = NAN;
+  data[7] = -1e9;
+  data[COUNT - 1] = 1e9;
+
+  for(size_t e=0; e < sizeof(exclusions) / sizeof(exclusion_t); e++){
+    const exclusion_t* ex = & exclusions[e];
+    for(int threads=1; threads <= 4; threads += 3){
+      scilU_statistics_double_t s;
+      scilU_compute_statistics_double(data, COUNT, & s, ex->up_to, ex->from, ex->fill, threads);
+      check(s.minimum, s.maximum, s.mean, s.stddev, s.count, data, COUNT, ex);
+
+      for(int i=0; i < COUNT; i++){
+        data_f[i] = data[i] <= FILL && data[i] >= FILL ? (float) FILL : (float) (data[i] - 1e6);
+        widened[i] = (double) data_f[i];
+      }
+      scilU_statistics_float_t sf;
+      scilU_compute_statistics_float(data_f, COUNT, & sf, ex->up_to, ex->from, ex->fill, threads);
+      check((double) sf.minimum, (double) sf.maximum, sf.mean, sf.stddev, sf.count, widened, COUNT, ex);
+
+      for(int i=0; i < COUNT; i++){
+        data_i[i] = isnan(widened[i]) ? 0 : (int32_t) widened[i];
+        widened[i] = (double) data_i[i];
+      }
+      scilU_statistics_int32_t_t si;
+      scilU_compute_statistics_int32_t(data_i, COUNT, & si, ex->up_to, ex->from, ex->fill, threads);
+      check((double) si.minimum, (double) si.maximum, si.mean, si.stddev, si.count, widened, COUNT, ex);
+
+      // the narrow integers are clamped, the fill value remains for int16_t
+      for(int i=0; i < COUNT; i++){
+        data_s[i] = (int16_t) (data_i[i] < INT16_MIN ? INT16_MIN : data_i[i] > INT16_MAX ? INT16_MAX : data_i[i]);
+        widened[i] = (double) data_s[i];
+      }
+      scilU_statistics_int16_t_t ss;
+      scilU_compute_statistics_int16_t(data_s, COUNT, & ss, ex->up_to, ex->from, ex->fill, threads);
+      check((double) ss.minimum, (double) ss.maximum, ss.mean, ss.stddev, ss.count, widened, COUNT, ex);
+
+      for(int i=0; i < COUNT; i++){
+        data_b[i] = (int8_t) (data_s[i] < INT8_MIN ? INT8_MIN : data_s[i] > INT8_MAX ? INT8_MAX : data_s[i]);
+        widened[i] = (double) data_b[i];
+      }
+      scilU_statistics_int8_t_t sb;
+      scilU_compute_statistics_int8_t(data_b, COUNT, & sb, ex->up_to, ex->from, ex->fill, threads);
+      check((double) sb.minimum, (double) sb.maximum, sb.mean, sb.stddev, sb.count, widened, COUNT, ex);
+    }
+  }
+
+  // the minimum and maximum of the existing interface
+  double min, max;
+  scilU_find_minimum_maximum_with_excluded_points_double(data, COUNT, & min, & max, -DBL_MAX, DBL_MAX, FILL);
+  assert(min <= -1e9 && min >= -1e9);
+  assert(max <= 1e9 && max >= 1e9);
+
+  // all points excluded
+  scilU_statistics_double_t s;
+  scilU_compute_statistics_double(data, 4, & s, 1e10, DBL_MAX, DBL_MAX, 1);
+  assert(s.count == 0);
+  assert(isinf(s.minimum) && s.minimum > 0);
+  assert(isnan(s.mean));
+
+  free(data);
+  free(data_f);
+  free(data_i);
+  free(data_s);
+  free(data_b);
+  free(widened);
+  printf("OK\n");
+  return 0;
+}